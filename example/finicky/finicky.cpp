@@ -16,6 +16,7 @@
     https://github.com/johnste/finicky
 */
 
+#include "url_matcher.hpp"
 #include <boost/url/url.hpp>
 #include <boost/url/parse.hpp>
 #include <boost/system/result.hpp>
@@ -24,6 +25,7 @@
 #include <boost/regex.hpp>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 namespace urls = boost::urls;
 namespace json = boost::json;
@@ -48,105 +50,146 @@ read_json( std::istream& is, json::error_code& ec )
     return p.release();
 }
 
-bool
-glob_match(
-    core::string_view pattern,
-    core::string_view str)
+// A regular expression, written between
+// slashes, applied to a part of the url
+struct regex_rule
 {
-    // regex
-    if (str.starts_with("/") &&
-        str.ends_with("/"))
-    {
-        const boost::regex pr(pattern.begin() + 1, pattern.end() - 1);
-        return boost::regex_match(std::string(str), pr);
-    }
-
-    // literal
-    if (!pattern.contains('*'))
+    std::size_t target;
+    urls::url_part part;
+    boost::regex re;
+};
+
+/*  The match fields of the rewrite rules or
+    the handlers, compiled once. Every glob
+    is a rule of the matcher, and targets
+    holds the index of the rewrite rule or
+    handler each one belongs to.
+*/
+class classifier
+{
+    urls::url_matcher globs_;
+    std::vector<std::size_t> targets_;
+    std::vector<regex_rule> regexes_;
+    urls::url_rule_matches matches_;
+
+    void
+    add(
+        std::size_t target,
+        urls::url_part part,
+        core::string_view pattern)
     {
-        return pattern == str;
+        if (pattern.size() > 1 &&
+            pattern.starts_with("/") &&
+            pattern.ends_with("/"))
+        {
+            regexes_.push_back({ target, part, boost::regex(
+                pattern.begin() + 1, pattern.end() - 1) });
+            return;
+        }
+        globs_.add(part, pattern);
+        targets_.push_back(target);
     }
 
-    // glob
-    std::string p = pattern;
-    std::size_t i = p.find('*');
-    while (i != std::string::npos)
+public:
+    void
+    add(std::size_t target, json::value const& mv)
     {
-        auto e = std::min(p.find_first_not_of('*', i), p.size());
-        std::size_t n = e - i;
-        if (n == 1)
+        if (mv.is_string())
         {
-            p.replace(i, e, "[^/]*");
-            i += 5;
+            add(target, urls::url_part::url,
+                mv.get_string());
         }
-        else
+        else if (mv.is_array())
         {
-            p.replace(i, e, ".*");
-            i += 2;
+            for (auto& mi: mv.get_array())
+            {
+                if (!mi.is_string())
+                    throw std::invalid_argument(
+                        "handle match is not a string");
+                add(target, urls::url_part::url,
+                    mi.get_string());
+            }
+        }
+        else if (mv.is_object())
+        {
+            std::pair<core::string_view, urls::url_part>
+                fields[] = {
+                    {"protocol",  urls::url_part::scheme},
+                    {"authority", urls::url_part::authority},
+                    {"username",  urls::url_part::user},
+                    {"user",      urls::url_part::user},
+                    {"password",  urls::url_part::password},
+                    {"userinfo",  urls::url_part::userinfo},
+                    {"host",      urls::url_part::host},
+                    {"port",      urls::url_part::port},
+                    {"path",      urls::url_part::path},
+                    {"pathname",  urls::url_part::path},
+                    {"query",     urls::url_part::query},
+                    {"search",    urls::url_part::query},
+                    {"fragment",  urls::url_part::fragment},
+                    {"hash",      urls::url_part::fragment},
+                };
+            json::object const& m = mv.get_object();
+            for (auto& f: fields)
+            {
+                auto it = m.find(f.first);
+                if (it == m.end())
+                    continue;
+                if (!it->value().is_string())
+                    throw std::invalid_argument(
+                        "match fields should be a strings");
+                add(target, f.second,
+                    it->value().get_string());
+            }
         }
-        i = p.find('*', i);
     }
-    const boost::regex pr(p);
-    return boost::regex_match(std::string(str), pr);
-}
 
-bool
-url_match(
-    json::value& mv,
-    urls::url const& u)
-{
-    if (mv.is_string())
+    void
+    compile()
     {
-        json::string& p = mv.as_string();
-        return glob_match(u.buffer(), p);
+        globs_.compile();
     }
-    else if (mv.is_array())
+
+    // Return the first target not less
+    // than `from` which matches the url
+    std::size_t
+    find(urls::url_view_base const& u, std::size_t from)
     {
-        json::array& m = mv.as_array();
-        for (auto& mi: m)
+        std::size_t best = urls::url_matcher::npos;
+        globs_.match_all(u, matches_);
+        for (auto id: matches_.ids())
         {
-            if (!mi.is_string())
-                throw std::invalid_argument(
-                    "handle match is not a string");
-            if (glob_match(mi.as_string(), u.buffer()))
-                return true;
+            if (targets_[id] >= from)
+            {
+                best = targets_[id];
+                break;
+            }
         }
-    }
-    else if (mv.is_object())
-    {
-        json::object& m = mv.as_object();
-        std::pair<core::string_view, core::string_view>
-            field_values[] = {
-                {"protocol",  u.scheme()},
-                {"authority", u.encoded_authority()},
-                {"username",  u.encoded_user()},
-                {"user",      u.encoded_user()},
-                {"password",  u.encoded_password()},
-                {"userinfo",  u.encoded_userinfo()},
-                {"host",      u.encoded_host()},
-                {"port",      u.port()},
-                {"path",      u.encoded_path()},
-                {"pathname",  u.encoded_path()},
-                {"query",     u.encoded_query()},
-                {"search",    u.encoded_query()},
-                {"fragment",  u.encoded_fragment()},
-                {"hash",      u.encoded_fragment()},
-            };
-        for (auto& p: field_values)
+        for (auto& r: regexes_)
         {
-            auto it = m.find(p.first);
-            if (it != m.end())
+            if (r.target < from || r.target >= best)
+                continue;
+            core::string_view s;
+            switch (r.part)
             {
-                if (!it->value().is_string())
-                    throw std::invalid_argument(
-                        "match fields should be a strings");
-                if (glob_match(p.second, p.first))
-                    return true;
+            case urls::url_part::scheme: s = u.scheme(); break;
+            case urls::url_part::authority: s = u.encoded_authority(); break;
+            case urls::url_part::userinfo: s = u.encoded_userinfo(); break;
+            case urls::url_part::user: s = u.encoded_user(); break;
+            case urls::url_part::password: s = u.encoded_password(); break;
+            case urls::url_part::host: s = u.encoded_host(); break;
+            case urls::url_part::port: s = u.port(); break;
+            case urls::url_part::path: s = u.encoded_path(); break;
+            case urls::url_part::query: s = u.encoded_query(); break;
+            case urls::url_part::fragment: s = u.encoded_fragment(); break;
+            default: s = u.buffer(); break;
             }
+            if (boost::regex_match(s.begin(), s.end(), r.re))
+                best = r.target;
         }
+        return best;
     }
-    return false;
-}
+};
 
 #define CHECK(c, msg)             \
     if (!(c))                     \
@@ -200,14 +243,14 @@ int main(int argc, char** argv)
             rsit->value().is_array(),
             "rewrite rules should be an array");
         auto& rs = rsit->value().as_array();
-        for (auto& rv: rs)
+        classifier rewrites;
+        for (std::size_t i = 0; i < rs.size(); ++i)
         {
             CHECK(
-                rv.is_object(),
+                rs[i].is_object(),
                 "individual rewrite rule should be an object");
-            json::object& r = rv.as_object();
+            json::object& r = rs[i].as_object();
 
-            // Look for match
             auto mit = r.find("match");
             CHECK(
                 mit != r.end(),
@@ -215,8 +258,17 @@ int main(int argc, char** argv)
             CHECK(
                 mit->value().is_object() || mit->value().is_string(),
                 "rewrite match field is not an object");
-            if (!url_match(mit->value(), u))
-                continue;
+            rewrites.add(i, mit->value());
+        }
+        rewrites.compile();
+
+        // Each rewrite sees the url modified
+        // by the rules before it
+        for (std::size_t i = rewrites.find(u, 0);
+             i != urls::url_matcher::npos;
+             i = rewrites.find(u, i + 1))
+        {
+            json::object& r = rs[i].as_object();
 
             // Apply replacement rule
             auto uit = r.find("url");
@@ -233,7 +285,7 @@ int main(int argc, char** argv)
                 json::string& uo = uit->value().as_string();
                 auto ru1 = urls::parse_uri(uo);
                 CHECK(ru1, "url " << uo.c_str() << " is invalid");
-                u = *ru;
+                u = *ru1;
             }
             else
             {
@@ -356,12 +408,13 @@ int main(int argc, char** argv)
             hsit->value().is_array(),
             "handler rules should be an array");
         auto& hs = hsit->value().as_array();
-        for (auto& hv: hs)
+        classifier handlers;
+        for (std::size_t i = 0; i < hs.size(); ++i)
         {
             CHECK(
-                hv.is_object(),
+                hs[i].is_object(),
                 "individual handlers should be an object");
-            json::object& h = hv.as_object();
+            json::object& h = hs[i].as_object();
 
             auto mit = h.find("match");
             CHECK(
@@ -379,13 +432,16 @@ int main(int argc, char** argv)
                 hbit->value().is_string(),
                 "browser field is not a string");
 
-            // Look for match and change browser
-            if (url_match(mit->value(), u))
-            {
-                browser = hbit->value().as_string().subview();
-                break;
-            }
+            handlers.add(i, mit->value());
         }
+        handlers.compile();
+
+        // The first handler which matches
+        // changes the browser
+        std::size_t const i = handlers.find(u, 0);
+        if (i != urls::url_matcher::npos)
+            browser = hs[i].as_object().at(
+                "browser").as_string().subview();
     }
 
     // Print command finicky would run
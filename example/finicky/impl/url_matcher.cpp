@@ -0,0 +1,642 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include "../url_matcher.hpp"
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+constexpr std::size_t part_count = 11;
+
+bool
+is_icase(url_part p) noexcept
+{
+    return
+        p == url_part::scheme ||
+        p == url_part::host;
+}
+
+core::string_view
+part_of(
+    url_view_base const& u,
+    url_part p) noexcept
+{
+    switch(p)
+    {
+    default:
+    case url_part::url:
+        return u.buffer();
+    case url_part::scheme:
+        return u.scheme();
+    case url_part::authority:
+        return u.encoded_authority();
+    case url_part::userinfo:
+        return u.encoded_userinfo();
+    case url_part::user:
+        return u.encoded_user();
+    case url_part::password:
+        return u.encoded_password();
+    case url_part::host:
+        return u.encoded_host();
+    case url_part::port:
+        return u.port();
+    case url_part::path:
+        return u.encoded_path();
+    case url_part::query:
+        return u.encoded_query();
+    case url_part::fragment:
+        return u.encoded_fragment();
+    }
+}
+
+char
+to_lower(char c, bool icase) noexcept
+{
+    return icase ? grammar::to_lower(c) : c;
+}
+
+/*  A pattern with n characters is matched
+    with a row of n + 1 states, where state
+    j means the first j characters of the
+    pattern match the input so far. The
+    rows live in dp, so matching does not
+    allocate once dp is large enough.
+*/
+bool
+glob_match_impl(
+    core::string_view p,
+    core::string_view s,
+    bool icase,
+    std::vector<unsigned char>& dp)
+{
+    if(p.find('*') == core::string_view::npos)
+    {
+        if(icase)
+            return grammar::ci_is_equal(p, s);
+        return p == s;
+    }
+
+    std::size_t const m = p.size();
+    dp.assign(2 * (m + 1), 0);
+    unsigned char* cur = dp.data();
+    unsigned char* next = cur + m + 1;
+
+    // stars may match nothing
+    auto const close =
+        [p, m](unsigned char* v)
+        {
+            for(std::size_t j = 0; j < m; ++j)
+            {
+                if(! v[j] || p[j] != '*')
+                    continue;
+                if(j + 1 < m && p[j + 1] == '*')
+                    v[j + 2] = 1;
+                else
+                    v[j + 1] = 1;
+            }
+        };
+
+    cur[0] = 1;
+    close(cur);
+    for(char c : s)
+    {
+        c = to_lower(c, icase);
+        std::fill(next, next + m + 1, 0);
+        bool any = false;
+        for(std::size_t j = 0; j < m; ++j)
+        {
+            if(! cur[j])
+                continue;
+            if(p[j] == '*')
+            {
+                if(c != '/' || (
+                    j + 1 < m && p[j + 1] == '*'))
+                {
+                    next[j] = 1;
+                    any = true;
+                }
+            }
+            else if(to_lower(p[j], icase) == c)
+            {
+                next[j + 1] = 1;
+                any = true;
+            }
+        }
+        if(! any)
+            return false;
+        close(next);
+        std::swap(cur, next);
+    }
+    return cur[m] != 0;
+}
+
+// the longest run of characters without
+// stars, which every match must contain
+core::string_view
+longest_literal(core::string_view p) noexcept
+{
+    core::string_view best;
+    std::size_t i = 0;
+    while(i < p.size())
+    {
+        std::size_t j = p.find('*', i);
+        if(j == core::string_view::npos)
+            j = p.size();
+        if(j - i > best.size())
+            best = p.substr(i, j - i);
+        i = j + 1;
+    }
+    return best;
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+struct url_matcher::impl
+{
+    struct pattern
+    {
+        std::string text;
+        url_part part;
+        bool literal;
+    };
+
+    struct rule
+    {
+        std::uint32_t first;
+        std::uint32_t last;
+    };
+
+    /*  The longest literal of each glob
+        is a word of an Aho-Corasick
+        automaton. The edges of each node
+        are sorted, and dict is the nearest
+        node on the fail chain with outputs,
+        or zero if there is none.
+    */
+    struct node
+    {
+        std::uint32_t edge = 0;
+        std::uint32_t edges = 0;
+        std::uint32_t fail = 0;
+        std::uint32_t dict = 0;
+        std::uint32_t out = 0;
+        std::uint32_t outs = 0;
+    };
+
+    struct edge
+    {
+        unsigned char c;
+        std::uint32_t to;
+    };
+
+    struct part_index
+    {
+        std::unordered_map<std::string,
+            std::vector<std::uint32_t>> exact;
+        std::vector<node> nodes;
+        std::vector<edge> edges;
+        std::vector<std::uint32_t> outs;
+        std::vector<std::uint32_t> always;
+
+        bool
+        empty() const noexcept
+        {
+            return
+                exact.empty() &&
+                nodes.size() < 2 &&
+                always.empty();
+        }
+
+        std::uint32_t
+        child(
+            std::uint32_t n,
+            unsigned char c) const noexcept
+        {
+            node const& x = nodes[n];
+            auto const first = edges.begin() + x.edge;
+            auto const last = first + x.edges;
+            auto const it = std::lower_bound(
+                first, last, c,
+                [](edge const& e, unsigned char c)
+                {
+                    return e.c < c;
+                });
+            if(it == last || it->c != c)
+                return 0;
+            return it->to;
+        }
+
+        void
+        build(std::vector<std::pair<
+            std::string, std::uint32_t>>& words);
+    };
+
+    std::vector<pattern> patterns;
+    std::vector<rule> rules;
+    std::vector<std::uint32_t> always;
+    part_index parts[part_count];
+    bool compiled = true;
+
+    bool
+    verify(
+        std::uint32_t r,
+        url_view_base const& u,
+        url_rule_matches& m) const
+    {
+        rule const& x = rules[r];
+        for(auto i = x.first; i < x.last; ++i)
+        {
+            pattern const& p = patterns[i];
+            if(! glob_match_impl(p.text,
+                    part_of(u, p.part),
+                    is_icase(p.part), m.dp_))
+                return false;
+        }
+        return true;
+    }
+};
+
+void
+url_matcher::
+impl::
+part_index::
+build(std::vector<std::pair<
+    std::string, std::uint32_t>>& words)
+{
+    nodes.clear();
+    edges.clear();
+    outs.clear();
+    nodes.emplace_back();
+    if(words.empty())
+        return;
+
+    // With the words sorted, the children
+    // of a node are created in order and
+    // the last one is the only candidate
+    // when inserting the next word.
+    std::sort(words.begin(), words.end());
+    std::vector<std::vector<edge>> tmp(1);
+    std::vector<std::vector<std::uint32_t>> out(1);
+    for(auto const& w : words)
+    {
+        std::uint32_t n = 0;
+        for(char ch : w.first)
+        {
+            auto const c =
+                static_cast<unsigned char>(ch);
+            auto& v = tmp[n];
+            if(! v.empty() && v.back().c == c)
+            {
+                n = v.back().to;
+                continue;
+            }
+            auto const to = static_cast<
+                std::uint32_t>(tmp.size());
+            v.push_back({ c, to });
+            tmp.emplace_back();
+            out.emplace_back();
+            n = to;
+        }
+        out[n].push_back(w.second);
+    }
+
+    nodes.resize(tmp.size());
+    for(std::size_t i = 0; i < tmp.size(); ++i)
+    {
+        nodes[i].edge = static_cast<
+            std::uint32_t>(edges.size());
+        nodes[i].edges = static_cast<
+            std::uint32_t>(tmp[i].size());
+        edges.insert(edges.end(),
+            tmp[i].begin(), tmp[i].end());
+        nodes[i].out = static_cast<
+            std::uint32_t>(outs.size());
+        nodes[i].outs = static_cast<
+            std::uint32_t>(out[i].size());
+        outs.insert(outs.end(),
+            out[i].begin(), out[i].end());
+    }
+
+    // breadth-first, so the fail link of
+    // each node is computed before its
+    // children need it
+    std::vector<std::uint32_t> queue;
+    queue.reserve(nodes.size());
+    queue.push_back(0);
+    for(std::size_t q = 0; q < queue.size(); ++q)
+    {
+        std::uint32_t const n = queue[q];
+        node const x = nodes[n];
+        for(auto e = x.edge;
+            e < x.edge + x.edges; ++e)
+        {
+            auto const c = edges[e].c;
+            auto const to = edges[e].to;
+            std::uint32_t f = 0;
+            if(n != 0)
+            {
+                f = x.fail;
+                for(;;)
+                {
+                    auto const g = child(f, c);
+                    if(g != 0)
+                    {
+                        f = g;
+                        break;
+                    }
+                    if(f == 0)
+                        break;
+                    f = nodes[f].fail;
+                }
+            }
+            nodes[to].fail = f;
+            nodes[to].dict = nodes[f].outs != 0
+                ? f : nodes[f].dict;
+            queue.push_back(to);
+        }
+    }
+}
+
+//------------------------------------------------
+
+constexpr std::size_t url_matcher::npos;
+
+url_matcher::
+url_matcher()
+    : impl_(new impl)
+{
+}
+
+url_matcher::
+url_matcher(url_matcher&&) noexcept = default;
+
+url_matcher&
+url_matcher::
+operator=(url_matcher&&) noexcept = default;
+
+url_matcher::
+~url_matcher() = default;
+
+std::size_t
+url_matcher::
+add(
+    url_part part,
+    core::string_view pattern)
+{
+    url_pattern const p{ part, pattern };
+    return add(&p, &p + 1);
+}
+
+std::size_t
+url_matcher::
+add(
+    url_pattern const* first,
+    url_pattern const* last)
+{
+    auto& v = impl_->patterns;
+    std::size_t const n = v.size();
+    try
+    {
+        for(auto it = first; it != last; ++it)
+        {
+            std::string s(it->pattern);
+            if(is_icase(it->part))
+                for(char& c : s)
+                    c = grammar::to_lower(c);
+            bool const literal =
+                s.find('*') == std::string::npos;
+            v.push_back({ std::move(s),
+                it->part, literal });
+        }
+        impl_->rules.push_back({
+            static_cast<std::uint32_t>(n),
+            static_cast<std::uint32_t>(v.size()) });
+    }
+    catch(...)
+    {
+        v.resize(n);
+        throw;
+    }
+    impl_->compiled = false;
+    return impl_->rules.size() - 1;
+}
+
+std::size_t
+url_matcher::
+size() const noexcept
+{
+    return impl_->rules.size();
+}
+
+void
+url_matcher::
+compile()
+{
+    std::unique_ptr<impl> p(new impl);
+    p->patterns = impl_->patterns;
+    p->rules = impl_->rules;
+
+    // Each rule is indexed by one of its
+    // patterns, and the others are only
+    // checked when that one is found. A
+    // literal is preferred, then the glob
+    // with the longest literal.
+    std::vector<std::pair<std::string,
+        std::uint32_t>> words[part_count];
+    for(std::size_t r = 0;
+        r < p->rules.size(); ++r)
+    {
+        auto const id =
+            static_cast<std::uint32_t>(r);
+        auto const& x = p->rules[r];
+        if(x.first == x.last)
+        {
+            p->always.push_back(id);
+            continue;
+        }
+        std::uint32_t key = x.first;
+        std::size_t best = 0;
+        for(auto i = x.first; i < x.last; ++i)
+        {
+            auto const& pat = p->patterns[i];
+            std::size_t const score = pat.literal
+                ? std::size_t(-1)
+                : longest_literal(pat.text).size();
+            if(i == x.first || score > best)
+            {
+                key = i;
+                best = score;
+            }
+        }
+        auto const& pat = p->patterns[key];
+        auto& pi = p->parts[
+            static_cast<std::size_t>(pat.part)];
+        if(pat.literal)
+            pi.exact[pat.text].push_back(id);
+        else if(best == 0)
+            pi.always.push_back(id);
+        else
+            words[static_cast<std::size_t>(
+                pat.part)].emplace_back(
+                    longest_literal(pat.text), id);
+    }
+    for(std::size_t i = 0; i < part_count; ++i)
+        p->parts[i].build(words[i]);
+    p->compiled = true;
+    impl_ = std::move(p);
+}
+
+std::size_t
+url_matcher::
+match(
+    url_view_base const& u,
+    url_rule_matches& r) const
+{
+    return match_impl(u, r, false);
+}
+
+void
+url_matcher::
+match_all(
+    url_view_base const& u,
+    url_rule_matches& r) const
+{
+    match_impl(u, r, true);
+    std::sort(r.ids_.begin(), r.ids_.end());
+}
+
+std::size_t
+url_matcher::
+match_impl(
+    url_view_base const& u,
+    url_rule_matches& r,
+    bool all) const
+{
+    impl const& m = *impl_;
+    BOOST_ASSERT(m.compiled);
+
+    r.ids_.clear();
+    if(r.seen_.size() < m.rules.size())
+        r.seen_.resize(m.rules.size(), 0);
+    if(++r.epoch_ == 0)
+    {
+        std::fill(r.seen_.begin(),
+            r.seen_.end(), 0);
+        r.epoch_ = 1;
+    }
+
+    // A rule can be found more than once,
+    // for example when its literal appears
+    // twice, and is only verified once.
+    std::size_t best = npos;
+    auto const consider =
+        [&](std::uint32_t id)
+        {
+            if(r.seen_[id] == r.epoch_)
+                return;
+            r.seen_[id] = r.epoch_;
+            if(! all && id >= best)
+                return;
+            if(! m.verify(id, u, r))
+                return;
+            if(all)
+                r.ids_.push_back(id);
+            else
+                best = id;
+        };
+
+    for(auto id : m.always)
+        consider(id);
+
+    for(std::size_t i = 0; i < part_count; ++i)
+    {
+        auto const& pi = m.parts[i];
+        if(pi.empty())
+            continue;
+        auto const part = static_cast<url_part>(i);
+        bool const icase = is_icase(part);
+        core::string_view const s = part_of(u, part);
+
+        if(! pi.exact.empty())
+        {
+            r.key_.assign(s.data(), s.size());
+            if(icase)
+                for(char& c : r.key_)
+                    c = grammar::to_lower(c);
+            auto const it = pi.exact.find(r.key_);
+            if(it != pi.exact.end())
+                for(auto id : it->second)
+                    consider(id);
+        }
+
+        for(auto id : pi.always)
+            consider(id);
+
+        if(pi.nodes.size() < 2)
+            continue;
+        std::uint32_t n = 0;
+        for(char ch : s)
+        {
+            auto const c = static_cast<unsigned char>(
+                to_lower(ch, icase));
+            for(;;)
+            {
+                auto const to = pi.child(n, c);
+                if(to != 0)
+                {
+                    n = to;
+                    break;
+                }
+                if(n == 0)
+                    break;
+                n = pi.nodes[n].fail;
+            }
+            auto o = pi.nodes[n].outs != 0
+                ? n : pi.nodes[n].dict;
+            while(o != 0)
+            {
+                auto const& x = pi.nodes[o];
+                for(auto k = x.out;
+                    k < x.out + x.outs; ++k)
+                    consider(pi.outs[k]);
+                o = x.dict;
+            }
+        }
+    }
+    return all ? r.ids_.size() : best;
+}
+
+//------------------------------------------------
+
+bool
+glob_match(
+    core::string_view pattern,
+    core::string_view s,
+    bool icase)
+{
+    std::vector<unsigned char> dp;
+    if(! icase)
+        return glob_match_impl(
+            pattern, s, false, dp);
+    std::string p(pattern);
+    for(char& c : p)
+        c = grammar::to_lower(c);
+    return glob_match_impl(p, s, true, dp);
+}
+
+} // urls
+} // boost
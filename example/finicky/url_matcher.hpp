@@ -0,0 +1,300 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_MATCHER_HPP
+#define BOOST_URL_URL_MATCHER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** The part of a URL a pattern applies to
+*/
+enum class url_part
+{
+    /// The whole URL
+    url,
+
+    /// The scheme, without the colon
+    scheme,
+
+    /// The encoded authority
+    authority,
+
+    /// The encoded userinfo
+    userinfo,
+
+    /// The encoded user
+    user,
+
+    /// The encoded password
+    password,
+
+    /// The encoded host, compared ignoring case
+    host,
+
+    /// The port number
+    port,
+
+    /// The encoded path
+    path,
+
+    /// The encoded query, without the question mark
+    query,
+
+    /// The encoded fragment, without the hash sign
+    fragment
+};
+
+/** A pattern applied to a part of a URL
+
+    A pattern is a string where `*` matches
+    any sequence of characters other than
+    `/`, and `**` matches any sequence of
+    characters. Every other character
+    matches itself. Patterns without
+    stars are literals.
+
+    The scheme and the host are compared
+    ignoring case.
+*/
+struct url_pattern
+{
+    /// The part of the URL
+    url_part part = url_part::url;
+
+    /// The pattern
+    core::string_view pattern;
+};
+
+class url_matcher;
+
+/** The matches of a url_matcher
+
+    This holds the identifiers of the
+    rules which matched a URL, and the
+    scratch memory used while matching.
+    Reusing the same object for many URLs
+    means matching does not allocate once
+    its buffers are large enough.
+*/
+class url_rule_matches
+{
+    friend class url_matcher;
+
+    std::vector<std::size_t> ids_;
+    std::vector<std::uint32_t> seen_;
+    std::vector<unsigned char> dp_;
+    std::string key_;
+    std::uint32_t epoch_ = 0;
+
+public:
+    /// Return the identifiers of the matching rules, in increasing order
+    std::vector<std::size_t> const&
+    ids() const noexcept
+    {
+        return ids_;
+    }
+
+    /// Return the number of matching rules
+    std::size_t
+    size() const noexcept
+    {
+        return ids_.size();
+    }
+
+    /// Return true if no rule matched
+    bool
+    empty() const noexcept
+    {
+        return ids_.empty();
+    }
+};
+
+/** A compiled set of rules which classify URLs
+
+    Each rule is a set of patterns which
+    must all match their parts of a URL.
+    Rules are identified by the order in
+    which they are added, starting at zero,
+    and a rule with a lower identifier has
+    priority over the rules after it.
+
+    When the rules are compiled, literal
+    patterns go into a hash table, and the
+    longest literal piece of each glob goes
+    into an Aho-Corasick automaton for its
+    part of the URL. A URL is matched by
+    looking up and scanning each part once,
+    and only the globs whose literal piece
+    was found are evaluated. The cost of
+    matching depends on the size of the URL
+    and the number of candidate rules, not
+    on the total number of rules.
+
+    @par Example
+    @code
+    url_matcher m;
+    m.add( url_part::host, "*.example.com" );
+    m.add({
+        { url_part::host, "www.boost.org" },
+        { url_part::path, "/doc/libs" } });
+    m.compile();
+
+    url_rule_matches r;
+    assert( m.match( url_view( "https://www.boost.org/doc/libs" ), r ) == 1 );
+    @endcode
+
+    @par Exception Safety
+
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+*/
+class url_matcher
+{
+public:
+    /// A value returned by @ref match when no rule matches
+    static constexpr std::size_t npos =
+        std::size_t(-1);
+
+    /// Constructor
+    url_matcher();
+
+    /// Constructor
+    url_matcher(url_matcher&&) noexcept;
+
+    /// Assignment
+    url_matcher&
+    operator=(url_matcher&&) noexcept;
+
+    /// Destructor
+    ~url_matcher();
+
+    /** Add a rule with a single pattern
+
+        @return The identifier of the rule
+
+        @param part The part of the URL
+        @param pattern The pattern
+    */
+    std::size_t
+    add(
+        url_part part,
+        core::string_view pattern);
+
+    /** Add a rule which requires all patterns to match
+
+        A rule without patterns matches
+        every URL.
+
+        @return The identifier of the rule
+
+        @param patterns The patterns
+    */
+    std::size_t
+    add(std::initializer_list<url_pattern> patterns)
+    {
+        return add(patterns.begin(), patterns.end());
+    }
+
+    /// @copydoc add(std::initializer_list<url_pattern>)
+    std::size_t
+    add(
+        url_pattern const* first,
+        url_pattern const* last);
+
+    /// Return the number of rules
+    std::size_t
+    size() const noexcept;
+
+    /** Compile the rules
+
+        This must be called after the rules
+        are added and before any URL is
+        matched. Adding more rules requires
+        compiling again.
+
+        @par Complexity
+        Linear in the total size of the
+        patterns.
+    */
+    void
+    compile();
+
+    /** Return the first rule which matches a URL
+
+        The matches are not stored in `r`,
+        which only provides scratch memory.
+
+        @return The lowest identifier of a
+        matching rule, or @ref npos.
+
+        @param u The URL
+        @param r The scratch memory
+    */
+    std::size_t
+    match(
+        url_view_base const& u,
+        url_rule_matches& r) const;
+
+    /** Find all the rules which match a URL
+
+        The identifiers are stored in `r`, in
+        increasing order.
+
+        @param u The URL
+        @param r The results
+    */
+    void
+    match_all(
+        url_view_base const& u,
+        url_rule_matches& r) const;
+
+private:
+    struct impl;
+
+    std::size_t
+    match_impl(
+        url_view_base const& u,
+        url_rule_matches& r,
+        bool all) const;
+
+    std::unique_ptr<impl> impl_;
+};
+
+/** Return true if a pattern matches a string
+
+    @param pattern The pattern
+    @param s The string
+    @param icase Whether case is ignored
+
+    @see
+        @ref url_pattern.
+*/
+bool
+glob_match(
+    core::string_view pattern,
+    core::string_view s,
+    bool icase = false);
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2022 alandefreitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+//
+
+//[example_url_matcher_bench
+
+/*
+    This example measures how the time to
+    classify a URL changes with the number
+    of rules. The compiled url_matcher is
+    compared with checking every rule in
+    order, which is what the finicky example
+    did before its rules were compiled.
+*/
+
+#include "url_matcher.hpp"
+#include <boost/url/url_view.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace urls = boost::urls;
+
+struct rule
+{
+    std::string host;
+    std::string path;
+};
+
+// a mix of the rules of a browser picker
+// or a crawler: exact hosts, domains and
+// their subdomains, and paths
+std::vector<rule>
+make_rules(std::size_t n, std::mt19937& g)
+{
+    std::vector<rule> v;
+    v.reserve(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        std::string const id = std::to_string(i);
+        switch(g() % 4)
+        {
+        case 0:
+            v.push_back({ "www.site" + id + ".com", "" });
+            break;
+        case 1:
+            v.push_back({ "*.domain" + id + ".org", "" });
+            break;
+        case 2:
+            v.push_back({ "cdn" + id + ".net", "/assets/**" });
+            break;
+        default:
+            v.push_back({ "", "/api/v" + id + "/*" });
+            break;
+        }
+    }
+    return v;
+}
+
+std::vector<std::string>
+make_urls(
+    std::size_t n,
+    std::size_t rules,
+    std::mt19937& g)
+{
+    std::vector<std::string> v;
+    v.reserve(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        // most urls match no rule
+        std::string const id =
+            std::to_string(g() % (rules * 4));
+        switch(g() % 4)
+        {
+        case 0:
+            v.push_back("https://www.site" + id + ".com/index.html");
+            break;
+        case 1:
+            v.push_back("https://mail.domain" + id + ".org/inbox?x=1");
+            break;
+        case 2:
+            v.push_back("https://cdn" + id + ".net/assets/img/logo.png");
+            break;
+        default:
+            v.push_back("https://example.com/api/v" + id + "/users");
+            break;
+        }
+    }
+    return v;
+}
+
+template<class F>
+double
+ns_per_url(
+    std::vector<std::string> const& urls,
+    F const& f)
+{
+    std::vector<urls::url_view> v;
+    v.reserve(urls.size());
+    for(auto const& s : urls)
+        v.emplace_back(s);
+    std::size_t sum = 0;
+    auto const t0 = std::chrono::steady_clock::now();
+    for(auto const& u : v)
+        sum += f(u);
+    auto const t1 = std::chrono::steady_clock::now();
+    if(sum == 0)
+        std::cout << "";
+    return static_cast<double>(
+        std::chrono::duration_cast<
+            std::chrono::nanoseconds>(t1 - t0).count()) /
+        static_cast<double>(v.size());
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_rules = 100000;
+    if (argc > 2) {
+        std::cout << argv[0] << "\n";
+        std::cout << "Usage: url_matcher_bench [<rules>]\n"
+                     "options:\n"
+                     "    <rules>: The largest number of rules (default: 100000)\n";
+        return EXIT_FAILURE;
+    }
+    if (argc == 2)
+        max_rules = std::strtoul(argv[1], nullptr, 10);
+
+    std::cout <<
+        "     rules   compile (ms)   matcher (ns/url)   linear (ns/url)\n";
+    for (std::size_t n = 10; n <= max_rules; n *= 10)
+    {
+        std::mt19937 g(static_cast<unsigned>(n));
+        auto const rules = make_rules(n, g);
+        auto const urls = make_urls(20000, n, g);
+
+        auto const t0 = std::chrono::steady_clock::now();
+        urls::url_matcher m;
+        for (auto const& r : rules)
+        {
+            if (r.host.empty())
+                m.add(urls::url_part::path, r.path);
+            else if (r.path.empty())
+                m.add(urls::url_part::host, r.host);
+            else
+                m.add({
+                    { urls::url_part::host, r.host },
+                    { urls::url_part::path, r.path } });
+        }
+        m.compile();
+        auto const t1 = std::chrono::steady_clock::now();
+
+        urls::url_rule_matches res;
+        double const compiled = ns_per_url(urls,
+            [&](urls::url_view const& u)
+            {
+                return m.match(u, res);
+            });
+
+        // checking every rule is too slow
+        // to measure with many rules
+        double linear = 0;
+        if (n <= 10000)
+        {
+            linear = ns_per_url(
+                std::vector<std::string>(
+                    urls.begin(), urls.begin() + 2000),
+                [&](urls::url_view const& u)
+                {
+                    for (std::size_t i = 0; i < rules.size(); ++i)
+                    {
+                        auto const& r = rules[i];
+                        if (!r.host.empty() && !urls::glob_match(
+                                r.host, u.encoded_host(), true))
+                            continue;
+                        if (!r.path.empty() && !urls::glob_match(
+                                r.path, u.encoded_path()))
+                            continue;
+                        return i;
+                    }
+                    return urls::url_matcher::npos;
+                });
+        }
+
+        std::cout <<
+            std::setw(10) << n << "   " <<
+            std::setw(12) << std::fixed << std::setprecision(2) <<
+            std::chrono::duration<double, std::milli>(t1 - t0).count() <<
+            "   " << std::setw(16) << std::setprecision(0) << compiled <<
+            "   ";
+        if (linear > 0)
+            std::cout << std::setw(15) << linear;
+        else
+            std::cout << std::setw(15) << "-";
+        std::cout << "\n";
+    }
+    return EXIT_SUCCESS;
+}
+
+//]
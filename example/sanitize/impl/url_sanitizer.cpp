@@ -0,0 +1,473 @@
+//
+// Copyright (c) 2023 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include "../url_sanitizer.hpp"
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+std::string
+to_lower(core::string_view s)
+{
+    std::string r(s);
+    for(char& c : r)
+        c = grammar::to_lower(c);
+    return r;
+}
+
+// compare a lowercase string with
+// a string of any case
+int
+ci_compare(
+    core::string_view lower,
+    core::string_view s) noexcept
+{
+    std::size_t const n =
+        (std::min)(lower.size(), s.size());
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        char const c = grammar::to_lower(s[i]);
+        if(lower[i] != c)
+            return static_cast<unsigned char>(lower[i]) <
+                static_cast<unsigned char>(c) ? -1 : 1;
+    }
+    if(lower.size() != s.size())
+        return lower.size() < s.size() ? -1 : 1;
+    return 0;
+}
+
+/*  Call f with each param of an encoded
+    query and its key, splitting the query
+    the same way as params_encoded_view
+    without validating it again.
+*/
+template<class F>
+void
+for_each_param(
+    core::string_view q,
+    F const& f)
+{
+    char const* it = q.data();
+    char const* const end = it + q.size();
+    for(;;)
+    {
+        char const* const first = it;
+        char const* eq = nullptr;
+        while(it != end && *it != '&')
+        {
+            if(! eq && *it == '=')
+                eq = it;
+            ++it;
+        }
+        core::string_view const param(first,
+            static_cast<std::size_t>(it - first));
+        core::string_view const key(first,
+            static_cast<std::size_t>(
+                (eq ? eq : it) - first));
+        f(param, key);
+        if(it == end)
+            return;
+        ++it;
+    }
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+void
+url_sanitizer::
+key_trie::
+build()
+{
+    nodes.clear();
+    edges.clear();
+    nodes.emplace_back();
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(
+        keys.begin(), keys.end()), keys.end());
+
+    // With the keys sorted, the children
+    // of a node are created in order and
+    // the last one is the only candidate
+    // when inserting the next key.
+    std::vector<std::vector<edge>> tmp(1);
+    std::vector<node> flags(1);
+    for(auto const& k : keys)
+    {
+        core::string_view s = k;
+        bool const prefix =
+            ! s.empty() && s.back() == '*';
+        if(prefix)
+            s.remove_suffix(1);
+        std::uint32_t n = 0;
+        for(char c : s)
+        {
+            auto& v = tmp[n];
+            if(! v.empty() && v.back().c == c)
+            {
+                n = v.back().to;
+                continue;
+            }
+            auto const to = static_cast<
+                std::uint32_t>(tmp.size());
+            v.push_back({ c, to });
+            tmp.emplace_back();
+            flags.emplace_back();
+            n = to;
+        }
+        if(prefix)
+            flags[n].prefix = true;
+        else
+            flags[n].exact = true;
+    }
+
+    nodes = std::move(flags);
+    for(std::size_t i = 0; i < tmp.size(); ++i)
+    {
+        nodes[i].edge = static_cast<
+            std::uint32_t>(edges.size());
+        nodes[i].edges = static_cast<
+            std::uint32_t>(tmp[i].size());
+        edges.insert(edges.end(),
+            tmp[i].begin(), tmp[i].end());
+    }
+}
+
+bool
+url_sanitizer::
+key_trie::
+contains(core::string_view key) const noexcept
+{
+    if(nodes.empty())
+        return false;
+    std::uint32_t n = 0;
+    char const* it = key.data();
+    char const* const end = it + key.size();
+    for(;;)
+    {
+        node const& x = nodes[n];
+        if(x.prefix)
+            return true;
+        if(it == end)
+            return x.exact;
+
+        // decode while walking, so
+        // "utm%5Fsource" is "utm_source"
+        char c = *it++;
+        if(c == '%' && end - it >= 2)
+        {
+            auto const hi = grammar::hexdig_value(it[0]);
+            auto const lo = grammar::hexdig_value(it[1]);
+            if(hi >= 0 && lo >= 0)
+            {
+                c = static_cast<char>(
+                    (hi << 4) + lo);
+                it += 2;
+            }
+        }
+        c = grammar::to_lower(c);
+
+        // the edges of a node are sorted
+        auto const first =
+            edges.begin() + x.edge;
+        auto const last = first + x.edges;
+        auto const e = std::lower_bound(
+            first, last, c,
+            [](edge const& e, char c)
+            {
+                return
+                    static_cast<unsigned char>(e.c) <
+                    static_cast<unsigned char>(c);
+            });
+        if(e == last || e->c != c)
+            return false;
+        n = e->to;
+    }
+}
+
+//------------------------------------------------
+
+void
+url_sanitizer::
+add(core::string_view key)
+{
+    all_.keys.push_back(to_lower(key));
+}
+
+void
+url_sanitizer::
+add(
+    core::string_view host,
+    core::string_view key)
+{
+    bool const subdomains =
+        host.starts_with("*.");
+    if(subdomains)
+        host.remove_prefix(2);
+    std::string h = to_lower(host);
+    std::string k = to_lower(key);
+    auto it = std::find_if(
+        hosts_.begin(), hosts_.end(),
+        [&](host_rules const& r)
+        {
+            return
+                r.host == h &&
+                r.subdomains == subdomains;
+        });
+    if(it != hosts_.end())
+    {
+        it->keys.keys.push_back(std::move(k));
+        return;
+    }
+    host_rules r;
+    r.host = std::move(h);
+    r.subdomains = subdomains;
+    r.keys.keys.push_back(std::move(k));
+    hosts_.push_back(std::move(r));
+}
+
+void
+url_sanitizer::
+add_tracking_params()
+{
+    static constexpr char const* keys[] = {
+        // analytics campaigns
+        "utm_*",
+        "_ga",
+        "_gl",
+        // click identifiers
+        "fbclid",
+        "gclid",
+        "gclsrc",
+        "dclid",
+        "gbraid",
+        "wbraid",
+        "msclkid",
+        "twclid",
+        "li_fat_id",
+        "ttclid",
+        "yclid",
+        // e-mail platforms
+        "mc_cid",
+        "mc_eid",
+        "_hsenc",
+        "_hsmi",
+        "mkt_tok",
+        "oly_anon_id",
+        "oly_enc_id",
+        "vero_id",
+        // others
+        "igshid",
+        "ref_src",
+        "s_cid",
+        };
+    for(auto k : keys)
+        add(k);
+}
+
+void
+url_sanitizer::
+compile()
+{
+    all_.build();
+    std::sort(hosts_.begin(), hosts_.end(),
+        [](host_rules const& a, host_rules const& b)
+        {
+            return ci_compare(a.host, b.host) < 0;
+        });
+    for(auto& h : hosts_)
+        h.keys.build();
+}
+
+template<class F>
+bool
+url_sanitizer::
+for_each_host(
+    core::string_view host,
+    F const& f) const
+{
+    // the host and each of its parent
+    // domains, with the sorted rules
+    // found by binary search
+    bool exact = true;
+    for(;;)
+    {
+        auto it = std::lower_bound(
+            hosts_.begin(), hosts_.end(), host,
+            [](host_rules const& r,
+                core::string_view h)
+            {
+                return ci_compare(r.host, h) < 0;
+            });
+        for(; it != hosts_.end() &&
+            ci_compare(it->host, host) == 0; ++it)
+        {
+            if((exact || it->subdomains) &&
+                    f(it->keys))
+                return true;
+        }
+        auto const dot = host.find('.');
+        if(dot == core::string_view::npos)
+            return false;
+        host.remove_prefix(dot + 1);
+        exact = false;
+    }
+}
+
+auto
+url_sanitizer::
+find_host(core::string_view host) const noexcept ->
+    host_keys
+{
+    host_keys h;
+    if(hosts_.empty())
+        return h;
+    for_each_host(host,
+        [&h](key_trie const& t)
+        {
+            if(h.size == host_keys::max_size)
+            {
+                h.complete = false;
+                return true;
+            }
+            h.tries[h.size++] = &t;
+            return false;
+        });
+    return h;
+}
+
+bool
+url_sanitizer::
+removes(
+    host_keys const& h,
+    core::string_view host,
+    core::string_view key) const noexcept
+{
+    if(all_.contains(key))
+        return true;
+    if(! h.complete)
+        return removes(host, key);
+    for(std::size_t i = 0; i < h.size; ++i)
+        if(h.tries[i]->contains(key))
+            return true;
+    return false;
+}
+
+bool
+url_sanitizer::
+removes(
+    core::string_view host,
+    core::string_view key) const noexcept
+{
+    if(all_.contains(key))
+        return true;
+    if(hosts_.empty())
+        return false;
+    return for_each_host(host,
+        [key](key_trie const& t)
+        {
+            return t.contains(key);
+        });
+}
+
+core::string_view
+url_sanitizer::
+sanitize(
+    url_view_base const& u,
+    std::string& dest) const
+{
+    core::string_view const s = u.buffer();
+    dest.resize(s.size());
+    char* out = &dest[0];
+
+    if(! u.has_query())
+    {
+        std::memcpy(out, s.data(), s.size());
+        return dest;
+    }
+
+    // everything before the query
+    core::string_view const q = u.encoded_query();
+    std::size_t const n = static_cast<
+        std::size_t>(q.data() - s.data()) - 1;
+    std::memcpy(out, s.data(), n);
+    out += n;
+
+    core::string_view const host = u.encoded_host();
+    host_keys const h = find_host(host);
+    char sep = '?';
+    for_each_param(q,
+        [&](core::string_view param,
+            core::string_view key)
+        {
+            if(removes(h, host, key))
+                return;
+            *out++ = sep;
+            std::memcpy(out, param.data(), param.size());
+            out += param.size();
+            sep = '&';
+        });
+
+    // the fragment
+    core::string_view const rest(
+        q.data() + q.size(),
+        s.data() + s.size() - q.data() - q.size());
+    std::memcpy(out, rest.data(), rest.size());
+    out += rest.size();
+
+    dest.resize(static_cast<
+        std::size_t>(out - dest.data()));
+    return dest;
+}
+
+std::size_t
+url_sanitizer::
+sanitize(url_base& u) const
+{
+    if(! u.has_query())
+        return 0;
+    core::string_view const host = u.encoded_host();
+    host_keys const h = find_host(host);
+    std::string q;
+    q.reserve(u.encoded_query().size());
+    std::size_t removed = 0;
+    bool first = true;
+    for_each_param(u.encoded_query(),
+        [&](core::string_view param,
+            core::string_view key)
+        {
+            if(removes(h, host, key))
+            {
+                ++removed;
+                return;
+            }
+            if(! first)
+                q.push_back('&');
+            q.append(param.data(), param.size());
+            first = false;
+        });
+    if(removed == 0)
+        return 0;
+    if(first)
+        u.remove_query();
+    else
+        u.set_encoded_query(q);
+    return removed;
+}
+
+} // urls
+} // boost
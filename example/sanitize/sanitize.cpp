@@ -41,8 +41,16 @@
 
     Once all transformations are applied, the result is a URL
     appropriate for machine-to-machine communication.
+
+    Finally, the example removes the query parameters added by
+    analytics and advertising platforms, such as utm_source,
+    with a url_sanitizer. The sanitizer compiles its patterns
+    once and can then clean any number of URLs in a single
+    pass each, which makes it suitable for link shorteners
+    and caches.
 */
 
+#include "url_sanitizer.hpp"
 #include <boost/url/url.hpp>
 #include <boost/url/parse.hpp>
 #include <boost/url/parse_path.hpp>
@@ -398,6 +406,16 @@ print_url_components(urls::url_view u)
         std::cout << "fragment: " << u.encoded_fragment() << '\n';
 }
 
+void
+print_clean_url(urls::url_view_base const& u)
+{
+    urls::url_sanitizer s;
+    s.add_tracking_params();
+    s.compile();
+    std::string buf;
+    std::cout << "without tracking params: " << s.sanitize(u, buf) << '\n';
+}
+
 int
 main(int argc, char **argv)
 {
@@ -427,6 +445,7 @@ main(int argc, char **argv)
         else
             std::cout << "Input is a valid relative URL\n";
         print_url_components(u);
+        print_clean_url(u);
         return EXIT_SUCCESS;
     }
 
@@ -434,6 +453,7 @@ main(int argc, char **argv)
     std::cout << "input: " << uri_str << '\n';
     urls::url u = sanitize_uri(uri_str);
     print_url_components(u);
+    print_clean_url(u);
     return EXIT_SUCCESS;
 }
 
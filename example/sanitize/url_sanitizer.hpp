@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2023 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_SANITIZER_HPP
+#define BOOST_URL_URL_SANITIZER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A compiled set of query parameters to remove from URLs
+
+    Parameters are removed by key. A key
+    pattern is either an exact key, such
+    as `fbclid`, or a prefix followed by a
+    star, such as `utm_*`. Keys are
+    compared after decoding and ignoring
+    case.
+
+    Patterns may apply to every host or to
+    a single host. A host pattern starting
+    with `*.`, such as `*.amazon.com`,
+    applies to the domain and all of its
+    subdomains.
+
+    The patterns are compiled into a trie,
+    so the cost of checking a key depends
+    on the length of the key and not on the
+    number of patterns. A URL is sanitized
+    in a single pass over its parameters,
+    copying the parameters which are kept
+    into one output buffer.
+
+    @par Example
+    @code
+    url_sanitizer s;
+    s.add( "utm_*" );
+    s.add( "*.example.com", "ref" );
+    s.compile();
+
+    std::string buf;
+    assert( s.sanitize( url_view( "https://www.example.com/?id=1&utm_source=x&ref=y" ), buf ) ==
+        "https://www.example.com/?id=1" );
+    @endcode
+
+    @par Exception Safety
+
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+*/
+class url_sanitizer
+{
+public:
+    /// Constructor
+    url_sanitizer() = default;
+
+    /** Add a key pattern for every host
+
+        @param key The key pattern
+    */
+    void
+    add(core::string_view key);
+
+    /** Add a key pattern for a host
+
+        @param host The host pattern
+        @param key The key pattern
+    */
+    void
+    add(
+        core::string_view host,
+        core::string_view key);
+
+    /** Add the keys of common tracking parameters
+
+        These are the analytics and click
+        identifiers added by advertising and
+        e-mail platforms, such as `utm_*`,
+        `fbclid`, `gclid` and `mc_eid`.
+    */
+    void
+    add_tracking_params();
+
+    /** Compile the patterns
+
+        This must be called after the patterns
+        are added and before any URL is
+        sanitized. Adding more patterns
+        requires compiling again.
+    */
+    void
+    compile();
+
+    /** Return true if a parameter would be removed
+
+        @param host The encoded host of the URL
+        @param key The encoded key of the parameter
+    */
+    bool
+    removes(
+        core::string_view host,
+        core::string_view key) const noexcept;
+
+    /** Write a URL without the removed parameters
+
+        The result is written to `dest`, which
+        is resized to at most the size of `u`
+        before anything is copied, so reusing
+        the same buffer for many URLs does not
+        allocate. When every parameter is
+        removed, the query is removed as well.
+        The URL is otherwise unchanged, and the
+        result is a valid URI reference.
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @return A view of `dest`
+
+        @param u The URL to sanitize
+        @param dest The buffer for the result
+    */
+    core::string_view
+    sanitize(
+        url_view_base const& u,
+        std::string& dest) const;
+
+    /** Remove the parameters from a URL
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @return The number of parameters removed
+
+        @param u The URL to modify
+    */
+    std::size_t
+    sanitize(url_base& u) const;
+
+private:
+    // a trie of lowercase key patterns,
+    // where node 0 is the root
+    struct key_trie
+    {
+        struct node
+        {
+            std::uint32_t edge = 0;
+            std::uint32_t edges = 0;
+            bool exact = false;
+            bool prefix = false;
+        };
+
+        struct edge
+        {
+            char c;
+            std::uint32_t to;
+        };
+
+        std::vector<std::string> keys;
+        std::vector<node> nodes;
+        std::vector<edge> edges;
+
+        void
+        build();
+
+        bool
+        contains(core::string_view key) const noexcept;
+    };
+
+    struct host_rules
+    {
+        std::string host;
+        bool subdomains;
+        key_trie keys;
+    };
+
+    // calls f for each host rule which
+    // applies to the host, until f
+    // returns true
+    template<class F>
+    bool
+    for_each_host(
+        core::string_view host,
+        F const& f) const;
+
+    // the rules which apply to a host,
+    // found once for all of its params
+    struct host_keys
+    {
+        static constexpr std::size_t max_size = 8;
+
+        key_trie const* tries[max_size];
+        std::size_t size = 0;
+        bool complete = true;
+    };
+
+    host_keys
+    find_host(core::string_view host) const noexcept;
+
+    bool
+    removes(
+        host_keys const& h,
+        core::string_view host,
+        core::string_view key) const noexcept;
+
+    key_trie all_;
+    std::vector<host_rules> hosts_;
+};
+
+} // urls
+} // boost
+
+#endif
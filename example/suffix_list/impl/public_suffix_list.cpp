@@ -0,0 +1,595 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include "../public_suffix_list.hpp"
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/*  Serialized layout, all integers are
+    32-bit little endian:
+
+    header  magic "PSL\1", rule count,
+            node count, label bytes
+    nodes   node count * 16 bytes
+    labels  label bytes
+
+    Node 0 is the root. The children of
+    each node are contiguous and sorted
+    by label, and always come after their
+    parent.
+*/
+
+namespace {
+
+constexpr char psl_magic[4] = { 'P', 'S', 'L', '\1' };
+constexpr std::size_t header_size = 16;
+constexpr std::size_t node_size = 16;
+
+// node flags
+constexpr unsigned char is_rule = 1;
+constexpr unsigned char is_exception = 2;
+constexpr unsigned char has_wildcard = 4;
+
+// DNS labels are at most 63 octets
+constexpr std::size_t max_label = 63;
+
+std::uint32_t
+read_u32(char const* p) noexcept
+{
+    auto const* u = reinterpret_cast<
+        unsigned char const*>(p);
+    return
+        static_cast<std::uint32_t>(u[0]) |
+        (static_cast<std::uint32_t>(u[1]) << 8) |
+        (static_cast<std::uint32_t>(u[2]) << 16) |
+        (static_cast<std::uint32_t>(u[3]) << 24);
+}
+
+void
+write_u32(std::string& s, std::uint32_t v)
+{
+    s.push_back(static_cast<char>(v & 0xff));
+    s.push_back(static_cast<char>((v >> 8) & 0xff));
+    s.push_back(static_cast<char>((v >> 16) & 0xff));
+    s.push_back(static_cast<char>((v >> 24) & 0xff));
+}
+
+// remove a trailing dot, which
+// denotes the DNS root
+core::string_view
+trim_host(core::string_view host) noexcept
+{
+    if(!host.empty() && host.back() == '.')
+        host.remove_suffix(1);
+    return host;
+}
+
+// return true if a rule has a label
+// longer than a DNS label, which no
+// host can match and which does not
+// fit in a node
+bool
+has_long_label(core::string_view rule) noexcept
+{
+    std::size_t n = 0;
+    for(char c : rule)
+    {
+        if(c == '.')
+            n = 0;
+        else if(++n > max_label)
+            return true;
+    }
+    return false;
+}
+
+// decode and lowercase a label into buf,
+// returning false if it cannot be a rule
+bool
+decode_label(
+    core::string_view s,
+    char* buf,
+    std::size_t& n) noexcept
+{
+    n = 0;
+    auto it = s.data();
+    auto const end = it + s.size();
+    while(it != end)
+    {
+        if(n == max_label)
+            return false;
+        char c = *it;
+        if( c == '%' &&
+            end - it >= 3)
+        {
+            auto const d0 =
+                grammar::hexdig_value(it[1]);
+            auto const d1 =
+                grammar::hexdig_value(it[2]);
+            if(d0 >= 0 && d1 >= 0)
+            {
+                c = static_cast<char>(
+                    (d0 << 4) + d1);
+                it += 3;
+                buf[n++] = grammar::to_lower(c);
+                continue;
+            }
+        }
+        buf[n++] = grammar::to_lower(c);
+        ++it;
+    }
+    return true;
+}
+
+// return the last n labels of host, or an
+// empty string if host has fewer labels
+core::string_view
+last_labels(
+    core::string_view host,
+    std::size_t n) noexcept
+{
+    if( n == 0 ||
+        host.empty())
+        return {};
+    std::size_t pos = host.size();
+    while(pos > 0)
+    {
+        if(host[pos - 1] == '.')
+        {
+            if(--n == 0)
+                return host.substr(pos);
+        }
+        --pos;
+    }
+    if(n == 1)
+        return host;
+    return {};
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+struct public_suffix_list::node
+{
+    std::uint32_t index;
+    std::uint32_t label_offset;
+    std::uint32_t label_size;
+    unsigned char flags;
+    std::uint32_t first_child;
+    std::uint32_t children;
+};
+
+public_suffix_list::
+public_suffix_list(
+    public_suffix_list const& other)
+{
+    rebind(other);
+}
+
+public_suffix_list::
+public_suffix_list(
+    public_suffix_list&& other) noexcept
+{
+    // moving a string may not preserve
+    // the address of its characters
+    bool const owned =
+        other.blob_.data() == other.storage_.data();
+    storage_ = std::move(other.storage_);
+    blob_ = owned ?
+        core::string_view(storage_) :
+        other.blob_;
+    other.storage_.clear();
+    other.blob_ = {};
+}
+
+public_suffix_list&
+public_suffix_list::
+operator=(public_suffix_list const& other)
+{
+    if(this != &other)
+    {
+        public_suffix_list tmp(other);
+        *this = std::move(tmp);
+    }
+    return *this;
+}
+
+public_suffix_list&
+public_suffix_list::
+operator=(public_suffix_list&& other) noexcept
+{
+    if(this != &other)
+    {
+        bool const owned =
+            other.blob_.data() == other.storage_.data();
+        storage_ = std::move(other.storage_);
+        blob_ = owned ?
+            core::string_view(storage_) :
+            other.blob_;
+        other.storage_.clear();
+        other.blob_ = {};
+    }
+    return *this;
+}
+
+void
+public_suffix_list::
+rebind(public_suffix_list const& other)
+{
+    if(other.blob_.data() == other.storage_.data())
+    {
+        storage_ = other.storage_;
+        blob_ = storage_;
+    }
+    else
+    {
+        storage_.clear();
+        blob_ = other.blob_;
+    }
+}
+
+//------------------------------------------------
+
+public_suffix_list
+public_suffix_list::
+parse(core::string_view dat)
+{
+    // build a tree first, then lay it
+    // out breadth first so siblings
+    // are contiguous
+    struct build_node
+    {
+        std::map<std::string, std::size_t> children;
+        unsigned char flags = 0;
+    };
+    std::vector<build_node> tree(1);
+    std::size_t rules = 0;
+
+    while(!dat.empty())
+    {
+        auto eol = dat.find('\n');
+        core::string_view line = dat.substr(0, eol);
+        dat.remove_prefix(
+            eol == core::string_view::npos ?
+                dat.size() : eol + 1);
+
+        // a rule is the first word of the line
+        auto const ws = line.find_first_of(" \t\r");
+        line = line.substr(0, ws);
+        if( line.empty() ||
+            line.starts_with("//"))
+            continue;
+
+        unsigned char flag = is_rule;
+        if(line.front() == '!')
+        {
+            flag = is_exception;
+            line.remove_prefix(1);
+        }
+        line = trim_host(line);
+        if( line.empty() ||
+            has_long_label(line))
+            continue;
+
+        std::size_t cur = 0;
+        while(!line.empty())
+        {
+            auto const dot = line.find_last_of('.');
+            core::string_view label =
+                dot == core::string_view::npos ?
+                    line : line.substr(dot + 1);
+            line = dot == core::string_view::npos ?
+                core::string_view() : line.substr(0, dot);
+            if( line.empty() &&
+                label == "*" &&
+                flag == is_rule)
+            {
+                // leftmost wildcard
+                flag = has_wildcard;
+                break;
+            }
+            std::string key(label);
+            for(char& c : key)
+                c = grammar::to_lower(c);
+            auto it = tree[cur].children.find(key);
+            if(it == tree[cur].children.end())
+            {
+                tree.emplace_back();
+                it = tree[cur].children.emplace(
+                    std::move(key), tree.size() - 1).first;
+            }
+            cur = it->second;
+        }
+        if((tree[cur].flags & flag) == 0)
+        {
+            tree[cur].flags |= flag;
+            ++rules;
+        }
+    }
+
+    // breadth first order
+    std::vector<std::size_t> order;
+    std::vector<std::string const*> labels;
+    order.reserve(tree.size());
+    labels.reserve(tree.size());
+    order.push_back(0);
+    labels.push_back(nullptr);
+    for(std::size_t i = 0; i < order.size(); ++i)
+    {
+        for(auto const& c : tree[order[i]].children)
+        {
+            order.push_back(c.second);
+            labels.push_back(&c.first);
+        }
+    }
+
+    // pool of unique labels
+    std::string pool;
+    std::unordered_map<std::string, std::uint32_t> offsets;
+    std::vector<std::uint32_t> label_offset(order.size(), 0);
+    for(std::size_t i = 1; i < order.size(); ++i)
+    {
+        auto it = offsets.find(*labels[i]);
+        if(it == offsets.end())
+        {
+            it = offsets.emplace(*labels[i],
+                static_cast<std::uint32_t>(
+                    pool.size())).first;
+            pool.append(*labels[i]);
+        }
+        label_offset[i] = it->second;
+    }
+
+    public_suffix_list psl;
+    std::string& s = psl.storage_;
+    s.reserve(header_size +
+        order.size() * node_size + pool.size());
+    s.append(psl_magic, sizeof(psl_magic));
+    write_u32(s, static_cast<std::uint32_t>(rules));
+    write_u32(s, static_cast<std::uint32_t>(order.size()));
+    write_u32(s, static_cast<std::uint32_t>(pool.size()));
+    std::size_t next = 1;
+    for(std::size_t i = 0; i < order.size(); ++i)
+    {
+        auto const& n = tree[order[i]];
+        std::uint32_t const size = labels[i] ?
+            static_cast<std::uint32_t>(labels[i]->size()) : 0;
+        write_u32(s, label_offset[i]);
+        write_u32(s, size |
+            (static_cast<std::uint32_t>(n.flags) << 8));
+        write_u32(s, static_cast<std::uint32_t>(next));
+        write_u32(s, static_cast<std::uint32_t>(
+            n.children.size()));
+        next += n.children.size();
+    }
+    s.append(pool);
+    psl.blob_ = s;
+    return psl;
+}
+
+system::result<public_suffix_list>
+public_suffix_list::
+load(core::string_view blob) noexcept
+{
+    if( blob.size() < header_size ||
+        std::memcmp(blob.data(),
+            psl_magic, sizeof(psl_magic)) != 0)
+        BOOST_URL_RETURN_EC(
+            grammar::error::invalid);
+    std::uint64_t const nodes =
+        read_u32(blob.data() + 8);
+    std::uint64_t const pool =
+        read_u32(blob.data() + 12);
+    if( nodes == 0 ||
+        header_size + nodes * node_size + pool !=
+            blob.size())
+        BOOST_URL_RETURN_EC(
+            grammar::error::invalid);
+
+    // validate every node so lookups
+    // on untrusted files stay in bounds
+    public_suffix_list psl;
+    psl.blob_ = blob;
+    for(std::uint32_t i = 0; i < nodes; ++i)
+    {
+        node const n = psl.get_node(i);
+        if( n.label_size > max_label ||
+            std::uint64_t(n.label_offset) +
+                n.label_size > pool ||
+            std::uint64_t(n.first_child) +
+                n.children > nodes ||
+            (n.children != 0 &&
+                n.first_child <= i))
+            BOOST_URL_RETURN_EC(
+                grammar::error::invalid);
+    }
+    return psl;
+}
+
+std::size_t
+public_suffix_list::
+size() const noexcept
+{
+    if(blob_.empty())
+        return 0;
+    return read_u32(blob_.data() + 4);
+}
+
+std::size_t
+public_suffix_list::
+nodes() const noexcept
+{
+    if(blob_.empty())
+        return 0;
+    return read_u32(blob_.data() + 8);
+}
+
+//------------------------------------------------
+
+auto
+public_suffix_list::
+get_node(std::uint32_t i) const noexcept ->
+    node
+{
+    char const* p = blob_.data() +
+        header_size + i * node_size;
+    std::uint32_t const v = read_u32(p + 4);
+    node n;
+    n.index = i;
+    n.label_offset = read_u32(p);
+    n.label_size = v & 0xff;
+    n.flags = static_cast<
+        unsigned char>((v >> 8) & 0xff);
+    n.first_child = read_u32(p + 8);
+    n.children = read_u32(p + 12);
+    return n;
+}
+
+core::string_view
+public_suffix_list::
+label_of(node const& n) const noexcept
+{
+    std::size_t const pool = header_size +
+        nodes() * node_size;
+    return blob_.substr(
+        pool + n.label_offset, n.label_size);
+}
+
+bool
+public_suffix_list::
+find_child(
+    node const& parent,
+    core::string_view label,
+    node& child) const noexcept
+{
+    // children are sorted by label
+    std::uint32_t lo = parent.first_child;
+    std::uint32_t hi = lo + parent.children;
+    while(lo < hi)
+    {
+        std::uint32_t const mid = lo + (hi - lo) / 2;
+        node const n = get_node(mid);
+        core::string_view const s = label_of(n);
+        int const c = s.compare(label);
+        if(c == 0)
+        {
+            child = n;
+            return true;
+        }
+        if(c < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return false;
+}
+
+std::size_t
+public_suffix_list::
+match(core::string_view host) const noexcept
+{
+    if(host.empty())
+        return 0;
+
+    // the implicit rule "*"
+    std::size_t best = 1;
+    if(blob_.empty())
+        return best;
+
+    char buf[max_label];
+    node cur = get_node(0);
+    std::size_t depth = 0;
+    std::size_t end = host.size();
+    for(;;)
+    {
+        auto const dot = host.find_last_of('.',
+            end == 0 ? 0 : end - 1);
+        std::size_t const first =
+            (dot == core::string_view::npos ||
+                end == 0) ? 0 : dot + 1;
+        core::string_view const label =
+            host.substr(first, end - first);
+
+        if( (cur.flags & has_wildcard) &&
+            best < depth + 1)
+            best = depth + 1;
+
+        std::size_t n = 0;
+        node child;
+        if( !decode_label(label, buf, n) ||
+            !find_child(cur, core::string_view(
+                buf, n), child))
+            break;
+        cur = child;
+        ++depth;
+        // exception rules always prevail
+        if(cur.flags & is_exception)
+            return depth - 1;
+        if( (cur.flags & is_rule) &&
+            best < depth)
+            best = depth;
+
+        if(first == 0)
+            break;
+        end = first - 1;
+    }
+    return best;
+}
+
+core::string_view
+public_suffix_list::
+public_suffix(
+    core::string_view host) const noexcept
+{
+    host = trim_host(host);
+    return last_labels(host, match(host));
+}
+
+core::string_view
+public_suffix_list::
+public_suffix(
+    url_view_base const& u) const noexcept
+{
+    if(u.host_type() != host_type::name)
+        return {};
+    return public_suffix(u.encoded_host());
+}
+
+core::string_view
+public_suffix_list::
+registrable_domain(
+    core::string_view host) const noexcept
+{
+    host = trim_host(host);
+    std::size_t const n = match(host);
+    if(n == 0)
+        return {};
+    return last_labels(host, n + 1);
+}
+
+core::string_view
+public_suffix_list::
+registrable_domain(
+    url_view_base const& u) const noexcept
+{
+    if(u.host_type() != host_type::name)
+        return {};
+    return registrable_domain(u.encoded_host());
+}
+
+} // urls
+} // boost
@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_PUBLIC_SUFFIX_LIST_HPP
+#define BOOST_URL_PUBLIC_SUFFIX_LIST_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error_types.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** A compiled Public Suffix List
+
+    This container holds the rules of the
+    Public Suffix List in a compact trie
+    of reversed host labels. The trie is
+    stored in a single contiguous blob
+    which can be serialized and later
+    used directly from memory, such as
+    a memory-mapped file, without being
+    rebuilt.
+
+    Lookups walk the labels of a host from
+    right to left, run in time proportional
+    to the number of labels, and never
+    allocate memory.
+
+    @par Example
+    @code
+    public_suffix_list psl =
+        public_suffix_list::parse( dat );
+
+    url_view u( "https://www.example.co.uk/path" );
+
+    assert( psl.public_suffix( u ) == "co.uk" );
+    assert( psl.registrable_domain( u ) == "example.co.uk" );
+    @endcode
+
+    @par Exception Safety
+
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+
+    @see
+        https://publicsuffix.org/list/
+*/
+class public_suffix_list
+{
+public:
+    /** Constructor
+
+        Default constructed lists contain
+        no rules. The implicit rule `*`
+        still applies, so the public suffix
+        of every host is its last label.
+    */
+    public_suffix_list() noexcept = default;
+
+    /** Constructor
+
+        The new list refers to the same
+        blob as `other`.
+    */
+    public_suffix_list(
+        public_suffix_list const& other);
+
+    /// Constructor
+    public_suffix_list(
+        public_suffix_list&& other) noexcept;
+
+    /// Assignment
+    public_suffix_list&
+    operator=(public_suffix_list const& other);
+
+    /// Assignment
+    public_suffix_list&
+    operator=(public_suffix_list&& other) noexcept;
+
+    /** Compile a list from its text format
+
+        Each line of `dat` which is not empty
+        and does not start with `//` is a rule.
+        Rules may contain wildcard labels
+        (`*.ck`) or be exceptions (`!www.ck`).
+        Rules with a label longer than 63
+        characters, which no host can match,
+        are ignored.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param dat The contents of a
+        `public_suffix_list.dat` file
+    */
+    static
+    public_suffix_list
+    parse(core::string_view dat);
+
+    /** Use a serialized list without copying
+
+        The returned list refers to `blob`
+        directly, which must remain valid
+        and unmodified while the list or
+        any copy of it is in use. This is
+        the function to call over the
+        contents of a memory-mapped file.
+
+        @return The list, or an error if
+        `blob` was not produced by
+        @ref serialize.
+
+        @param blob The serialized list
+    */
+    static
+    system::result<public_suffix_list>
+    load(core::string_view blob) noexcept;
+
+    /** Return the serialized list
+
+        The returned bytes can be written
+        to a file and later passed to
+        @ref load.
+    */
+    core::string_view
+    serialize() const noexcept
+    {
+        return blob_;
+    }
+
+    /// Return the number of rules in the list
+    std::size_t
+    size() const noexcept;
+
+    /// Return the number of trie nodes in the list
+    std::size_t
+    nodes() const noexcept;
+
+    /** Return the public suffix of a host
+
+        The host is compared as if it were
+        percent-decoded and lowercase, and
+        a trailing dot is ignored. The
+        returned string is a suffix of the
+        encoded `host`.
+
+        If the host is empty or its
+        suffix has no matching rule, the
+        implicit rule `*` makes the last
+        label the public suffix.
+
+        @par Complexity
+        Linear in `host.size()`.
+
+        @param host The encoded host name
+    */
+    core::string_view
+    public_suffix(
+        core::string_view host) const noexcept;
+
+    /** Return the public suffix of a URL
+
+        This returns an empty string if the
+        host of `u` is not a registered name.
+
+        @param u The URL
+    */
+    core::string_view
+    public_suffix(
+        url_view_base const& u) const noexcept;
+
+    /** Return the registrable domain of a host
+
+        The registrable domain is the public
+        suffix and one more label to its
+        left. This returns an empty string
+        when the host is itself a public
+        suffix.
+
+        @par Complexity
+        Linear in `host.size()`.
+
+        @param host The encoded host name
+    */
+    core::string_view
+    registrable_domain(
+        core::string_view host) const noexcept;
+
+    /** Return the registrable domain of a URL
+
+        This returns an empty string if the
+        host of `u` is not a registered name.
+
+        @param u The URL
+    */
+    core::string_view
+    registrable_domain(
+        url_view_base const& u) const noexcept;
+
+private:
+    struct node;
+
+    // number of labels in the
+    // public suffix of host
+    std::size_t
+    match(core::string_view host) const noexcept;
+
+    node
+    get_node(std::uint32_t i) const noexcept;
+
+    core::string_view
+    label_of(node const& n) const noexcept;
+
+    bool
+    find_child(
+        node const& parent,
+        core::string_view label,
+        node& child) const noexcept;
+
+    void
+    rebind(public_suffix_list const& other);
+
+    std::string storage_;
+    core::string_view blob_;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -12,12 +12,19 @@
     enumerate all domain suffixes controlled
     by registrars.
     https://publicsuffix.org/list/
+
+    This example compiles the list into
+    a compact trie, which can also be saved
+    in binary form and loaded again without
+    being rebuilt.
 */
 
+#include "public_suffix_list.hpp"
 #include <boost/url/url.hpp>
 #include <boost/url/parse.hpp>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 namespace urls = boost::urls;
 
@@ -25,12 +32,16 @@ int main(int argc, char** argv)
 {
     if (argc < 2) {
         std::cout << argv[0] << "\n";
-        std::cout << "Usage: suffix_list <url> <suffix_list>\n"
+        std::cout << "Usage: suffix_list <url> <suffix_list> <output>\n"
                      "options:\n"
                      "    <url>:              A valid url (required)\n"
-                     "    <suffix_list>:      File with the public suffix list (default: public_suffix_list.dat)\n"
+                     "    <suffix_list>:      File with the public suffix list, as text or\n"
+                     "                        compiled (default: public_suffix_list.dat)\n"
+                     "    <output>:           File where the compiled list is written (optional)\n"
                      "examples:\n"
-                     "suffix_list \"www.example.com\" \"public_suffix_list.dat\"\n";
+                     "suffix_list \"https://www.example.com\" \"public_suffix_list.dat\"\n"
+                     "suffix_list \"https://www.example.com\" \"public_suffix_list.dat\" \"psl.bin\"\n"
+                     "suffix_list \"https://www.example.com\" \"psl.bin\"\n";
         return EXIT_FAILURE;
     }
 
@@ -40,42 +51,44 @@ int main(int argc, char** argv)
         argc < 3 ?
             "public_suffix_list.dat" :
             argv[2];
-    std::ifstream fin(filename);
-    if (fin.bad())
+    std::ifstream fin(filename, std::ios::binary);
+    if (!fin)
     {
         std::cerr << "Cannot open " << filename << "\n";
         return EXIT_FAILURE;
     }
+    std::stringstream ss;
+    ss << fin.rdbuf();
+    std::string contents = ss.str();
+
+    // Use the file directly if it was
+    // already compiled, otherwise parse
+    // the text format
+    urls::public_suffix_list psl;
+    auto rv = urls::public_suffix_list::load(contents);
+    if (rv)
+        psl = *rv;
+    else
+        psl = urls::public_suffix_list::parse(contents);
 
-    std::string comment;
-    std::string suffix;
-    std::string line;
-    while (std::getline(fin, line))
+    if (argc > 3)
     {
-        boost::core::string_view sv(line);
-        if (sv.starts_with("//") && suffix.empty())
-        {
-            comment.append(sv.substr(3));
-            comment.append("\n");
-        }
-        else if (line.empty())
-        {
-            if (suffix.empty())
-                comment.clear();
-            else
-                break;
-        }
-        else if (u.encoded_host().ends_with(line))
+        std::ofstream fout(argv[3], std::ios::binary);
+        auto blob = psl.serialize();
+        fout.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        if (!fout)
         {
-            suffix = line;
+            std::cerr << "Cannot write " << argv[3] << "\n";
+            return EXIT_FAILURE;
         }
     }
 
     std::cout <<
-        "url:    \n" << u                << "\n\n"
-        "host:   \n" << u.encoded_host() << "\n\n"
-        "suffix: \n" << suffix           << "\n\n"
-        "detail: \n" << comment          << "\n\n";
+        "url:    \n" << u                         << "\n\n"
+        "host:   \n" << u.encoded_host()          << "\n\n"
+        "suffix: \n" << psl.public_suffix(u)      << "\n\n"
+        "domain: \n" << psl.registrable_domain(u) << "\n\n"
+        "rules:  \n" << psl.size()                << "\n\n";
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,448 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include "../url_filter.hpp"
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/core/bit.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+/*  Layout
+
+    The blob is a header of 8 words followed
+    by the blocks, each made of 8 words. The
+    words are in the byte order of the host.
+
+    header: magic, byte order, blocks,
+            hashes, k0, k1, capacity, 0
+    block:  512 bits
+*/
+
+constexpr std::size_t header_words = 8;
+constexpr std::size_t block_words = 8;
+constexpr std::size_t block_bits = 512;
+
+constexpr char filter_magic[8] = {
+    'B', 'U', 'R', 'L', 'B', 'L', 'M', '1' };
+constexpr std::uint64_t byte_order =
+    0x0102030405060708;
+
+// the block is chosen from 32 bits of
+// the digest, and the blob must fit
+// in memory
+constexpr std::size_t max_blocks =
+    sizeof(std::size_t) > 4 ? 0xffffffff :
+    (std::numeric_limits<std::size_t>::max)() /
+        url_filter::block_size - 1;
+
+constexpr std::size_t max_hashes = 16;
+
+
+enum : std::size_t
+{
+    w_magic = 0,
+    w_order,
+    w_blocks,
+    w_hashes,
+    w_k0,
+    w_k1,
+    w_capacity
+};
+
+std::uint64_t
+read_u64(char const* p) noexcept
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Return the false positive rate of a
+// blocked filter whose blocks hold lambda
+// urls on average. Blocks receive an
+// uneven share of the urls, following a
+// Poisson distribution, which makes the
+// rate higher than the one of a classic
+// filter with as many bits.
+double
+blocked_fp_rate(
+    double lambda,
+    std::size_t k) noexcept
+{
+    double const kd =
+        static_cast<double>(k);
+    double const q =
+        1 - kd / block_bits;
+    auto const jmax = static_cast<std::size_t>(
+        lambda + 10 * std::sqrt(lambda) + 10);
+    double pj = std::exp(-lambda);
+    double rate = 0;
+    for(std::size_t j = 0; j <= jmax; ++j)
+    {
+        double const jd =
+            static_cast<double>(j);
+        rate += pj * std::pow(
+            1 - std::pow(q, jd), kd);
+        pj *= lambda / (jd + 1);
+    }
+    return rate;
+}
+
+} // (anon)
+
+constexpr std::size_t url_filter::block_size;
+
+url_filter::
+url_filter(
+    std::size_t capacity,
+    double fp_rate,
+    std::uint64_t k0,
+    std::uint64_t k1)
+{
+    if(!( fp_rate > 0 &&
+          fp_rate < 1))
+        detail::throw_invalid_argument();
+
+    // a classic filter needs log2(1/p)
+    // hashes and log2(1/p) / ln(2) bits
+    // for each url, which are then
+    // increased until the blocked filter
+    // reaches the same rate
+    double const bits =
+        -std::log2(fp_rate);
+    std::size_t const k = (std::min)(
+        max_hashes, (std::max)(
+            std::size_t(1),
+            static_cast<std::size_t>(
+                bits + 0.5)));
+    double per_url = (std::max)(
+        1.0, bits / std::log(2.0));
+    while(blocked_fp_rate(
+            block_bits / per_url, k) > fp_rate)
+        per_url *= 1.02;
+    double const n = std::ceil(
+        per_url * static_cast<double>(
+            (std::max)(capacity, std::size_t(1))) /
+        block_bits);
+    if(n > static_cast<double>(max_blocks))
+        detail::throw_length_error();
+    init(static_cast<std::size_t>(n),
+        k, k0, k1, capacity);
+}
+
+url_filter::
+url_filter(url_filter const& other)
+{
+    if(other.read_only())
+    {
+        blob_ = other.blob_;
+        nblocks_ = other.nblocks_;
+        k_ = other.k_;
+        k0_ = other.k0_;
+        k1_ = other.k1_;
+        return;
+    }
+    init(other.nblocks_, other.k_,
+        other.k0_, other.k1_,
+            other.capacity());
+    auto const n = header_words +
+        nblocks_ * block_words;
+    for(std::size_t i = header_words;
+            i < n; ++i)
+        words_[i].store(other.word(i),
+            std::memory_order_relaxed);
+}
+
+url_filter::
+url_filter(url_filter&& other) noexcept
+    : storage_(std::move(other.storage_))
+    , words_(other.words_)
+    , blob_(other.blob_)
+    , nblocks_(other.nblocks_)
+    , k_(other.k_)
+    , k0_(other.k0_)
+    , k1_(other.k1_)
+{
+    other.words_ = nullptr;
+    other.blob_ = nullptr;
+    other.nblocks_ = 0;
+    other.k_ = 0;
+}
+
+url_filter&
+url_filter::
+operator=(url_filter const& other)
+{
+    if(this != &other)
+        *this = url_filter(other);
+    return *this;
+}
+
+url_filter&
+url_filter::
+operator=(url_filter&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    storage_ = std::move(other.storage_);
+    words_ = other.words_;
+    blob_ = other.blob_;
+    nblocks_ = other.nblocks_;
+    k_ = other.k_;
+    k0_ = other.k0_;
+    k1_ = other.k1_;
+    other.words_ = nullptr;
+    other.blob_ = nullptr;
+    other.nblocks_ = 0;
+    other.k_ = 0;
+    return *this;
+}
+
+system::result<url_filter>
+url_filter::
+load(core::string_view blob) noexcept
+{
+    auto const header =
+        header_words * sizeof(std::uint64_t);
+    if( blob.size() < header ||
+        std::memcmp(blob.data(),
+            filter_magic, sizeof(filter_magic)) != 0 ||
+        read_u64(blob.data() + 8 * w_order) !=
+            byte_order)
+        BOOST_URL_RETURN_EC(
+            grammar::error::invalid);
+    std::uint64_t const nblocks =
+        read_u64(blob.data() + 8 * w_blocks);
+    std::uint64_t const k =
+        read_u64(blob.data() + 8 * w_hashes);
+    if( nblocks == 0 ||
+        nblocks > max_blocks ||
+        k == 0 ||
+        k > max_hashes ||
+        (nblocks + 1) * block_size !=
+            blob.size())
+        BOOST_URL_RETURN_EC(
+            grammar::error::invalid);
+    url_filter f;
+    f.blob_ = blob.data();
+    f.nblocks_ =
+        static_cast<std::size_t>(nblocks);
+    f.k_ = static_cast<std::size_t>(k);
+    f.k0_ = read_u64(blob.data() + 8 * w_k0);
+    f.k1_ = read_u64(blob.data() + 8 * w_k1);
+    return f;
+}
+
+core::string_view
+url_filter::
+serialize() const noexcept
+{
+    if(! blob_)
+        return {};
+    return core::string_view(blob_,
+        (nblocks_ + 1) * block_size);
+}
+
+bool
+url_filter::
+insert(digest_type const& d) noexcept
+{
+    BOOST_ASSERT(! read_only());
+    std::uint64_t m[block_words] = {};
+    auto const base = header_words +
+        masks(d, m) * block_words;
+    bool added = false;
+    for(std::size_t i = 0;
+            i < block_words; ++i)
+    {
+        if(m[i] == 0)
+            continue;
+        // urls seen before leave the
+        // cache line clean
+        auto& w = words_[base + i];
+        if((w.load(std::memory_order_relaxed) &
+                m[i]) == m[i])
+            continue;
+        if((w.fetch_or(m[i],
+                std::memory_order_relaxed) &
+                    m[i]) != m[i])
+            added = true;
+    }
+    return added;
+}
+
+bool
+url_filter::
+contains(digest_type const& d) const noexcept
+{
+    if(nblocks_ == 0)
+        return false;
+    std::uint64_t m[block_words] = {};
+    auto const base = header_words +
+        masks(d, m) * block_words;
+    for(std::size_t i = 0;
+            i < block_words; ++i)
+    {
+        if((word(base + i) & m[i]) != m[i])
+            return false;
+    }
+    return true;
+}
+
+void
+url_filter::
+merge(url_filter const& other)
+{
+    if( read_only() ||
+        nblocks_ != other.nblocks_ ||
+        k_ != other.k_ ||
+        k0_ != other.k0_ ||
+        k1_ != other.k1_)
+        detail::throw_invalid_argument();
+    auto const n = header_words +
+        nblocks_ * block_words;
+    for(std::size_t i = header_words;
+            i < n; ++i)
+    {
+        auto const v = other.word(i);
+        if(v != 0)
+            words_[i].fetch_or(v,
+                std::memory_order_relaxed);
+    }
+}
+
+std::size_t
+url_filter::
+capacity() const noexcept
+{
+    if(! blob_)
+        return 0;
+    return static_cast<std::size_t>(
+        word(w_capacity));
+}
+
+std::size_t
+url_filter::
+size_estimate() const noexcept
+{
+    if(nblocks_ == 0)
+        return 0;
+    auto const n = header_words +
+        nblocks_ * block_words;
+    std::size_t x = 0;
+    for(std::size_t i = header_words;
+            i < n; ++i)
+        x += boost::core::popcount(word(i));
+    // n = -(m / k) ln(1 - x / m)
+    double const m = static_cast<double>(
+        nblocks_ * block_bits);
+    double const fill = (std::min)(
+        static_cast<double>(x), m - 1) / m;
+    return static_cast<std::size_t>(
+        -m / static_cast<double>(k_) *
+            std::log(1 - fill) + 0.5);
+}
+
+//------------------------------------------------
+
+std::uint64_t
+url_filter::
+word(std::size_t i) const noexcept
+{
+    if(words_)
+        return words_[i].load(
+            std::memory_order_relaxed);
+    return read_u64(blob_ + 8 * i);
+}
+
+std::size_t
+url_filter::
+masks(
+    digest_type const& d,
+    std::uint64_t* m) const noexcept
+{
+    // the block comes from the first half
+    // of the digest, and the bits of the
+    // block from the top bits of successive
+    // multiples of the second half. Double
+    // hashing would place the bits in an
+    // arithmetic progression, which within
+    // a small block raises the rate of
+    // false positives.
+    auto const block = static_cast<std::size_t>(
+        ((d.first >> 32) * nblocks_) >> 32);
+    auto h = d.second;
+    for(std::size_t i = 0; i < k_; ++i)
+    {
+        h *= 0x9e3779b97f4a7c15;
+        auto const bit = static_cast<
+            std::size_t>(h >> 55);
+        m[bit / 64] |= std::uint64_t(1) << (bit % 64);
+    }
+    return block;
+}
+
+void
+url_filter::
+init(
+    std::size_t nblocks,
+    std::size_t k,
+    std::uint64_t k0,
+    std::uint64_t k1,
+    std::size_t capacity)
+{
+    static_assert(
+        sizeof(std::atomic<std::uint64_t>) ==
+            sizeof(std::uint64_t),
+        "atomic words must be stored as words");
+
+    // over-allocate, to start the blocks
+    // at the beginning of a cache line
+    auto const extra = block_size /
+        sizeof(std::uint64_t) - 1;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> p(
+        new std::atomic<std::uint64_t>[
+            header_words + nblocks * block_words + extra]());
+    auto const addr =
+        reinterpret_cast<std::uintptr_t>(p.get());
+    auto const skip = (block_size -
+        addr % block_size) % block_size /
+            sizeof(std::uint64_t);
+    auto const words = p.get() + skip;
+
+    std::uint64_t magic;
+    std::memcpy(&magic, filter_magic,
+        sizeof(magic));
+    words[w_magic].store(magic);
+    words[w_order].store(byte_order);
+    words[w_blocks].store(nblocks);
+    words[w_hashes].store(k);
+    words[w_k0].store(k0);
+    words[w_k1].store(k1);
+    words[w_capacity].store(capacity);
+
+    storage_ = std::move(p);
+    words_ = words;
+    blob_ = reinterpret_cast<char const*>(words);
+    nblocks_ = nblocks;
+    k_ = k;
+    k0_ = k0;
+    k1_ = k1;
+}
+
+} // urls
+} // boost
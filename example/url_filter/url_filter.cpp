@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2022 alandefreitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+//
+
+//[example_url_filter
+
+/*
+    This example reads a list of URLs, such
+    as the links found by a crawler, and
+    uses a url_filter to count the URLs
+    which were already seen, with a few
+    bits per URL. The filter can then be
+    saved to a file, which a later run could
+    memory-map and pass to url_filter::load.
+*/
+
+#include "url_filter.hpp"
+#include <boost/url/parse.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace urls = boost::urls;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cout << argv[0] << "\n";
+        std::cout << "Usage: url_filter <input> <rate> <output>\n"
+                     "options:\n"
+                     "    <input>:            File with one URL per line (required)\n"
+                     "    <rate>:             False positive rate (default: 0.01)\n"
+                     "    <output>:           File where the filter is saved (optional)\n"
+                     "examples:\n"
+                     "url_filter links.txt\n"
+                     "url_filter links.txt 0.001 seen.bin\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream fin(argv[1]);
+    if (!fin)
+    {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+    double const rate = argc > 2 ? std::atof(argv[2]) : 0.01;
+    if (!(rate > 0 && rate < 1))
+    {
+        std::cerr << "Invalid rate " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // keep the valid lines only
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(fin, line))
+    {
+        if (urls::parse_uri_reference(line))
+            lines.push_back(std::move(line));
+    }
+
+    urls::url_filter filter(lines.size(), rate);
+    std::size_t seen = 0;
+    auto const t0 = std::chrono::steady_clock::now();
+    for (auto const& s : lines)
+    {
+        if (!filter.insert(urls::url_view(s)))
+            ++seen;
+    }
+    std::chrono::duration<double, std::nano> const dt =
+        std::chrono::steady_clock::now() - t0;
+
+    std::cout <<
+        "urls:        " << lines.size()           << "\n"
+        "seen:        " << seen                   << "\n"
+        "estimate:    " << filter.size_estimate() << "\n"
+        "bytes:       " << filter.memory_usage()  << "\n";
+    if (!lines.empty())
+    {
+        std::cout <<
+            "bits/url:    " << 8.0 * filter.memory_usage() / lines.size() << "\n"
+            "ns/insert:   " << dt.count() / lines.size() << "\n";
+    }
+
+    if (argc > 3)
+    {
+        std::ofstream fout(argv[3], std::ios::binary);
+        auto const blob = filter.serialize();
+        fout.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        if (!fout)
+        {
+            std::cerr << "Cannot write " << argv[3] << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//]
@@ -0,0 +1,332 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_FILTER_HPP
+#define BOOST_URL_URL_FILTER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error_types.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+/** A probabilistic set of URLs
+
+    This is a Bloom filter answering the
+    question "was this URL already seen?"
+    with a few bits per URL. URLs are
+    identified by their 128-bit digest,
+    which is computed as if they were
+    normalized, so URLs which compare
+    equal are the same element. URLs which
+    differ only by an escaped delimiter,
+    such as `%23` and `#`, are different
+    elements.
+
+    A URL which was inserted is always
+    found. A URL which was not inserted is
+    found with a probability close to the
+    false positive rate chosen when the
+    filter is constructed, as long as no
+    more than its capacity of URLs are
+    inserted.
+
+    Each URL sets bits in a single block of
+    64 bytes, so lookups touch a single
+    cache line. Inserts only set bits with
+    atomic operations, so many threads can
+    insert into and query the same filter.
+
+    Filters with the same parameters, such
+    as the shards of a crawl, can be
+    merged. The bits of a filter form a
+    contiguous blob, which can be written
+    to a file and later used directly from
+    memory, such as a memory-mapped file.
+
+    @par Example
+    @code
+    url_filter f( 1000000, 0.01 );
+
+    assert( f.insert( url_view( "https://www.example.com/a" ) ) );
+    assert( ! f.insert( url_view( "HTTPS://www.example.com/%61" ) ) );
+    assert( f.contains( url_view( "https://www.example.com/./a" ) ) );
+    @endcode
+
+    @par Exception Safety
+
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+*/
+class url_filter
+{
+public:
+    /// The type of the digest of a URL
+    using digest_type =
+        std::pair<std::uint64_t, std::uint64_t>;
+
+    /// The size of each block, in bytes
+    static constexpr std::size_t block_size = 64;
+
+    /** Constructor
+
+        Default constructed filters are empty
+        and read-only.
+    */
+    url_filter() noexcept = default;
+
+    /** Constructor
+
+        The filter holds enough bits for
+        `capacity` URLs to be found by mistake
+        with a probability of about `fp_rate`.
+
+        The keys are passed to
+        @ref url_view_base::digest128.
+        Choosing a secret key resists inputs
+        crafted to collide. Filters can only
+        be merged if they use the same keys.
+
+        @par Example
+        @code
+        url_filter f( 1000000, 0.001 );
+        @endcode
+
+        @throw system_error
+        `fp_rate` is not in the range (0, 1),
+        or the filter would be too large.
+
+        @param capacity The expected number of URLs
+        @param fp_rate The false positive rate
+        @param k0 The first half of the key
+        @param k1 The second half of the key
+    */
+    url_filter(
+        std::size_t capacity,
+        double fp_rate,
+        std::uint64_t k0 = 0,
+        std::uint64_t k1 = 0);
+
+    /** Constructor
+
+        If `other` is read-only, the new
+        filter refers to the same blob.
+        Otherwise the bits are copied.
+    */
+    url_filter(url_filter const& other);
+
+    /// Constructor
+    url_filter(url_filter&& other) noexcept;
+
+    /// Assignment
+    url_filter&
+    operator=(url_filter const& other);
+
+    /// Assignment
+    url_filter&
+    operator=(url_filter&& other) noexcept;
+
+    /** Use a serialized filter without copying
+
+        The returned filter refers to `blob`
+        directly, which must remain valid
+        and unmodified while the filter or
+        any copy of it is in use. This is
+        the function to call over the
+        contents of a memory-mapped file.
+
+        The filter is read-only: it can be
+        queried and merged into other
+        filters, but not modified.
+
+        @return The filter, or an error if
+        `blob` was not produced by
+        @ref serialize on a machine with the
+        same byte order.
+
+        @param blob The serialized filter
+    */
+    static
+    system::result<url_filter>
+    load(core::string_view blob) noexcept;
+
+    /** Return the serialized filter
+
+        The returned bytes can be written
+        to a file and later passed to
+        @ref load. They must not be read
+        while other threads insert URLs.
+    */
+    core::string_view
+    serialize() const noexcept;
+
+    /// Return true if the filter cannot be modified
+    bool
+    read_only() const noexcept
+    {
+        return words_ == nullptr;
+    }
+
+    /** Return the digest used to identify a URL
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @param u The URL
+    */
+    digest_type
+    digest(url_view_base const& u) const noexcept
+    {
+        return u.digest128(k0_, k1_);
+    }
+
+    /** Insert a URL
+
+        This function can be called from
+        multiple threads at once, together
+        with @ref contains. When two threads
+        insert the same URL at once, both
+        calls can return `true`.
+
+        @par Preconditions
+        @code
+        ! this->read_only()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @return `true` if the URL was not in
+        the filter, or `false` if it was
+        probably inserted before.
+
+        @param u The URL
+    */
+    bool
+    insert(url_view_base const& u) noexcept
+    {
+        return insert(digest(u));
+    }
+
+    /// @copydoc insert
+    bool
+    insert(digest_type const& d) noexcept;
+
+    /** Return true if a URL was probably inserted
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @param u The URL
+    */
+    bool
+    contains(url_view_base const& u) const noexcept
+    {
+        return contains(digest(u));
+    }
+
+    /// @copydoc contains
+    bool
+    contains(digest_type const& d) const noexcept;
+
+    /** Insert the URLs of another filter
+
+        After the call, the filter contains
+        every URL inserted in either filter.
+
+        @par Complexity
+        Linear in @ref memory_usage.
+
+        @throw system_error
+        The filters have different
+        parameters or keys, or this filter
+        is read-only.
+
+        @param other The filter to merge
+    */
+    void
+    merge(url_filter const& other);
+
+    /// Return the number of URLs the filter was sized for
+    std::size_t
+    capacity() const noexcept;
+
+    /// Return the number of blocks
+    std::size_t
+    blocks() const noexcept
+    {
+        return nblocks_;
+    }
+
+    /// Return the number of bits set for each URL
+    std::size_t
+    hashes() const noexcept
+    {
+        return k_;
+    }
+
+    /// Return the size of the blob, in bytes
+    std::size_t
+    memory_usage() const noexcept
+    {
+        return serialize().size();
+    }
+
+    /** Return an estimate of the number of URLs inserted
+
+        The estimate is computed from the
+        number of bits set.
+
+        @par Complexity
+        Linear in @ref memory_usage.
+    */
+    std::size_t
+    size_estimate() const noexcept;
+
+private:
+    std::uint64_t
+    word(std::size_t i) const noexcept;
+
+    // the bits of d within its block,
+    // and the index of the block
+    std::size_t
+    masks(
+        digest_type const& d,
+        std::uint64_t* m) const noexcept;
+
+    void
+    init(
+        std::size_t nblocks,
+        std::size_t k,
+        std::uint64_t k0,
+        std::uint64_t k1,
+        std::size_t capacity);
+
+    std::unique_ptr<
+        std::atomic<std::uint64_t>[]> storage_;
+    std::atomic<std::uint64_t>* words_ = nullptr;
+    char const* blob_ = nullptr;
+    std::size_t nblocks_ = 0;
+    std::size_t k_ = 0;
+    std::uint64_t k0_ = 0;
+    std::uint64_t k1_ = 0;
+};
+
+} // urls
+} // boost
+
+#endif
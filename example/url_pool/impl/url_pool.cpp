@@ -0,0 +1,317 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include "../url_pool.hpp"
+#include <boost/url/parse.hpp>
+#include <algorithm>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+/*  Layout
+
+    The pool is a sequence of records in
+    a single string, and blocks_ holds the
+    offset of the first record of each
+    block. Lengths are LEB128 varints.
+
+    head record:    len, bytes[len]
+    other records:  shared, len, bytes[len]
+
+    where shared is the size of the prefix
+    in common with the previous url.
+*/
+
+void
+put_varint(
+    std::string& s,
+    std::size_t n)
+{
+    while(n >= 0x80)
+    {
+        s.push_back(static_cast<char>(
+            (n & 0x7f) | 0x80));
+        n >>= 7;
+    }
+    s.push_back(static_cast<char>(n));
+}
+
+std::size_t
+get_varint(
+    core::string_view s,
+    std::size_t& pos) noexcept
+{
+    std::size_t n = 0;
+    int shift = 0;
+    for(;;)
+    {
+        BOOST_ASSERT(pos < s.size());
+        auto const c = static_cast<
+            unsigned char>(s[pos++]);
+        n |= static_cast<std::size_t>(
+            c & 0x7f) << shift;
+        if(c < 0x80)
+            return n;
+        shift += 7;
+    }
+}
+
+std::size_t
+common_prefix(
+    core::string_view a,
+    core::string_view b) noexcept
+{
+    std::size_t const n =
+        (std::min)(a.size(), b.size());
+    std::size_t i = 0;
+    while(i < n && a[i] == b[i])
+        ++i;
+    return i;
+}
+
+// the urls in the pool are known
+// to be valid, so this cannot fail
+url_view
+view_of(core::string_view s)
+{
+    auto rv = parse_uri_reference(s);
+    BOOST_ASSERT(rv.has_value());
+    return *rv;
+}
+
+} // (anon)
+
+constexpr std::size_t url_pool::npos;
+constexpr std::size_t url_pool::block_size;
+
+void
+url_pool::
+build(std::vector<url_view>& v)
+{
+    // stable_sort stays in bounds even
+    // if the comparison is inconsistent
+    std::stable_sort(v.begin(), v.end(),
+        [](url_view const& a, url_view const& b)
+        {
+            return a.compare(b) < 0;
+        });
+    v.erase(std::unique(v.begin(), v.end(),
+        [](url_view const& a, url_view const& b)
+        {
+            return a.compare(b) == 0;
+        }), v.end());
+
+    std::string data;
+    std::vector<std::size_t> blocks;
+    blocks.reserve(
+        (v.size() + block_size - 1) / block_size);
+    std::size_t url_bytes = 0;
+    core::string_view prev;
+    for(std::size_t i = 0; i < v.size(); ++i)
+    {
+        core::string_view const s = v[i].buffer();
+        url_bytes += s.size();
+        if(i % block_size == 0)
+        {
+            blocks.push_back(data.size());
+            put_varint(data, s.size());
+            data.append(s.data(), s.size());
+        }
+        else
+        {
+            std::size_t const n =
+                common_prefix(prev, s);
+            put_varint(data, n);
+            put_varint(data, s.size() - n);
+            data.append(s.data() + n, s.size() - n);
+        }
+        prev = s;
+    }
+    data.shrink_to_fit();
+
+    data_ = std::move(data);
+    blocks_ = std::move(blocks);
+    size_ = v.size();
+    url_bytes_ = url_bytes;
+}
+
+std::size_t
+url_pool::
+decode(
+    std::size_t pos,
+    bool head,
+    std::string& scratch) const
+{
+    std::size_t shared = 0;
+    if(! head)
+        shared = get_varint(data_, pos);
+    std::size_t const n =
+        get_varint(data_, pos);
+    BOOST_ASSERT(shared <= scratch.size());
+    scratch.resize(shared);
+    scratch.append(data_.data() + pos, n);
+    return pos + n;
+}
+
+std::size_t
+url_pool::
+find_block(
+    url_view_base const& u,
+    std::string& scratch) const
+{
+    // first block whose head is greater
+    // than u, minus one
+    std::size_t lo = 0;
+    std::size_t hi = blocks_.size();
+    while(lo < hi)
+    {
+        std::size_t const mid = lo + (hi - lo) / 2;
+        decode(blocks_[mid], true, scratch);
+        if(view_of(scratch).compare(u) <= 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+url_view
+url_pool::
+get(
+    std::size_t i,
+    std::string& scratch) const
+{
+    BOOST_ASSERT(i < size_);
+    std::size_t const b = i / block_size;
+    std::size_t pos = blocks_[b];
+    pos = decode(pos, true, scratch);
+    for(std::size_t j = b * block_size;
+        j < i; ++j)
+        pos = decode(pos, false, scratch);
+    return view_of(scratch);
+}
+
+std::size_t
+url_pool::
+find(url_view_base const& u) const
+{
+    std::string scratch;
+    std::size_t const b = find_block(u, scratch);
+    if(b == 0)
+        return npos;
+    std::size_t i = (b - 1) * block_size;
+    std::size_t const end =
+        (std::min)(i + block_size, size_);
+    std::size_t pos = decode(
+        blocks_[b - 1], true, scratch);
+    for(;;)
+    {
+        int const r = view_of(scratch).compare(u);
+        if(r == 0)
+            return i;
+        if(r > 0 || ++i == end)
+            return npos;
+        pos = decode(pos, false, scratch);
+    }
+}
+
+url_pool::
+iterator
+url_pool::
+lower_bound(url_view_base const& u) const
+{
+    std::string scratch;
+    std::size_t const b = find_block(u, scratch);
+    if(b == 0)
+        return begin();
+    iterator it(this, (b - 1) * block_size);
+    iterator const last = end();
+    while(it != last && (*it).compare(u) < 0)
+        ++it;
+    return it;
+}
+
+url_pool::
+iterator
+url_pool::
+begin() const
+{
+    return { this, 0 };
+}
+
+url_pool::
+iterator
+url_pool::
+end() const noexcept
+{
+    iterator it;
+    it.p_ = this;
+    it.i_ = size_;
+    return it;
+}
+
+double
+url_pool::
+compression_ratio() const noexcept
+{
+    std::size_t const n =
+        data_.size() +
+        blocks_.size() * sizeof(blocks_[0]);
+    if(n == 0)
+        return 1;
+    return static_cast<double>(url_bytes_) /
+        static_cast<double>(n);
+}
+
+//------------------------------------------------
+
+url_pool::
+iterator::
+iterator(
+    url_pool const* p,
+    std::size_t i)
+    : p_(p)
+    , i_(i)
+{
+    // i is the first url of a block
+    BOOST_ASSERT(i % block_size == 0);
+    if(i_ < p_->size_)
+        next_ = p_->decode(
+            p_->blocks_[i_ / block_size],
+            true, buf_);
+}
+
+auto
+url_pool::
+iterator::
+operator++() ->
+    iterator&
+{
+    BOOST_ASSERT(i_ < p_->size_);
+    if(++i_ == p_->size_)
+        return *this;
+    next_ = p_->decode(next_,
+        i_ % block_size == 0, buf_);
+    return *this;
+}
+
+auto
+url_pool::
+iterator::
+operator*() const ->
+    reference
+{
+    BOOST_ASSERT(i_ < p_->size_);
+    return view_of(buf_);
+}
+
+} // urls
+} // boost
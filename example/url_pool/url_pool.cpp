@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2022 alandefreitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+//
+
+//[example_url_pool
+
+/*
+    This example loads a list of URLs, such
+    as a crawl frontier or the contents of a
+    sitemap, into a front coded url_pool and
+    reports how much smaller it is. URLs
+    given on the command line are then
+    looked up in the pool.
+*/
+
+#include "url_pool.hpp"
+#include <boost/url/parse.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace urls = boost::urls;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cout << argv[0] << "\n";
+        std::cout << "Usage: url_pool <input> <url>...\n"
+                     "options:\n"
+                     "    <input>:            File with one URL per line (required)\n"
+                     "    <url>:              URLs to look up in the pool (optional)\n"
+                     "examples:\n"
+                     "url_pool sitemap.txt\n"
+                     "url_pool sitemap.txt \"https://www.example.com/index.html\"\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream fin(argv[1]);
+    if (!fin)
+    {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // keep the valid lines only
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(fin, line))
+    {
+        if (urls::parse_uri_reference(line))
+            lines.push_back(std::move(line));
+    }
+
+    urls::url_pool pool(lines.begin(), lines.end());
+    std::cout <<
+        "urls:        " << pool.size()              << "\n"
+        "url bytes:   " << pool.url_bytes()         << "\n"
+        "pool bytes:  " << pool.memory_usage()      << "\n"
+        "ratio:       " << pool.compression_ratio() << "\n";
+
+    for (int i = 2; i < argc; ++i)
+    {
+        auto rv = urls::parse_uri_reference(argv[i]);
+        if (!rv)
+        {
+            std::cout << argv[i] << ": invalid\n";
+            continue;
+        }
+        auto it = pool.lower_bound(*rv);
+        if (it != pool.end() && (*it).compare(*rv) == 0)
+            std::cout << argv[i] << ": found at " << it.index() << "\n";
+        else if (it != pool.end())
+            std::cout << argv[i] << ": not found, next is " << *it << "\n";
+        else
+            std::cout << argv[i] << ": not found\n";
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//]
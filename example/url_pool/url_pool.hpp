@@ -0,0 +1,329 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_POOL_HPP
+#define BOOST_URL_URL_POOL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A compact, sorted and read-only pool of URLs
+
+    The URLs are sorted in the order of
+    `operator<` on @ref url_view_base, and
+    URLs which compare equal are stored once.
+    They are then front coded in blocks:
+    the first URL of each block is stored
+    whole, and every other URL is stored as
+    the length of the prefix it shares with
+    the previous one, followed by the rest
+    of its characters. Lists with long
+    common prefixes, such as crawl frontiers
+    or sitemaps, take a fraction of their
+    original size.
+
+    URLs are decompressed on demand into a
+    small buffer owned by an iterator or
+    provided by the caller, and iterating
+    the pool decodes each URL incrementally
+    from the previous one.
+
+    @par Example
+    @code
+    std::vector< core::string_view > v = {
+        "https://www.example.com/b",
+        "https://www.example.com/a",
+        "https://www.example.com/%61" };
+    url_pool p( v.begin(), v.end() );
+
+    assert( p.size() == 2 );
+    assert( p.contains( url_view( "https://www.example.com/b" ) ) );
+    @endcode
+
+    @par Exception Safety
+
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+*/
+class url_pool
+{
+public:
+    class iterator;
+
+    /// The type of iterator
+    using const_iterator = iterator;
+
+    /// The value type
+    using value_type = url_view;
+
+    /// The reference type
+    using reference = url_view;
+
+    /// @copydoc reference
+    using const_reference = url_view;
+
+    /// The unsigned integer type
+    using size_type = std::size_t;
+
+    /// The signed integer type
+    using difference_type = std::ptrdiff_t;
+
+    /// A value returned by @ref find when there is no match
+    static constexpr std::size_t npos =
+        std::size_t(-1);
+
+    /// The number of URLs in each block
+    static constexpr std::size_t block_size = 16;
+
+    /** Constructor
+
+        Default constructed pools are empty.
+    */
+    url_pool() noexcept = default;
+
+    /** Constructor
+
+        The pool holds a copy of the URLs in
+        the range, which are not modified.
+
+        @par Example
+        @code
+        std::vector< url > v = load_urls();
+        url_pool p( v.begin(), v.end() );
+        @endcode
+
+        @par Complexity
+        `n log n` comparisons, where `n` is
+        the number of URLs in the range.
+
+        @throw system_error
+        An element of the range is not a
+        valid URI reference.
+
+        @param first The first URL
+        @param last One past the last URL
+    */
+    template<class FwdIt>
+    url_pool(FwdIt first, FwdIt last)
+    {
+        std::vector<url_view> v;
+        v.reserve(static_cast<std::size_t>(
+            std::distance(first, last)));
+        for(; first != last; ++first)
+            v.emplace_back(*first);
+        build(v);
+    }
+
+    /// Return an iterator to the first URL
+    iterator
+    begin() const;
+
+    /// Return an iterator to the end
+    iterator
+    end() const noexcept;
+
+    /// Return true if the pool is empty
+    bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /// Return the number of URLs
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return the i-th URL
+
+        The returned view refers to `scratch`,
+        and remains valid until it is modified.
+
+        @par Complexity
+        Linear in @ref block_size.
+
+        @param i The index of the URL
+        @param scratch The buffer where the URL
+        is decompressed
+    */
+    url_view
+    get(
+        std::size_t i,
+        std::string& scratch) const;
+
+    /** Return the index of a URL
+
+        @par Complexity
+        Logarithmic in @ref size.
+
+        @return The index of the URL which
+        compares equal to `u`, or @ref npos
+        if there is none.
+
+        @param u The URL to find
+    */
+    std::size_t
+    find(url_view_base const& u) const;
+
+    /// Return true if a URL compares equal to `u`
+    bool
+    contains(url_view_base const& u) const
+    {
+        return find(u) != npos;
+    }
+
+    /** Return an iterator to the first URL not less than `u`
+
+        @par Complexity
+        Logarithmic in @ref size.
+
+        @param u The URL to compare
+    */
+    iterator
+    lower_bound(url_view_base const& u) const;
+
+    /// Return the size of the URLs if stored whole
+    std::size_t
+    url_bytes() const noexcept
+    {
+        return url_bytes_;
+    }
+
+    /// Return the memory used by the pool
+    std::size_t
+    memory_usage() const noexcept
+    {
+        return
+            data_.capacity() +
+            blocks_.capacity() * sizeof(blocks_[0]);
+    }
+
+    /** Return the compression ratio
+
+        This is the size of the URLs divided
+        by the size of the compressed pool,
+        including the block index.
+    */
+    double
+    compression_ratio() const noexcept;
+
+private:
+    void
+    build(std::vector<url_view>& v);
+
+    // index of the last block whose
+    // first url is not greater than u
+    std::size_t
+    find_block(
+        url_view_base const& u,
+        std::string& scratch) const;
+
+    // decode the url at offset pos into
+    // scratch, which holds the previous
+    // url, and return the next offset
+    std::size_t
+    decode(
+        std::size_t pos,
+        bool head,
+        std::string& scratch) const;
+
+    std::string data_;
+    std::vector<std::size_t> blocks_;
+    std::size_t size_ = 0;
+    std::size_t url_bytes_ = 0;
+};
+
+//------------------------------------------------
+
+/** An iterator to the URLs of a url_pool
+
+    Each iterator owns the buffer where the
+    current URL is decompressed. The view
+    returned by `operator*` is invalidated
+    when the iterator is modified or
+    destroyed.
+*/
+class url_pool::iterator
+{
+    url_pool const* p_ = nullptr;
+    std::size_t i_ = 0;
+    std::size_t next_ = 0;
+    std::string buf_;
+
+    friend class url_pool;
+
+    iterator(
+        url_pool const* p,
+        std::size_t i);
+
+public:
+    using value_type = url_view;
+    using reference = url_view;
+    using pointer = reference;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    iterator() = default;
+
+    iterator&
+    operator++();
+
+    iterator
+    operator++(int)
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    reference
+    operator*() const;
+
+    // the return value is too expensive
+    pointer operator->() const = delete;
+
+    /// Return the index of the current URL
+    std::size_t
+    index() const noexcept
+    {
+        return i_;
+    }
+
+    bool
+    operator==(
+        iterator const& other) const noexcept
+    {
+        return i_ == other.i_;
+    }
+
+    bool
+    operator!=(
+        iterator const& other) const noexcept
+    {
+        return i_ != other.i_;
+    }
+};
+
+} // urls
+} // boost
+
+#endif
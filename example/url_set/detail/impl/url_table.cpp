@@ -0,0 +1,335 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include "../url_table.hpp"
+#include <boost/url/parse.hpp>
+#include <boost/url/detail/except.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+namespace {
+
+// strings are appended to chunks of at
+// least this size, so the allocation
+// cost is shared by many urls
+constexpr std::size_t chunk_size = 64 * 1024;
+
+constexpr std::size_t min_buckets = 16;
+
+} // (anon)
+
+constexpr std::size_t url_table::npos;
+
+url_table::
+url_table(
+    std::uint64_t k0,
+    std::uint64_t k1) noexcept
+    : k0_(k0)
+    , k1_(k1)
+{
+}
+
+url_table::
+url_table(url_table const& other)
+    : k0_(other.k0_)
+    , k1_(other.k1_)
+{
+    // the copy is compacted into
+    // as few chunks as possible
+    *this = other;
+}
+
+url_table::
+url_table(url_table&& other) noexcept
+    : k0_(other.k0_)
+    , k1_(other.k1_)
+    , entries_(std::move(other.entries_))
+    , slots_(std::move(other.slots_))
+    , chunks_(std::move(other.chunks_))
+    , arena_bytes_(other.arena_bytes_)
+    , url_bytes_(other.url_bytes_)
+    , pos_(other.pos_)
+    , avail_(other.avail_)
+{
+    other.clear();
+}
+
+url_table&
+url_table::
+operator=(url_table const& other)
+{
+    if(this == &other)
+        return *this;
+    url_table tmp(other.k0_, other.k1_);
+    tmp.entries_.reserve(other.size());
+    tmp.allocate(other.url_bytes_);
+    tmp.rehash(other.bucket_count());
+    for(auto const& e : other.entries_)
+        tmp.append({ e.data, e.size }, e.hash);
+    return *this = std::move(tmp);
+}
+
+url_table&
+url_table::
+operator=(url_table&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    k0_ = other.k0_;
+    k1_ = other.k1_;
+    entries_ = std::move(other.entries_);
+    slots_ = std::move(other.slots_);
+    chunks_ = std::move(other.chunks_);
+    arena_bytes_ = other.arena_bytes_;
+    url_bytes_ = other.url_bytes_;
+    pos_ = other.pos_;
+    avail_ = other.avail_;
+    other.clear();
+    return *this;
+}
+
+url_table::
+~url_table() = default;
+
+std::uint64_t
+url_table::
+hash(url_view_base const& u) const noexcept
+{
+    return u.digest128(k0_, k1_).first;
+}
+
+std::size_t
+url_table::
+probe(
+    url_view_base const& u,
+    std::uint64_t h) const noexcept
+{
+    BOOST_ASSERT(! slots_.empty());
+    std::size_t const mask = slots_.size() - 1;
+    std::uint32_t const tag =
+        static_cast<std::uint32_t>(h >> 32);
+    std::size_t i =
+        static_cast<std::size_t>(h) & mask;
+    for(;;)
+    {
+        slot const& s = slots_[i];
+        if(s.index == 0)
+            return i;
+        if(s.tag == tag)
+        {
+            entry const& e = entries_[s.index - 1];
+            // only urls with equal digests
+            // are parsed and compared
+            if(e.hash == h)
+            {
+                core::string_view const s(
+                    e.data, e.size);
+                if(s == u.buffer())
+                    return i;
+                auto rv = parse_uri_reference(s);
+                BOOST_ASSERT(rv.has_value());
+                if(rv->compare(u) == 0)
+                    return i;
+            }
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+std::size_t
+url_table::
+find(url_view_base const& u) const noexcept
+{
+    if(entries_.empty())
+        return npos;
+    std::size_t const i = probe(u, hash(u));
+    if(slots_[i].index == 0)
+        return npos;
+    return slots_[i].index - 1;
+}
+
+std::pair<std::size_t, bool>
+url_table::
+insert(url_view_base const& u)
+{
+    std::uint64_t const h = hash(u);
+    if(! entries_.empty())
+    {
+        std::size_t const i = probe(u, h);
+        if(slots_[i].index != 0)
+            return { slots_[i].index - 1, false };
+    }
+    append(u.buffer(), h);
+    return { entries_.size() - 1, true };
+}
+
+void
+url_table::
+append(
+    core::string_view s,
+    std::uint64_t h)
+{
+    if(entries_.size() >= 0xfffffffe)
+        detail::throw_length_error();
+
+    // grow first, so nothing changes
+    // if an allocation throws
+    if((entries_.size() + 1) * 4 >
+        slots_.size() * 3)
+        rehash(slots_.size() * 2);
+    if(entries_.size() == entries_.capacity())
+        entries_.reserve(entries_.empty() ?
+            min_buckets : entries_.size() * 2);
+    char* dest = allocate(s.size());
+
+    if(! s.empty())
+        std::memcpy(dest, s.data(), s.size());
+    pos_ += s.size();
+    avail_ -= s.size();
+    url_bytes_ += s.size();
+    entries_.push_back({ dest, s.size(), h });
+    place(entries_.size() - 1);
+}
+
+char*
+url_table::
+allocate(std::size_t n)
+{
+    if(n <= avail_)
+        return pos_;
+    std::size_t const size =
+        n > chunk_size ? n : chunk_size;
+    chunks_.reserve(chunks_.size() + 1);
+    chunks_.emplace_back(new char[size]);
+    arena_bytes_ += size;
+    pos_ = chunks_.back().get();
+    avail_ = size;
+    return pos_;
+}
+
+void
+url_table::
+place(std::size_t i) noexcept
+{
+    std::size_t const mask = slots_.size() - 1;
+    std::uint64_t const h = entries_[i].hash;
+    std::size_t j =
+        static_cast<std::size_t>(h) & mask;
+    while(slots_[j].index != 0)
+        j = (j + 1) & mask;
+    slots_[j].index =
+        static_cast<std::uint32_t>(i + 1);
+    slots_[j].tag =
+        static_cast<std::uint32_t>(h >> 32);
+}
+
+void
+url_table::
+pop_back() noexcept
+{
+    BOOST_ASSERT(! entries_.empty());
+    entry const& e = entries_.back();
+
+    // the last entry ends every probe
+    // sequence it is part of, so its
+    // slot can simply be emptied
+    std::size_t const mask = slots_.size() - 1;
+    std::size_t j =
+        static_cast<std::size_t>(e.hash) & mask;
+    while(slots_[j].index != entries_.size())
+        j = (j + 1) & mask;
+    slots_[j] = {};
+
+    if(e.data + e.size == pos_)
+    {
+        pos_ -= e.size;
+        avail_ += e.size;
+    }
+    url_bytes_ -= e.size;
+    entries_.pop_back();
+}
+
+void
+url_table::
+clear() noexcept
+{
+    std::vector<entry>().swap(entries_);
+    std::vector<slot>().swap(slots_);
+    std::vector<std::unique_ptr<
+        char[]>>().swap(chunks_);
+    arena_bytes_ = 0;
+    url_bytes_ = 0;
+    pos_ = nullptr;
+    avail_ = 0;
+}
+
+void
+url_table::
+reserve(std::size_t n)
+{
+    entries_.reserve(n);
+    rehash((n * 4 + 2) / 3);
+}
+
+void
+url_table::
+rehash(std::size_t n)
+{
+    // keep the load factor at or
+    // below three quarters
+    std::size_t const needed =
+        (entries_.size() * 4 + 2) / 3;
+    if(n < needed)
+        n = needed;
+    std::size_t size = min_buckets;
+    while(size < n)
+        size *= 2;
+    if(size == slots_.size())
+        return;
+
+    // the cached digests are reused,
+    // urls are not hashed again
+    std::vector<slot> v(size, slot{});
+    slots_.swap(v);
+    for(std::size_t i = 0;
+        i < entries_.size(); ++i)
+        place(i);
+}
+
+float
+url_table::
+load_factor() const noexcept
+{
+    if(slots_.empty())
+        return 0;
+    return static_cast<float>(entries_.size()) /
+        static_cast<float>(slots_.size());
+}
+
+url_storage_stats
+url_table::
+stats() const noexcept
+{
+    url_storage_stats st;
+    st.count = entries_.size();
+    st.url_bytes = url_bytes_;
+    st.arena_bytes = arena_bytes_ +
+        chunks_.capacity() * sizeof(chunks_[0]);
+    st.index_bytes =
+        entries_.capacity() * sizeof(entry) +
+        slots_.capacity() * sizeof(slot);
+    return st;
+}
+
+} // detail
+} // urls
+} // boost
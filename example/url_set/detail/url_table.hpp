@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_DETAIL_URL_TABLE_HPP
+#define BOOST_URL_DETAIL_URL_TABLE_HPP
+
+#include "../url_storage_stats.hpp"
+#include <boost/url/url_view_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// An open addressing table of URLs which
+// are equal when they compare equal. The
+// strings are appended to an arena of
+// large chunks and each entry caches the
+// digest of its URL, so probes and
+// rehashing never renormalize a stored
+// URL unless the digests are equal.
+class url_table
+{
+public:
+    static constexpr std::size_t npos =
+        std::size_t(-1);
+
+    explicit
+    url_table(
+        std::uint64_t k0 = 0,
+        std::uint64_t k1 = 0) noexcept;
+
+    url_table(url_table const& other);
+
+    url_table(url_table&& other) noexcept;
+
+    url_table&
+    operator=(url_table const& other);
+
+    url_table&
+    operator=(url_table&& other) noexcept;
+
+    ~url_table();
+
+    std::size_t
+    size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    // the string of the i-th inserted url
+    core::string_view
+    get(std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(i < entries_.size());
+        return { entries_[i].data,
+            entries_[i].size };
+    }
+
+    // the index of the url equal to u,
+    // or npos
+    std::size_t
+    find(url_view_base const& u) const noexcept;
+
+    // insert u if it is not present and
+    // return its index and whether it
+    // was inserted
+    std::pair<std::size_t, bool>
+    insert(url_view_base const& u);
+
+    // remove the last inserted url
+    void
+    pop_back() noexcept;
+
+    void
+    clear() noexcept;
+
+    void
+    reserve(std::size_t n);
+
+    void
+    rehash(std::size_t n);
+
+    std::size_t
+    bucket_count() const noexcept
+    {
+        return slots_.size();
+    }
+
+    float
+    load_factor() const noexcept;
+
+    url_storage_stats
+    stats() const noexcept;
+
+private:
+    struct entry
+    {
+        char const* data;
+        std::size_t size;
+        std::uint64_t hash;
+    };
+
+    // index is the entry number plus
+    // one, so zero marks an empty slot,
+    // and tag holds the high bits of
+    // the hash to skip most entries
+    struct slot
+    {
+        std::uint32_t index;
+        std::uint32_t tag;
+    };
+
+    std::uint64_t
+    hash(url_view_base const& u) const noexcept;
+
+    std::size_t
+    probe(
+        url_view_base const& u,
+        std::uint64_t h) const noexcept;
+
+    void
+    append(
+        core::string_view s,
+        std::uint64_t h);
+
+    char*
+    allocate(std::size_t n);
+
+    void
+    place(std::size_t i) noexcept;
+
+    std::uint64_t k0_;
+    std::uint64_t k1_;
+    std::vector<entry> entries_;
+    std::vector<slot> slots_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::size_t arena_bytes_ = 0;
+    std::size_t url_bytes_ = 0;
+    char* pos_ = nullptr;
+    std::size_t avail_ = 0;
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_MAP_HPP
+#define BOOST_URL_IMPL_URL_MAP_HPP
+
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+
+template<class T>
+template<bool IsConst>
+class url_map<T>::basic_iterator
+{
+    using map_type = typename std::conditional<
+        IsConst, url_map const, url_map>::type;
+    using value_ref = typename std::conditional<
+        IsConst, T const&, T&>::type;
+
+    map_type* m_ = nullptr;
+    std::size_t i_ = 0;
+
+    friend class url_map;
+
+    template<bool>
+    friend class basic_iterator;
+
+    basic_iterator(
+        map_type* m,
+        std::size_t i) noexcept
+        : m_(m)
+        , i_(i)
+    {
+    }
+
+public:
+    using value_type = std::pair<url_view, T>;
+    using reference = std::pair<url_view, value_ref>;
+    using pointer = reference;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::bidirectional_iterator_tag;
+
+    basic_iterator() = default;
+
+    template<
+        bool IsConst_ = IsConst,
+        class = typename std::enable_if<
+            IsConst_>::type>
+    basic_iterator(
+        basic_iterator<false> const& other) noexcept
+        : m_(other.m_)
+        , i_(other.i_)
+    {
+    }
+
+    basic_iterator&
+    operator++() noexcept
+    {
+        ++i_;
+        return *this;
+    }
+
+    basic_iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    basic_iterator&
+    operator--() noexcept
+    {
+        --i_;
+        return *this;
+    }
+
+    basic_iterator
+    operator--(int) noexcept
+    {
+        auto tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    reference
+    operator*() const
+    {
+        return { url_view(m_->get(i_)),
+            m_->values_[i_] };
+    }
+
+    // the return value is too expensive
+    pointer operator->() const = delete;
+
+    bool
+    operator==(
+        basic_iterator const& other) const noexcept
+    {
+        return i_ == other.i_;
+    }
+
+    bool
+    operator!=(
+        basic_iterator const& other) const noexcept
+    {
+        return i_ != other.i_;
+    }
+};
+
+template<class T>
+template<class... Args>
+auto
+url_map<T>::
+emplace(
+    url_view_base const& u,
+    Args&&... args) ->
+        std::pair<T*, bool>
+{
+    auto r = url_table::insert(u);
+    if(! r.second)
+        return { &values_[r.first], false };
+    BOOST_ASSERT(r.first == values_.size());
+    try
+    {
+        values_.emplace_back(
+            std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+        url_table::pop_back();
+        throw;
+    }
+    return { &values_.back(), true };
+}
+
+template<class T>
+T*
+url_map<T>::
+find(url_view_base const& u) noexcept
+{
+    std::size_t const i = url_table::find(u);
+    if(i == npos)
+        return nullptr;
+    return &values_[i];
+}
+
+template<class T>
+T const*
+url_map<T>::
+find(url_view_base const& u) const noexcept
+{
+    std::size_t const i = url_table::find(u);
+    if(i == npos)
+        return nullptr;
+    return &values_[i];
+}
+
+} // urls
+} // boost
+
+#endif
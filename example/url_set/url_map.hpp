@@ -0,0 +1,314 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_MAP_HPP
+#define BOOST_URL_URL_MAP_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_view.hpp>
+#include "detail/url_table.hpp"
+#include "url_storage_stats.hpp"
+#include <iterator>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A map from URLs which compare equal when normalized
+
+    Two URLs are the same key when
+    @ref url_view_base::compare returns
+    zero. The first spelling inserted is
+    the one which is kept.
+
+    The strings of all keys are stored
+    contiguously in large chunks and the
+    values are stored in a single array,
+    both in insertion order. Each key
+    caches the keyed digest of its
+    normalized URL, so the URLs are only
+    compared when the digests are equal.
+
+    @par Example
+    @code
+    url_map< int > m;
+    m[ url_view( "HTTP://www.example.com/%7euser" ) ] = 1;
+
+    assert( *m.find( url_view( "http://www.example.com/~user" ) ) == 1 );
+    @endcode
+
+    @par Exception Safety
+
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+
+    @tparam T The type of the mapped values
+
+    @see
+        @ref url_set,
+        @ref url_view_base::digest128.
+*/
+template<class T>
+class url_map
+    : private detail::url_table
+{
+    std::vector<T> values_;
+
+    template<bool IsConst>
+    class basic_iterator;
+
+public:
+    /// The type of iterator
+    using iterator = basic_iterator<false>;
+
+    /// The type of const iterator
+    using const_iterator = basic_iterator<true>;
+
+    /// The type of keys
+    using key_type = url_view;
+
+    /// The type of mapped values
+    using mapped_type = T;
+
+    /// The reference type
+    using reference = std::pair<url_view, T&>;
+
+    /// The const reference type
+    using const_reference = std::pair<url_view, T const&>;
+
+    /// The unsigned integer type
+    using size_type = std::size_t;
+
+    /// The signed integer type
+    using difference_type = std::ptrdiff_t;
+
+    /** Constructor
+
+        @param k0 The first half of the key
+        of the digest
+        @param k1 The second half of the key
+        of the digest
+
+        @see
+            @ref url_set::url_set.
+    */
+    explicit
+    url_map(
+        std::uint64_t k0 = 0,
+        std::uint64_t k1 = 0) noexcept
+        : url_table(k0, k1)
+    {
+    }
+
+    /// Constructor
+    url_map(url_map const&) = default;
+
+    /// Constructor
+    url_map(url_map&&) noexcept = default;
+
+    /// Assignment
+    url_map& operator=(url_map const&) = default;
+
+    /// Assignment
+    url_map& operator=(url_map&&) noexcept = default;
+
+    /// Return an iterator to the first element
+    iterator
+    begin() noexcept
+    {
+        return { this, 0 };
+    }
+
+    /// @copydoc begin
+    const_iterator
+    begin() const noexcept
+    {
+        return { this, 0 };
+    }
+
+    /// Return an iterator to the end
+    iterator
+    end() noexcept
+    {
+        return { this, size() };
+    }
+
+    /// @copydoc end
+    const_iterator
+    end() const noexcept
+    {
+        return { this, size() };
+    }
+
+    /// Return true if the map is empty
+    bool
+    empty() const noexcept
+    {
+        return values_.empty();
+    }
+
+    /// Return the number of elements
+    std::size_t
+    size() const noexcept
+    {
+        return values_.size();
+    }
+
+    /** Insert an element constructed in-place
+
+        If a key which compares equal to `u`
+        is already present, the map is not
+        modified and no value is constructed.
+
+        @par Complexity
+        Linear in `u.size()` on average.
+
+        @return A pointer to the value of the
+        key equal to `u`, and `true` if it
+        was inserted.
+
+        @param u The key
+        @param args The arguments used to
+        construct the value
+    */
+    template<class... Args>
+    std::pair<T*, bool>
+    emplace(
+        url_view_base const& u,
+        Args&&... args);
+
+    /** Insert an element
+
+        @see
+            @ref emplace.
+    */
+    std::pair<T*, bool>
+    insert(
+        url_view_base const& u,
+        T const& v)
+    {
+        return emplace(u, v);
+    }
+
+    /// @copydoc insert
+    std::pair<T*, bool>
+    insert(
+        url_view_base const& u,
+        T&& v)
+    {
+        return emplace(u, std::move(v));
+    }
+
+    /** Return the value of a key, inserting it if needed
+
+        If no key compares equal to `u`, an
+        element with a value-initialized `T`
+        is inserted.
+
+        @param u The key
+    */
+    T&
+    operator[](url_view_base const& u)
+    {
+        return *emplace(u).first;
+    }
+
+    /** Find the value of a key
+
+        @par Complexity
+        Linear in `u.size()` on average.
+
+        @return A pointer to the value of the
+        key which compares equal to `u`, or
+        `nullptr` if there is none.
+
+        @param u The key
+    */
+    T*
+    find(url_view_base const& u) noexcept;
+
+    /// @copydoc find
+    T const*
+    find(url_view_base const& u) const noexcept;
+
+    /// Return true if a key compares equal to `u`
+    bool
+    contains(url_view_base const& u) const noexcept
+    {
+        return url_table::find(u) != npos;
+    }
+
+    /** Remove all elements
+
+        All memory is released.
+    */
+    void
+    clear() noexcept
+    {
+        url_table::clear();
+        values_.clear();
+        values_.shrink_to_fit();
+    }
+
+    /** Reserve space for elements
+
+        @see
+            @ref url_set::reserve.
+    */
+    void
+    reserve(std::size_t n)
+    {
+        url_table::reserve(n);
+        values_.reserve(n);
+    }
+
+    /** Change the number of buckets
+
+        @see
+            @ref url_set::rehash.
+    */
+    void
+    rehash(std::size_t n)
+    {
+        url_table::rehash(n);
+    }
+
+    /// Return the number of buckets
+    std::size_t
+    bucket_count() const noexcept
+    {
+        return url_table::bucket_count();
+    }
+
+    /// Return the average number of elements per bucket
+    float
+    load_factor() const noexcept
+    {
+        return url_table::load_factor();
+    }
+
+    /// Return the memory used by the map
+    url_storage_stats
+    memory_usage() const noexcept
+    {
+        url_storage_stats st = url_table::stats();
+        st.value_bytes = values_.capacity() * sizeof(T);
+        return st;
+    }
+};
+
+} // urls
+} // boost
+
+#include "impl/url_map.hpp"
+
+#endif
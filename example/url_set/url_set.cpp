@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2022 alandefreitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+//
+
+//[example_url_set
+
+/*
+    This example removes the duplicates from
+    a list of URLs, where two URLs are the
+    same if they are equivalent once
+    normalized.
+
+    The unique URLs are kept in a url_set,
+    which stores their strings contiguously
+    and caches their digests.
+*/
+
+#include "url_set.hpp"
+#include <boost/url/parse.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace urls = boost::urls;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cout << argv[0] << "\n";
+        std::cout << "Usage: url_set <input> <output>\n"
+                     "options:\n"
+                     "    <input>:            File with one URL per line (required)\n"
+                     "    <output>:           File where the unique URLs are written (optional)\n"
+                     "examples:\n"
+                     "url_set urls.txt\n"
+                     "url_set urls.txt unique.txt\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream fin(argv[1]);
+    if (!fin)
+    {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    urls::url_set s;
+    std::size_t lines = 0;
+    std::size_t invalid = 0;
+    std::string line;
+    while (std::getline(fin, line))
+    {
+        ++lines;
+        auto rv = urls::parse_uri_reference(line);
+        if (!rv)
+        {
+            ++invalid;
+            continue;
+        }
+        s.insert(*rv);
+    }
+
+    if (argc > 2)
+    {
+        std::ofstream fout(argv[2]);
+        for (urls::url_view u: s)
+            fout << u << "\n";
+        if (!fout)
+        {
+            std::cerr << "Cannot write " << argv[2] << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    urls::url_storage_stats st = s.memory_usage();
+    std::cout <<
+        "lines:       " << lines          << "\n"
+        "invalid:     " << invalid        << "\n"
+        "unique:      " << s.size()       << "\n"
+        "url bytes:   " << st.url_bytes   << "\n"
+        "arena bytes: " << st.arena_bytes << "\n"
+        "index bytes: " << st.index_bytes << "\n"
+        "load factor: " << s.load_factor() << "\n";
+
+    return EXIT_SUCCESS;
+}
+
+//]
@@ -0,0 +1,377 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_SET_HPP
+#define BOOST_URL_URL_SET_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_view.hpp>
+#include "detail/url_table.hpp"
+#include "url_storage_stats.hpp"
+#include <iterator>
+
+namespace boost {
+namespace urls {
+
+/** A set of URLs which compare equal when normalized
+
+    Two URLs are the same element when
+    @ref url_view_base::compare returns
+    zero, so `HTTP://Example.com/%7e` and
+    `http://example.com/~` are one element.
+    The first spelling inserted is the one
+    which is kept.
+
+    Unlike a standard container of @ref url,
+    the strings of all elements are stored
+    contiguously in large chunks, which
+    avoids one allocation per element. Each
+    element caches the keyed digest of its
+    normalized URL, so the URLs are only
+    compared when the digests are equal,
+    and rehashing never reads the URLs.
+
+    Elements are never moved in memory, and
+    views of them remain valid until the
+    set is cleared or destroyed.
+
+    @par Example
+    @code
+    url_set s;
+    s.insert( url_view( "HTTP://www.example.com/%7euser" ) );
+
+    assert( s.contains( url_view( "http://www.example.com/~user" ) ) );
+    assert( s.size() == 1 );
+    @endcode
+
+    @par Exception Safety
+
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+
+    @see
+        @ref url_map,
+        @ref url_view_base::digest128.
+*/
+class url_set
+    : private detail::url_table
+{
+public:
+    class iterator;
+
+    /// The type of iterator
+    using const_iterator = iterator;
+
+    /// The value type
+    using value_type = url_view;
+
+    /// The reference type
+    using reference = url_view;
+
+    /// @copydoc reference
+    using const_reference = url_view;
+
+    /// The unsigned integer type
+    using size_type = std::size_t;
+
+    /// The signed integer type
+    using difference_type = std::ptrdiff_t;
+
+    /** Constructor
+
+        The key of the digest can be chosen
+        to make the layout of the table
+        unpredictable, which protects it
+        from inputs which collide on purpose.
+
+        @param k0 The first half of the key
+        @param k1 The second half of the key
+    */
+    explicit
+    url_set(
+        std::uint64_t k0 = 0,
+        std::uint64_t k1 = 0) noexcept
+        : url_table(k0, k1)
+    {
+    }
+
+    /** Constructor
+
+        The copy stores its strings in as few
+        chunks as possible.
+    */
+    url_set(url_set const&) = default;
+
+    /// Constructor
+    url_set(url_set&&) noexcept = default;
+
+    /// Assignment
+    url_set& operator=(url_set const&) = default;
+
+    /// Assignment
+    url_set& operator=(url_set&&) noexcept = default;
+
+    /// Return an iterator to the first element
+    iterator
+    begin() const noexcept;
+
+    /// Return an iterator to the end
+    iterator
+    end() const noexcept;
+
+    /// Return true if the set is empty
+    bool
+    empty() const noexcept
+    {
+        return url_table::size() == 0;
+    }
+
+    /// Return the number of elements
+    std::size_t
+    size() const noexcept
+    {
+        return url_table::size();
+    }
+
+    /** Insert a URL
+
+        If an element which compares equal
+        to `u` is already present, the set
+        is not modified.
+
+        @par Complexity
+        Linear in `u.size()` on average.
+
+        @return An iterator to the element
+        equal to `u`, and `true` if it was
+        inserted.
+
+        @param u The URL to insert
+    */
+    std::pair<iterator, bool>
+    insert(url_view_base const& u);
+
+    /** Find a URL
+
+        @par Complexity
+        Linear in `u.size()` on average.
+
+        @return An iterator to the element
+        which compares equal to `u`, or
+        @ref end if there is none.
+
+        @param u The URL to find
+    */
+    iterator
+    find(url_view_base const& u) const noexcept;
+
+    /// Return true if an element compares equal to `u`
+    bool
+    contains(url_view_base const& u) const noexcept
+    {
+        return url_table::find(u) != npos;
+    }
+
+    /// Return the number of elements which compare equal to `u`
+    std::size_t
+    count(url_view_base const& u) const noexcept
+    {
+        return contains(u);
+    }
+
+    /** Remove all elements
+
+        All memory is released.
+    */
+    void
+    clear() noexcept
+    {
+        url_table::clear();
+    }
+
+    /** Reserve space for elements
+
+        After this call, `n` elements can be
+        inserted without rehashing the table.
+
+        @param n The number of elements
+    */
+    void
+    reserve(std::size_t n)
+    {
+        url_table::reserve(n);
+    }
+
+    /** Change the number of buckets
+
+        The number of buckets becomes a power
+        of two, no less than `n`, and large
+        enough to keep the load factor at or
+        below `0.75`. The cached digests are
+        used, and no URL is hashed again.
+
+        @param n The minimum number of buckets
+    */
+    void
+    rehash(std::size_t n)
+    {
+        url_table::rehash(n);
+    }
+
+    /// Return the number of buckets
+    std::size_t
+    bucket_count() const noexcept
+    {
+        return url_table::bucket_count();
+    }
+
+    /// Return the average number of elements per bucket
+    float
+    load_factor() const noexcept
+    {
+        return url_table::load_factor();
+    }
+
+    /// Return the memory used by the set
+    url_storage_stats
+    memory_usage() const noexcept
+    {
+        return url_table::stats();
+    }
+};
+
+//------------------------------------------------
+
+/** An iterator to the elements of a url_set
+
+    Elements are visited in the order in
+    which they were inserted.
+*/
+class url_set::iterator
+{
+    detail::url_table const* t_ = nullptr;
+    std::size_t i_ = 0;
+
+    friend class url_set;
+
+    iterator(
+        detail::url_table const* t,
+        std::size_t i) noexcept
+        : t_(t)
+        , i_(i)
+    {
+    }
+
+public:
+    using value_type = url_view;
+    using reference = url_view;
+    using pointer = reference;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::bidirectional_iterator_tag;
+
+    iterator() = default;
+
+    iterator&
+    operator++() noexcept
+    {
+        ++i_;
+        return *this;
+    }
+
+    iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    iterator&
+    operator--() noexcept
+    {
+        --i_;
+        return *this;
+    }
+
+    iterator
+    operator--(int) noexcept
+    {
+        auto tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    reference
+    operator*() const
+    {
+        return url_view(t_->get(i_));
+    }
+
+    // the return value is too expensive
+    pointer operator->() const = delete;
+
+    bool
+    operator==(
+        iterator const& other) const noexcept
+    {
+        return i_ == other.i_;
+    }
+
+    bool
+    operator!=(
+        iterator const& other) const noexcept
+    {
+        return i_ != other.i_;
+    }
+};
+
+inline
+url_set::iterator
+url_set::
+begin() const noexcept
+{
+    return { this, 0 };
+}
+
+inline
+url_set::iterator
+url_set::
+end() const noexcept
+{
+    return { this, url_table::size() };
+}
+
+inline
+std::pair<url_set::iterator, bool>
+url_set::
+insert(url_view_base const& u)
+{
+    auto r = url_table::insert(u);
+    return { { this, r.first }, r.second };
+}
+
+inline
+url_set::iterator
+url_set::
+find(url_view_base const& u) const noexcept
+{
+    std::size_t const i = url_table::find(u);
+    if(i == npos)
+        return end();
+    return { this, i };
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_STORAGE_STATS_HPP
+#define BOOST_URL_URL_STORAGE_STATS_HPP
+
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** Memory used by a container of URLs
+
+    All sizes are in bytes and count
+    memory which was allocated, whether
+    or not it is currently in use.
+*/
+struct url_storage_stats
+{
+    /// The number of URLs
+    std::size_t count = 0;
+
+    /// The size of the URL strings
+    std::size_t url_bytes = 0;
+
+    /// The memory holding the URL strings
+    std::size_t arena_bytes = 0;
+
+    /// The memory of the index
+    std::size_t index_bytes = 0;
+
+    /// The memory of the mapped values
+    std::size_t value_bytes = 0;
+
+    /// Return the total memory
+    std::size_t
+    total() const noexcept
+    {
+        return
+            arena_bytes +
+            index_bytes +
+            value_bytes;
+    }
+};
+
+} // urls
+} // boost
+
+#endif
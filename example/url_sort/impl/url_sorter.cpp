@@ -0,0 +1,435 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include "../url_sorter.hpp"
+#include <boost/url/parse.hpp>
+#include <boost/url/detail/except.hpp>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <random>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+/*  Runs
+
+    A run is a file with one normalized url
+    on each line, sorted and without
+    duplicates. Urls never contain a
+    newline, so no escaping is needed.
+*/
+
+// memory used by each url of a chunk
+// besides its characters: the offset,
+// the parsed view and the sort index
+constexpr std::size_t url_overhead =
+    2 * sizeof(std::size_t) + sizeof(url_view);
+
+constexpr std::size_t min_buffer = 4 * 1024;
+constexpr std::size_t max_buffer = 1024 * 1024;
+
+void
+write_line(
+    std::FILE* f,
+    core::string_view s)
+{
+    if( std::fwrite(s.data(), 1, s.size(), f) != s.size() ||
+        std::fputc('\n', f) == EOF)
+        detail::throw_errc(
+            system::errc::io_error);
+}
+
+} // (anon)
+
+struct url_sorter::run
+{
+    std::FILE* f = nullptr;
+    std::string path;
+
+    ~run()
+    {
+        if(f)
+            std::fclose(f);
+        if(! path.empty())
+            std::remove(path.c_str());
+    }
+};
+
+struct url_sorter::chunk
+{
+    // each url is followed by '\n'
+    std::string data;
+    std::vector<std::size_t> offsets;
+};
+
+// reads the urls of a run, one at a time
+class url_sorter::reader
+{
+    std::FILE* f_;
+    std::string buf_;
+    std::size_t pos_ = 0;
+    std::size_t end_ = 0;
+    std::string line_;
+
+public:
+    // the current url
+    url_view u;
+
+    reader(
+        run& r,
+        std::size_t buffer_size)
+        : f_(r.f)
+        , buf_(buffer_size, '\0')
+    {
+        std::rewind(f_);
+    }
+
+    reader(reader const&) = delete;
+
+    bool
+    next()
+    {
+        line_.clear();
+        for(;;)
+        {
+            if(pos_ == end_)
+            {
+                pos_ = 0;
+                end_ = std::fread(
+                    &buf_[0], 1, buf_.size(), f_);
+                if(end_ == 0)
+                {
+                    if(std::ferror(f_))
+                        detail::throw_errc(
+                            system::errc::io_error);
+                    BOOST_ASSERT(line_.empty());
+                    return false;
+                }
+            }
+            auto const p = buf_.data() + pos_;
+            auto const n = end_ - pos_;
+            auto const nl = static_cast<char const*>(
+                std::memchr(p, '\n', n));
+            if(! nl)
+            {
+                line_.append(p, n);
+                pos_ = end_;
+                continue;
+            }
+            line_.append(p, nl - p);
+            pos_ += nl - p + 1;
+            // runs only hold valid urls
+            u = parse_uri_reference(
+                line_).value();
+            return true;
+        }
+    }
+};
+
+//------------------------------------------------
+
+url_sorter::
+url_sorter(options const& opt)
+    : opt_(opt)
+    , chunk_(new chunk)
+{
+    if(opt_.threads == 0)
+        opt_.threads = 1;
+    if(opt_.fan_in < 2)
+        opt_.fan_in = 2;
+    // one chunk is collected while
+    // the others are sorted
+    chunk_size_ = (std::max)(min_buffer,
+        opt_.memory / (opt_.threads + 1));
+    if(! opt_.temp_dir.empty())
+    {
+        // names of files from other
+        // sorters do not collide
+        std::random_device rd;
+        tag_ = std::to_string(rd());
+    }
+}
+
+url_sorter::
+~url_sorter()
+{
+    for(auto& p : pending_)
+    {
+        if(p.valid())
+            p.wait();
+    }
+}
+
+bool
+url_sorter::
+push(core::string_view s)
+{
+    auto rv = parse_uri_reference(s);
+    if(! rv)
+    {
+        ++invalid_;
+        return false;
+    }
+    u_ = *rv;
+    u_.normalize();
+    auto const n = u_.size() + 1;
+    auto& c = *chunk_;
+    if( ! c.offsets.empty() &&
+        c.data.size() + n +
+            (c.offsets.size() + 1) * url_overhead >
+                chunk_size_)
+    {
+        spill();
+    }
+
+    // grow up to the size of a chunk
+    // rather than doubling past it
+    auto& d = chunk_->data;
+    if(d.size() + n > d.capacity())
+        d.reserve((std::max)(d.size() + n,
+            (std::min)(2 * d.capacity(),
+                chunk_size_)));
+    chunk_->offsets.push_back(d.size());
+    d.append(u_.data(), u_.size());
+    d.push_back('\n');
+    ++size_;
+    return true;
+}
+
+std::size_t
+url_sorter::
+finish(std::function<void(url_view)> const& f)
+{
+    std::size_t n = 0;
+    if( runs_.empty() &&
+        pending_.empty())
+    {
+        // everything fits in memory
+        std::vector<url_view> v;
+        auto const idx =
+            sort_chunk(*chunk_, v);
+        url_view const* prev = nullptr;
+        for(auto i : idx)
+        {
+            if( prev &&
+                prev->compare(v[i]) == 0)
+                continue;
+            f(v[i]);
+            prev = &v[i];
+            ++n;
+        }
+        chunk_.reset(new chunk);
+        return n;
+    }
+
+    spill();
+    while(! pending_.empty())
+        wait_one();
+    while(runs_.size() > opt_.fan_in)
+    {
+        std::vector<std::unique_ptr<run>> group(
+            std::make_move_iterator(runs_.begin()),
+            std::make_move_iterator(
+                runs_.begin() + opt_.fan_in));
+        runs_.erase(runs_.begin(),
+            runs_.begin() + opt_.fan_in);
+        std::size_t unused = 0;
+        runs_.push_back(
+            merge(group, nullptr, unused));
+    }
+    merge(runs_, &f, n);
+    return n;
+}
+
+//------------------------------------------------
+
+void
+url_sorter::
+spill()
+{
+    if(chunk_->offsets.empty())
+        return;
+    if(pending_.size() >= opt_.threads)
+        wait_one();
+    auto r = make_run();
+    std::unique_ptr<chunk> c(new chunk);
+    std::swap(c, chunk_);
+    pending_.push_back(std::async(
+        std::launch::async,
+        &url_sorter::sort_run,
+        std::move(c), std::move(r)));
+}
+
+void
+url_sorter::
+wait_one()
+{
+    auto p = std::move(pending_.front());
+    pending_.erase(pending_.begin());
+    runs_.push_back(p.get());
+    ++nruns_;
+}
+
+std::unique_ptr<url_sorter::run>
+url_sorter::
+make_run()
+{
+    std::unique_ptr<run> r(new run);
+    if(opt_.temp_dir.empty())
+    {
+        r->f = std::tmpfile();
+    }
+    else
+    {
+        r->path = opt_.temp_dir +
+            "/url_sort_" + tag_ + "_" +
+            std::to_string(nfiles_++) + ".run";
+        r->f = std::fopen(
+            r->path.c_str(), "w+b");
+        if(! r->f)
+            r->path.clear();
+    }
+    if(! r->f)
+        detail::throw_errc(
+            system::errc::io_error);
+    return r;
+}
+
+std::vector<std::size_t>
+url_sorter::
+sort_chunk(
+    chunk& c,
+    std::vector<url_view>& v)
+{
+    auto const n = c.offsets.size();
+    v.reserve(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const first = c.offsets[i];
+        auto const last = i + 1 < n ?
+            c.offsets[i + 1] : c.data.size();
+        // normalized urls are valid
+        v.push_back(parse_uri_reference(
+            core::string_view(
+                c.data.data() + first,
+                last - first - 1)).value());
+    }
+
+    // sorting indexes moves
+    // less than sorting views
+    std::vector<std::size_t> idx(
+        std::move(c.offsets));
+    std::iota(idx.begin(), idx.end(), 0);
+    std::sort(idx.begin(), idx.end(),
+        [&v](std::size_t a, std::size_t b)
+        {
+            return v[a].compare(v[b]) < 0;
+        });
+    return idx;
+}
+
+std::unique_ptr<url_sorter::run>
+url_sorter::
+sort_run(
+    std::unique_ptr<chunk> c,
+    std::unique_ptr<run> r)
+{
+    std::vector<url_view> v;
+    auto const idx = sort_chunk(*c, v);
+    url_view const* prev = nullptr;
+    for(auto i : idx)
+    {
+        if( prev &&
+            prev->compare(v[i]) == 0)
+            continue;
+        write_line(r->f, v[i].buffer());
+        prev = &v[i];
+    }
+    if(std::fflush(r->f) != 0)
+        detail::throw_errc(
+            system::errc::io_error);
+    return r;
+}
+
+std::unique_ptr<url_sorter::run>
+url_sorter::
+merge(
+    std::vector<std::unique_ptr<run>>& runs,
+    std::function<void(url_view)> const* f,
+    std::size_t& n)
+{
+    std::unique_ptr<run> out;
+    if(! f)
+        out = make_run();
+
+    // the budget is shared by the buffers
+    // of the runs and of the output
+    auto const buffer_size = (std::min)(max_buffer,
+        (std::max)(min_buffer,
+            opt_.memory / (runs.size() + 1)));
+    // readers are never moved, since
+    // their views refer to their lines
+    std::deque<reader> rd;
+    for(auto& r : runs)
+        rd.emplace_back(*r, buffer_size);
+
+    auto const greater =
+        [&rd](std::size_t a, std::size_t b)
+        {
+            return rd[a].u.compare(rd[b].u) > 0;
+        };
+    std::priority_queue<
+        std::size_t,
+        std::vector<std::size_t>,
+        decltype(greater)> q(greater);
+    for(std::size_t i = 0; i < rd.size(); ++i)
+    {
+        if(rd[i].next())
+            q.push(i);
+    }
+
+    // runs have no duplicates, so only
+    // the previous url can be equal
+    url prev;
+    bool has_prev = false;
+    while(! q.empty())
+    {
+        auto const i = q.top();
+        q.pop();
+        auto& r = rd[i];
+        if( ! has_prev ||
+            prev.compare(r.u) != 0)
+        {
+            if(f)
+                (*f)(r.u);
+            else
+                write_line(out->f, r.u.buffer());
+            prev = r.u;
+            has_prev = true;
+            ++n;
+        }
+        if(r.next())
+            q.push(i);
+    }
+    if( out &&
+        std::fflush(out->f) != 0)
+        detail::throw_errc(
+            system::errc::io_error);
+    runs.clear();
+    return out;
+}
+
+} // urls
+} // boost
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2022 alandefreitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+//
+
+//[example_url_sort
+
+/*
+    This example sorts a list of URLs, such
+    as the links found by a crawler, and
+    removes the duplicates, using a bounded
+    amount of memory. URLs are normalized
+    first, so equivalent URLs are written
+    once. The list can be larger than the
+    memory, since sorted runs are written to
+    temporary files and merged.
+*/
+
+#include "url_sorter.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace urls = boost::urls;
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::cout << argv[0] << "\n";
+        std::cout << "Usage: url_sort <input> <output> <memory> <threads> <temp>\n"
+                     "options:\n"
+                     "    <input>:            File with one URL per line (required)\n"
+                     "    <output>:           File where the sorted URLs are written (required)\n"
+                     "    <memory>:           Memory budget in MiB (default: 256)\n"
+                     "    <threads>:          Threads sorting runs (default: 1)\n"
+                     "    <temp>:             Directory of the temporary files (optional)\n"
+                     "examples:\n"
+                     "url_sort links.txt sorted.txt\n"
+                     "url_sort links.txt sorted.txt 64 4 /tmp\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream fin(argv[1]);
+    if (!fin)
+    {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+    std::ofstream fout(argv[2]);
+    if (!fout)
+    {
+        std::cerr << "Cannot open " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    urls::url_sorter::options opt;
+    if (argc > 3)
+        opt.memory = std::strtoull(argv[3], nullptr, 10) * 1024 * 1024;
+    if (argc > 4)
+        opt.threads = std::strtoull(argv[4], nullptr, 10);
+    if (argc > 5)
+        opt.temp_dir = argv[5];
+
+    try
+    {
+        urls::url_sorter sorter(opt);
+        auto const t0 = std::chrono::steady_clock::now();
+        std::string line;
+        while (std::getline(fin, line))
+            sorter.push(line);
+        auto const n = sorter.finish(
+            [&fout](urls::url_view u)
+            {
+                fout << u.buffer() << "\n";
+            });
+        std::chrono::duration<double> const dt =
+            std::chrono::steady_clock::now() - t0;
+        if (!fout)
+        {
+            std::cerr << "Cannot write " << argv[2] << "\n";
+            return EXIT_FAILURE;
+        }
+
+        std::cout <<
+            "urls:        " << sorter.size()    << "\n"
+            "invalid:     " << sorter.invalid() << "\n"
+            "unique:      " << n                << "\n"
+            "runs:        " << sorter.runs()    << "\n"
+            "seconds:     " << dt.count()       << "\n";
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//]
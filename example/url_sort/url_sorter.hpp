@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_SORTER_HPP
+#define BOOST_URL_URL_SORTER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** Sort and deduplicate more URLs than fit in memory
+
+    URLs are parsed as URI references,
+    normalized, and collected in memory
+    until the memory budget is reached.
+    Each collection is then sorted in the
+    order of `url_view_base::compare`,
+    deduplicated and written to a temporary
+    file, called a run, on a separate
+    thread. Finally, the runs are merged,
+    and each unique URL is passed to a
+    function in order.
+
+    When there are more runs than can be
+    merged at once, groups of runs are
+    first merged into longer runs.
+
+    @par Example
+    @code
+    url_sorter s;
+    s.push( "https://www.example.com/b" );
+    s.push( "https://www.example.com/a" );
+    s.push( "HTTPS://www.example.com/%61" );
+
+    std::vector< std::string > v;
+    s.finish( [&v]( url_view u ) { v.emplace_back( u.buffer() ); } );
+
+    assert( v.size() == 2 );
+    assert( v[0] == "https://www.example.com/a" );
+    @endcode
+
+    @par Exception Safety
+    Functions which throw leave the sorter
+    in a valid but unspecified state.
+*/
+class url_sorter
+{
+public:
+    /// Options for the sorter
+    struct options
+    {
+        /** The memory used to sort, in bytes
+
+            This bounds the memory used by the
+            runs being collected and sorted,
+            and by the buffers of the merge.
+        */
+        std::size_t memory = 256 * 1024 * 1024;
+
+        /** The number of threads sorting runs
+
+            The URLs are collected on the calling
+            thread while up to this number of
+            runs are sorted and written.
+        */
+        std::size_t threads = 1;
+
+        /** The maximum number of runs merged at once
+        */
+        std::size_t fan_in = 64;
+
+        /** The directory of the temporary files
+
+            If this is empty, the files are
+            created with `std::tmpfile`.
+        */
+        std::string temp_dir;
+    };
+
+    /** Constructor
+
+        @param opt The options
+    */
+    explicit
+    url_sorter(options const& opt);
+
+    /// Constructor
+    url_sorter()
+        : url_sorter(options())
+    {
+    }
+
+    /** Destructor
+
+        Waits for the runs being sorted, and
+        removes the temporary files.
+    */
+    ~url_sorter();
+
+    url_sorter(url_sorter const&) = delete;
+    url_sorter& operator=(url_sorter const&) = delete;
+
+    /** Add a URL
+
+        @return `false` if `s` is not a valid
+        URI reference, which is then ignored.
+
+        @throw system_error
+        A temporary file could not be written.
+
+        @param s The URL
+    */
+    bool
+    push(core::string_view s);
+
+    /** Merge the runs
+
+        The function is called once for each
+        unique URL, in the order of
+        `url_view_base::compare`, with a view
+        which is valid until it returns.
+        URLs added afterwards are sorted
+        separately, and the counters are not
+        reset.
+
+        @return The number of unique URLs
+
+        @throw system_error
+        A temporary file could not be read
+        or written.
+
+        @param f The function to call
+    */
+    std::size_t
+    finish(std::function<void(url_view)> const& f);
+
+    /// Return the number of URLs added
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Return the number of strings ignored by @ref push
+    std::size_t
+    invalid() const noexcept
+    {
+        return invalid_;
+    }
+
+    /// Return the number of runs written to files
+    std::size_t
+    runs() const noexcept
+    {
+        return nruns_;
+    }
+
+private:
+    struct run;
+    struct chunk;
+    class reader;
+
+    void
+    spill();
+
+    void
+    wait_one();
+
+    std::unique_ptr<run>
+    make_run();
+
+    static
+    std::vector<std::size_t>
+    sort_chunk(
+        chunk& c,
+        std::vector<url_view>& v);
+
+    static
+    std::unique_ptr<run>
+    sort_run(
+        std::unique_ptr<chunk> c,
+        std::unique_ptr<run> r);
+
+    std::unique_ptr<run>
+    merge(
+        std::vector<std::unique_ptr<run>>& runs,
+        std::function<void(url_view)> const* f,
+        std::size_t& n);
+
+    options opt_;
+    std::string tag_;
+    url u_;
+    std::unique_ptr<chunk> chunk_;
+    std::vector<std::future<
+        std::unique_ptr<run>>> pending_;
+    std::vector<std::unique_ptr<run>> runs_;
+    std::size_t chunk_size_ = 0;
+    std::size_t size_ = 0;
+    std::size_t invalid_ = 0;
+    std::size_t nruns_ = 0;
+    std::size_t nfiles_ = 0;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_EXTRA_TEST_ALLOCATIONS_HPP
+#define BOOST_URL_EXTRA_TEST_ALLOCATIONS_HPP
+
+#if defined(_MSC_VER)
+# pragma once
+#endif
+
+#include "test_suite.hpp"
+#include <boost/url/stats.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*  Counting allocator for tests
+
+    This header replaces the global
+    operator new and operator delete of
+    the program, so it must be included by
+    exactly one translation unit of a test
+    program of its own. Test programs shared
+    by other suites must not include it.
+*/
+
+namespace test_suite {
+
+// Return the number of allocations
+// made by the program on any thread
+inline
+std::atomic<std::size_t>&
+global_allocations() noexcept
+{
+    static std::atomic<std::size_t> n{0};
+    return n;
+}
+
+/*  Fails the test if the enclosing scope
+    allocates memory on any thread, or if
+    a url of the library allocates.
+
+    @code
+    {
+        zero_allocations za;
+        // view-only code
+    }
+    @endcode
+*/
+class zero_allocations
+{
+    std::size_t n_;
+    std::size_t nurl_;
+
+public:
+    zero_allocations() noexcept
+        : n_(global_allocations().load())
+        , nurl_(boost::urls::get_url_stats().allocations)
+    {
+    }
+
+    zero_allocations(
+        zero_allocations const&) = delete;
+
+    ~zero_allocations()
+    {
+        BOOST_TEST_EQ(
+            global_allocations().load(), n_);
+        BOOST_TEST_EQ(
+            boost::urls::get_url_stats().allocations,
+            nurl_);
+    }
+};
+
+} // test_suite
+
+void*
+operator new(std::size_t n)
+{
+    test_suite::global_allocations().fetch_add(
+        1, std::memory_order_relaxed);
+    if(void* p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif
@@ -13,7 +13,9 @@
 #include <boost/url/grammar.hpp>
 
 #include <boost/url/authority_view.hpp>
+#include <boost/url/cache_key.hpp>
 #include <boost/url/decode_view.hpp>
+#include <boost/url/edit_batch.hpp>
 #include <boost/url/encode.hpp>
 #include <boost/url/encoding_opts.hpp>
 #include <boost/url/error.hpp>
@@ -24,11 +26,13 @@
 #include <boost/url/ipv4_address.hpp>
 #include <boost/url/ipv6_address.hpp>
 #include <boost/url/optional.hpp>
+#include <boost/url/origin_form_parser.hpp>
 #include <boost/url/param.hpp>
 #include <boost/url/params_base.hpp>
 #include <boost/url/params_encoded_base.hpp>
 #include <boost/url/params_encoded_ref.hpp>
 #include <boost/url/params_encoded_view.hpp>
+#include <boost/url/params_parser.hpp>
 #include <boost/url/params_ref.hpp>
 #include <boost/url/params_view.hpp>
 #include <boost/url/parse.hpp>
@@ -42,9 +46,13 @@
 #include <boost/url/segments_encoded_view.hpp>
 #include <boost/url/segments_ref.hpp>
 #include <boost/url/segments_view.hpp>
+#include <boost/url/sink.hpp>
+#include <boost/url/small_url.hpp>
 #include <boost/url/static_url.hpp>
+#include <boost/url/stats.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/url/url.hpp>
+#include <boost/url/url_arena.hpp>
 #include <boost/url/url_base.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/url_view_base.hpp>
@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_CACHE_KEY_HPP
+#define BOOST_URL_CACHE_KEY_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** Options for computing cache keys
+
+    @see
+        @ref cache_key_generator.
+*/
+struct BOOST_URL_DECL cache_key_opts
+{
+    /** True if the port is removed when it is the default
+
+        When this option is `true`, a port which
+        is empty or equal to the default port of
+        the scheme, such as 80 for "http", is
+        not part of the key.
+    */
+    bool remove_default_port = true;
+
+    /** True if "." and ".." segments are removed
+
+        When this option is `true`, the dot
+        segments of the path are removed as
+        described in rfc3986.
+
+        @par Specification
+        @li <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-5.2.4"
+            >5.2.4. Remove Dot Segments (rfc3986)</a>
+    */
+    bool remove_dot_segments = true;
+
+    /** True if the params are sorted
+
+        When this option is `true`, the params
+        are sorted by their decoded keys, and
+        params with the same key by their
+        decoded values, so the order in which
+        they appear does not change the key.
+    */
+    bool sort_params = true;
+
+    /** True if the fragment is removed
+
+        The fragment is never sent to a server,
+        so it is usually not part of a cache key.
+    */
+    bool remove_fragment = true;
+
+#ifndef BOOST_URL_DOCS
+    cache_key_opts(
+        bool remove_default_port_ = true,
+        bool remove_dot_segments_ = true,
+        bool sort_params_ = true,
+        bool remove_fragment_ = true) noexcept;
+#endif
+};
+
+//------------------------------------------------
+
+/** A 128-bit key identifying equivalent URLs
+
+    @see
+        @ref cache_key_generator.
+*/
+struct cache_key
+{
+    /// The first 64 bits of the key
+    std::uint64_t first = 0;
+
+    /// The last 64 bits of the key
+    std::uint64_t second = 0;
+
+    /// Return true if the keys are equal
+    friend
+    bool
+    operator==(
+        cache_key const& a,
+        cache_key const& b) noexcept
+    {
+        return
+            a.first == b.first &&
+            a.second == b.second;
+    }
+
+    /// Return true if the keys are different
+    friend
+    bool
+    operator!=(
+        cache_key const& a,
+        cache_key const& b) noexcept
+    {
+        return !(a == b);
+    }
+};
+
+//------------------------------------------------
+
+/** A generator of cache keys for URLs
+
+    This computes a 128-bit key from the
+    canonical form of a URL, where:
+
+    @li The scheme and the host are lowercase,
+
+    @li Percent-encoded unreserved characters
+        are decoded and the hexadecimal digits
+        of the other escapes are uppercase,
+
+    @li An empty path is "/" if there is an
+        authority, and dot segments are removed,
+
+    @li Ignored params are removed, and the
+        others are sorted.
+
+    The canonical form is streamed into a keyed
+    128-bit SipHash without building a @ref url,
+    and can optionally be written to a string.
+    URLs which are equivalent under these rules
+    have the same key.
+
+    Removing dot segments and sorting params
+    needs a scratch buffer, which is allocated
+    on the stack with the size given as the
+    template parameter of the call operator.
+    The generator only allocates when the path
+    and the params of a URL do not fit in it.
+
+    @par Example
+    @code
+    cache_key_generator g;
+    g.ignore_param( "utm_source" );
+
+    assert( g( url_view( "HTTP://Example.com:80/a/./b?y=2&x=1&utm_source=z" ) ) ==
+            g( url_view( "http://example.com/a/b?x=1&y=2" ) ) );
+    @endcode
+
+    @par Exception Safety
+    Throws nothing, unless the scratch buffer
+    or the canonical string must grow.
+
+    @see
+        @ref cache_key,
+        @ref cache_key_opts,
+        @ref url_view_base::digest128.
+*/
+class BOOST_URL_DECL cache_key_generator
+{
+public:
+    /// The default size of the scratch buffer
+    static constexpr std::size_t default_scratch_size = 1024;
+
+    /** Constructor
+
+        @param opt The options
+        @param k0 The first half of the key
+        of the hash
+        @param k1 The second half of the key
+        of the hash
+    */
+    explicit
+    cache_key_generator(
+        cache_key_opts const& opt = {},
+        std::uint64_t k0 = 0,
+        std::uint64_t k1 = 0) noexcept;
+
+    /** Remove params with a key from cache keys
+
+        Keys are compared as if they were both
+        percent-decoded.
+
+        @return `*this`
+
+        @param key The key of the params
+    */
+    cache_key_generator&
+    ignore_param(core::string_view key);
+
+    /** Return the cache key of a URL
+
+        @par Complexity
+        `n log n` in the number of params, and
+        linear in `u.size()` otherwise.
+
+        @tparam N The size of the scratch buffer
+
+        @param u The URL
+    */
+    template<std::size_t N = default_scratch_size>
+    cache_key
+    operator()(url_view_base const& u) const
+    {
+        alignas(std::max_align_t) char buf[N];
+        return make(u, buf, N, nullptr);
+    }
+
+    /** Return the cache key of a URL and its canonical form
+
+        The canonical form of the URL is
+        assigned to `canonical`, whose memory
+        is reused.
+
+        @tparam N The size of the scratch buffer
+
+        @param u The URL
+        @param canonical The canonical form
+    */
+    template<std::size_t N = default_scratch_size>
+    cache_key
+    operator()(
+        url_view_base const& u,
+        std::string& canonical) const
+    {
+        alignas(std::max_align_t) char buf[N];
+        return make(u, buf, N, &canonical);
+    }
+
+private:
+    cache_key
+    make(
+        url_view_base const& u,
+        char* scratch,
+        std::size_t n,
+        std::string* canonical) const;
+
+    cache_key_opts opt_;
+    std::uint64_t k0_;
+    std::uint64_t k1_;
+    std::vector<std::string> ignored_;
+};
+
+} // urls
+} // boost
+
+#endif
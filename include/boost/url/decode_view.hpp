@@ -144,6 +144,30 @@ public:
     /// @copydoc iterator
     using const_iterator = iterator;
 
+    /** An iterator of spans of decoded characters.
+
+        This iterator is used to access the
+        decoded string as a sequence of
+        contiguous spans, which are either
+        the longest runs of characters that
+        need no decoding, referencing the
+        encoded string, or a single decoded
+        character. Algorithms can process
+        each run at once instead of one
+        character at a time.
+
+        The value type is `core::string_view`.
+        A span holding a decoded character
+        references the iterator, and is
+        invalidated when the iterator is
+        incremented or destroyed.
+    */
+#ifdef BOOST_URL_DOCS
+    using span_iterator = __see_below__;
+#else
+    class span_iterator;
+#endif
+
     //--------------------------------------------
     //
     // Special Members
@@ -298,6 +322,37 @@ public:
     iterator
     end() const noexcept;
 
+    /** Return an iterator to the first span
+
+        @par Example
+        @code
+        decode_view d( "Program%20Files" );
+        std::string s;
+        for( auto it = d.span_begin(); it != d.span_end(); ++it )
+            s.append( (*it).data(), (*it).size() );
+        assert( s == "Program Files" );
+        @endcode
+
+        @par Complexity
+        Linear in the size of the first span.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    span_iterator
+    span_begin() const noexcept;
+
+    /** Return an iterator to one past the last span
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    span_iterator
+    span_end() const noexcept;
+
     /** Return the first character
 
         @par Example
@@ -432,6 +487,49 @@ public:
     const_iterator
     rfind( char ch ) const noexcept;
 
+    /** Copy decoded characters to a buffer
+
+        This copies at most `count` decoded
+        characters, starting with the character
+        at position `pos`, to `dest`. Runs of
+        characters which need no decoding are
+        copied at once.
+
+        @par Example
+        @code
+        char buf[ 32 ];
+        std::size_t n = decode_view( "Program%20Files" ).copy( buf, sizeof(buf) );
+        assert( core::string_view( buf, n ) == "Program Files" );
+        @endcode
+
+        @par Preconditions
+        @code
+        pos <= this->size()
+        @endcode
+
+        @par Complexity
+        Linear in `pos + count`.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return The number of characters copied
+
+        @param dest The destination buffer
+
+        @param count The largest number of
+        characters to copy
+
+        @param pos The position of the first
+        character to copy
+    */
+    BOOST_URL_DECL
+    size_type
+    copy(
+        char* dest,
+        size_type count,
+        size_type pos = 0) const noexcept;
+
     /** Remove the first characters
 
         @par Example
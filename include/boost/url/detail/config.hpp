@@ -15,6 +15,7 @@
 #include <boost/config/workaround.hpp>
 #include <limits.h>
 #include <stdint.h>
+#include <type_traits>
 
 #if CHAR_BIT != 8
 # error unsupported platform
@@ -60,6 +61,21 @@
 # define BOOST_URL_CONSTEXPR constexpr
 #endif
 
+// constexpr parsing
+#if defined(__cpp_lib_is_constant_evaluated) && \
+    __cpp_lib_is_constant_evaluated >= 201811L
+# define BOOST_URL_HAS_CONSTEXPR_PARSE
+# define BOOST_URL_CXX20_CONSTEXPR constexpr
+#else
+# define BOOST_URL_CXX20_CONSTEXPR
+#endif
+
+// format strings checked at compile time
+#if defined(__cpp_consteval) && \
+    __cpp_consteval >= 201811L
+# define BOOST_URL_HAS_FORMAT_STRING
+#endif
+
 // Add source location to error codes
 #ifdef BOOST_URL_NO_SOURCE_LOCATION
 # define BOOST_URL_ERR(ev) (::boost::system::error_code(ev))
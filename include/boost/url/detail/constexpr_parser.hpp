@@ -0,0 +1,838 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_DETAIL_CONSTEXPR_PARSER_HPP
+#define BOOST_URL_DETAIL_CONSTEXPR_PARSER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/detail/url_impl.hpp>
+#include <boost/url/grammar/alpha_chars.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/digit_chars.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/url/grammar/lut_chars.hpp>
+#include <boost/url/rfc/pchars.hpp>
+#include <boost/url/rfc/sub_delim_chars.hpp>
+#include <boost/url/rfc/unreserved_chars.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// the character sets of constexpr_parser
+namespace constexpr_chars {
+
+constexpr auto uchars =
+    unreserved_chars + sub_delim_chars;
+
+constexpr auto pwchars =
+    uchars + ':';
+
+constexpr auto pchars_nc =
+    pchars - ':';
+
+constexpr auto path_chars =
+    pchars + '/';
+
+constexpr auto query_chars =
+    pchars + '/' + '?' + '[' + ']';
+
+constexpr auto fragment_chars =
+    pchars + '/' + '?' + '#';
+
+constexpr grammar::lut_chars scheme_chars(
+    "0123456789" "+-."
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz");
+
+} // constexpr_chars
+
+/*  A parser for URI-reference which can
+    be used in constant expressions.
+
+    The rules return system::result, whose
+    error_code is not a literal type, so
+    they cannot be evaluated at compile
+    time. This parser accepts the same
+    strings as uri_reference_rule and
+    produces the same url_impl, using
+    only constexpr character sets.
+*/
+class constexpr_parser
+    : private parts_base
+{
+    char const* const first_;
+    char const* it_;
+    char const* const end_;
+
+    std::size_t n_[id_end] = {};
+    std::size_t dn_[id_end] = {};
+    std::size_t nscheme_ = 0;
+    std::size_t nseg_ = 0;
+    std::size_t nparam_ = 0;
+    unsigned char addr_[16] = {};
+    std::uint16_t port_number_ = 0;
+    host_type host_type_ =
+        urls::host_type::none;
+    scheme scheme_ =
+        urls::scheme::none;
+
+public:
+    /*  Parse a URI-reference
+
+        Returns false if the string is not
+        a valid URI or relative-ref, else
+        stores the parts in u.
+    */
+    static
+    BOOST_CXX14_CONSTEXPR
+    bool
+    parse_uri_reference(
+        core::string_view s,
+        url_impl& u) noexcept
+    {
+        {
+            constexpr_parser p(s);
+            if(p.uri())
+            {
+                p.apply(u);
+                return true;
+            }
+        }
+        constexpr_parser p(s);
+        if(! p.relative_ref())
+            return false;
+        p.apply(u);
+        return true;
+    }
+
+private:
+    explicit
+    BOOST_CXX14_CONSTEXPR
+    constexpr_parser(
+        core::string_view s) noexcept
+        : first_(s.data())
+        , it_(s.data())
+        , end_(s.data() + s.size())
+    {
+    }
+
+    BOOST_CXX14_CONSTEXPR
+    void
+    apply(url_impl& u) const noexcept
+    {
+        u.cs_ = first_;
+        u.scheme_ = scheme_;
+        u.host_type_ = host_type_;
+        u.port_number_ = port_number_;
+        for(int i = 0; i < 16; ++i)
+            u.ip_addr_[i] = addr_[i];
+        std::size_t pos = nscheme_;
+        for(int id = id_user; id < id_end; ++id)
+        {
+            u.offset_[id] = pos;
+            u.decoded_[id] = dn_[id];
+            pos += n_[id];
+        }
+        u.offset_[id_end] = pos;
+        u.nseg_ = nseg_;
+        u.nparam_ = nparam_;
+    }
+
+    //--------------------------------------------
+
+    static
+    constexpr
+    int
+    hexdig_value(char c) noexcept
+    {
+        return
+            (c >= '0' && c <= '9') ? c - '0' :
+            (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+            (c >= 'A' && c <= 'F') ? c - 'A' + 10 :
+            -1;
+    }
+
+    // string_to_scheme
+    static
+    BOOST_CXX14_CONSTEXPR
+    scheme
+    to_scheme(
+        char const* p,
+        std::size_t n) noexcept
+    {
+        struct entry
+        {
+            char const* s;
+            std::size_t n;
+            scheme id;
+        };
+        entry const v[] = {
+            { "ftp", 3, urls::scheme::ftp },
+            { "file", 4, urls::scheme::file },
+            { "http", 4, urls::scheme::http },
+            { "https", 5, urls::scheme::https },
+            { "ws", 2, urls::scheme::ws },
+            { "wss", 3, urls::scheme::wss } };
+        for(auto const& e : v)
+        {
+            if(e.n != n)
+                continue;
+            std::size_t i = 0;
+            while( i < n &&
+                grammar::to_lower(p[i]) == e.s[i])
+                ++i;
+            if(i == n)
+                return e.id;
+        }
+        return urls::scheme::unknown;
+    }
+
+    // path_segments
+    static
+    BOOST_CXX14_CONSTEXPR
+    std::size_t
+    path_segments(
+        char const* p,
+        std::size_t n,
+        std::size_t nseg) noexcept
+    {
+        if(n == 0)
+            return 0;
+        if(n == 1)
+            return p[0] == '/' ? 0 : 1;
+        if(p[0] == '/')
+        {
+            if( n > 2 &&
+                p[1] == '.' &&
+                p[2] == '/')
+                return nseg - 1;
+            return nseg;
+        }
+        if( p[0] == '.' &&
+            p[1] == '/')
+            return nseg - 1;
+        return nseg;
+    }
+
+    //--------------------------------------------
+
+    // *( cs / pct-encoded ), adding
+    // the decoded size to dn
+    template<class CharSet>
+    BOOST_CXX14_CONSTEXPR
+    bool
+    pct(
+        CharSet const& cs,
+        std::size_t& dn) noexcept
+    {
+        while(it_ != end_)
+        {
+            if(cs(*it_))
+            {
+                ++it_;
+                ++dn;
+                continue;
+            }
+            if(*it_ != '%')
+                break;
+            if( end_ - it_ < 3 ||
+                ! grammar::hexdig_chars(it_[1]) ||
+                ! grammar::hexdig_chars(it_[2]))
+                return false;
+            it_ += 3;
+            ++dn;
+        }
+        return true;
+    }
+
+    // scheme ":" hier-part [ "?" query ] [ "#" fragment ]
+    BOOST_CXX14_CONSTEXPR
+    bool
+    uri() noexcept
+    {
+        if( it_ == end_ ||
+            ! grammar::alpha_chars(*it_))
+            return false;
+        ++it_;
+        while( it_ != end_ &&
+            constexpr_chars::scheme_chars(*it_))
+            ++it_;
+        if( it_ == end_ ||
+            *it_ != ':')
+            return false;
+        scheme_ = to_scheme(
+            first_, it_ - first_);
+        ++it_;
+        nscheme_ = it_ - first_;
+        return
+            hier_part(false) &&
+            query_and_fragment();
+    }
+
+    // relative-part [ "?" query ] [ "#" fragment ]
+    BOOST_CXX14_CONSTEXPR
+    bool
+    relative_ref() noexcept
+    {
+        return
+            hier_part(true) &&
+            query_and_fragment();
+    }
+
+    // hier_part_rule and relative_part_rule
+    BOOST_CXX14_CONSTEXPR
+    bool
+    hier_part(bool relative) noexcept
+    {
+        if(it_ == end_)
+        {
+            // path-empty
+            return true;
+        }
+        char const* p0 = it_;
+        std::size_t dn = 0;
+        if(end_ - it_ == 1)
+        {
+            if(*it_ == '/')
+            {
+                // path-absolute
+                ++it_;
+                return path(p0, 1, 1);
+            }
+            if( relative &&
+                *it_ == ':')
+            {
+                // path-empty
+                return true;
+            }
+            if(! pct(pchars, dn))
+                return false;
+            return path(p0, dn, it_ != p0);
+        }
+        bool has_authority = false;
+        if( it_[0] == '/' &&
+            it_[1] == '/')
+        {
+            // "//" authority
+            it_ += 2;
+            if(! authority())
+                return false;
+            has_authority = true;
+        }
+        // the authority requires an absolute path
+        // or an empty path
+        if(it_ == end_ || (
+            ! relative &&
+            has_authority &&
+            *it_ != '/' &&
+            *it_ != '?' &&
+            *it_ != '#'))
+        {
+            // path-empty
+            return true;
+        }
+        p0 = it_;
+        std::size_t nseg = 0;
+        if(*it_ != '/')
+        {
+            if(relative)
+            {
+                // segment-nz-nc
+                if(! pct(constexpr_chars::pchars_nc, dn))
+                    return false;
+            }
+            else if(! pct(pchars, dn))
+            {
+                return false;
+            }
+            if(it_ == p0)
+                return true;
+            ++nseg;
+            if( relative &&
+                it_ != end_ &&
+                *it_ == ':')
+                return false;
+        }
+        while(it_ != end_)
+        {
+            if(*it_ == '/')
+            {
+                ++dn;
+                ++it_;
+                ++nseg;
+                continue;
+            }
+            char const* const it0 = it_;
+            if(! pct(pchars, dn))
+                return false;
+            if(it_ == it0)
+                break;
+        }
+        return path(p0, dn, nseg);
+    }
+
+    BOOST_CXX14_CONSTEXPR
+    bool
+    path(
+        char const* p0,
+        std::size_t dn,
+        std::size_t nseg) noexcept
+    {
+        std::size_t const n = it_ - p0;
+        n_[id_path] = n;
+        dn_[id_path] = dn;
+        nseg_ = path_segments(p0, n, nseg);
+        return true;
+    }
+
+    // [ userinfo "@" ] host [ ":" port ]
+    BOOST_CXX14_CONSTEXPR
+    bool
+    authority() noexcept
+    {
+        // the leading "//"
+        n_[id_user] = 2;
+
+        // [ userinfo "@" ]
+        char const* const first = it_;
+        std::size_t du = 0;
+        std::size_t dp = 0;
+        if(pct(constexpr_chars::uchars, du))
+        {
+            char const* const user_end = it_;
+            bool ok = true;
+            if( it_ != end_ &&
+                *it_ == ':')
+            {
+                ++it_;
+                ok = pct(constexpr_chars::pwchars, dp);
+            }
+            if( ok &&
+                it_ != end_ &&
+                *it_ == '@')
+            {
+                ++it_;
+                n_[id_user] += user_end - first;
+                dn_[id_user] = du;
+                // [ ':' password ] '@'
+                n_[id_pass] = it_ - user_end;
+                dn_[id_pass] = dp;
+            }
+            else
+            {
+                it_ = first;
+            }
+        }
+        else
+        {
+            it_ = first;
+        }
+
+        if(! host())
+            return false;
+
+        // [ ":" port ]
+        if( it_ != end_ &&
+            *it_ == ':')
+        {
+            char const* const p = it_;
+            ++it_;
+            while( it_ != end_ &&
+                *it_ == '0')
+                ++it_;
+            std::uint32_t v = 0;
+            while( it_ != end_ &&
+                grammar::digit_chars(*it_))
+            {
+                // number > max uint16_t is 0
+                if(v <= 65535)
+                    v = 10 * v + (*it_ - '0');
+                ++it_;
+            }
+            if(v <= 65535)
+                port_number_ = static_cast<
+                    std::uint16_t>(v);
+            n_[id_port] = it_ - p;
+        }
+        return true;
+    }
+
+    // host_rule
+    BOOST_CXX14_CONSTEXPR
+    bool
+    host() noexcept
+    {
+        char const* const first = it_;
+        if(it_ == end_)
+        {
+            // empty host
+            host_type_ =
+                urls::host_type::name;
+            return true;
+        }
+        std::size_t dn = 0;
+        if(*it_ == '[')
+        {
+            if(! ip_literal())
+                return false;
+        }
+        else
+        {
+            unsigned char b[4] = {};
+            if(ipv4(b))
+            {
+                char const* const p = it_;
+                if( pct(constexpr_chars::uchars, dn) &&
+                    it_ != p)
+                {
+                    // reg-name
+                    host_type_ =
+                        urls::host_type::name;
+                }
+                else
+                {
+                    it_ = p;
+                    for(int i = 0; i < 4; ++i)
+                        addr_[i] = b[i];
+                    host_type_ =
+                        urls::host_type::ipv4;
+                }
+            }
+            else
+            {
+                // reg-name
+                it_ = first;
+                if(! pct(constexpr_chars::uchars, dn))
+                    return false;
+                host_type_ =
+                    urls::host_type::name;
+            }
+        }
+        std::size_t const n = it_ - first;
+        dn = n;
+        for(auto p = first; p != it_; ++p)
+            if(*p == '%')
+                dn -= 2;
+        n_[id_host] = n;
+        dn_[id_host] = dn;
+        return true;
+    }
+
+    // "[" ( IPv6address / IPv6addrz / IPvFuture ) "]"
+    BOOST_CXX14_CONSTEXPR
+    bool
+    ip_literal() noexcept
+    {
+        ++it_;
+        if(it_ == end_)
+            return false;
+        if(*it_ != 'v')
+        {
+            char const* const p = it_;
+            unsigned char b[16] = {};
+            if( ipv6(b) &&
+                it_ != end_ &&
+                *it_ == ']')
+            {
+                ++it_;
+            }
+            else
+            {
+                // IPv6addrz
+                it_ = p;
+                if(! ipv6(b))
+                    return false;
+                if( end_ - it_ < 3 ||
+                    it_[0] != '%' ||
+                    it_[1] != '2' ||
+                    it_[2] != '5')
+                    return false;
+                it_ += 3;
+                char const* const z = it_;
+                std::size_t dz = 0;
+                if( ! pct(unreserved_chars, dz) ||
+                    it_ == z)
+                    return false;
+                if( it_ == end_ ||
+                    *it_ != ']')
+                    return false;
+                ++it_;
+            }
+            for(int i = 0; i < 16; ++i)
+                addr_[i] = b[i];
+            host_type_ =
+                urls::host_type::ipv6;
+            return true;
+        }
+
+        // IPvFuture
+        ++it_;
+        char const* p = it_;
+        while( it_ != end_ &&
+            grammar::hexdig_chars(*it_))
+            ++it_;
+        if( it_ == p ||
+            it_ == end_ ||
+            *it_ != '.')
+            return false;
+        p = ++it_;
+        while( it_ != end_ &&
+            constexpr_chars::pwchars(*it_))
+            ++it_;
+        if( it_ == p ||
+            it_ == end_ ||
+            *it_ != ']')
+            return false;
+        ++it_;
+        host_type_ =
+            urls::host_type::ipvfuture;
+        return true;
+    }
+
+    // dec-octet "." dec-octet "." dec-octet "." dec-octet
+    BOOST_CXX14_CONSTEXPR
+    bool
+    ipv4(unsigned char* b) noexcept
+    {
+        for(int i = 0; i < 4; ++i)
+        {
+            if(i != 0)
+            {
+                if( it_ == end_ ||
+                    *it_ != '.')
+                    return false;
+                ++it_;
+            }
+            if(! dec_octet(b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    // dec_octet_rule
+    BOOST_CXX14_CONSTEXPR
+    bool
+    dec_octet(unsigned char& b) noexcept
+    {
+        if( it_ == end_ ||
+            ! grammar::digit_chars(*it_))
+            return false;
+        unsigned v = *it_++ - '0';
+        if( it_ != end_ &&
+            grammar::digit_chars(*it_))
+        {
+            if(v == 0)
+            {
+                // leading '0'
+                return false;
+            }
+            v = 10 * v + (*it_++ - '0');
+            if( it_ != end_ &&
+                grammar::digit_chars(*it_))
+            {
+                v = 10 * v + (*it_++ - '0');
+                if(v > 255)
+                    return false;
+                if( it_ != end_ &&
+                    grammar::digit_chars(*it_))
+                    return false;
+            }
+        }
+        b = static_cast<unsigned char>(v);
+        return true;
+    }
+
+    // h16_rule
+    BOOST_CXX14_CONSTEXPR
+    bool
+    h16(unsigned char* b) noexcept
+    {
+        if( it_ == end_ ||
+            hexdig_value(*it_) < 0)
+            return false;
+        unsigned v = 0;
+        for(int i = 0; i < 4; ++i)
+        {
+            if(it_ == end_)
+                break;
+            int const d = hexdig_value(*it_);
+            if(d < 0)
+                break;
+            v = 16 * v + d;
+            ++it_;
+        }
+        b[0] = static_cast<unsigned char>(v / 256);
+        b[1] = static_cast<unsigned char>(v % 256);
+        return true;
+    }
+
+    // ipv6_address_rule
+    BOOST_CXX14_CONSTEXPR
+    bool
+    ipv6(unsigned char* bytes) noexcept
+    {
+        int n = 8;      // words needed
+        int b = -1;     // value of n
+                        // when '::' seen
+        bool c = false; // need colon
+        char const* prev = it_;
+        for(;;)
+        {
+            if(it_ == end_)
+            {
+                if(b != -1)
+                {
+                    // end in "::"
+                    break;
+                }
+                // not enough words
+                return false;
+            }
+            if(*it_ == ':')
+            {
+                ++it_;
+                if(it_ == end_)
+                    return false;
+                if(*it_ == ':')
+                {
+                    if(b != -1)
+                    {
+                        // extra "::" found
+                        return false;
+                    }
+                    // first "::"
+                    ++it_;
+                    --n;
+                    b = n;
+                    if(n == 0)
+                        break;
+                    c = false;
+                    continue;
+                }
+                if(! c)
+                {
+                    // expected h16
+                    return false;
+                }
+                prev = it_;
+                if(! h16(&bytes[2*(8-n)]))
+                    return false;
+                --n;
+                if(n == 0)
+                    break;
+                continue;
+            }
+            if(*it_ == '.')
+            {
+                if(b == -1 && n > 1)
+                {
+                    // not enough h16
+                    return false;
+                }
+                // the h16 must be
+                // a possible octet
+                unsigned const word =
+                    bytes[2*(7-n)] * 256u +
+                    bytes[2*(7-n)+1];
+                if( word > 0x255 ||
+                    ((word >> 4) & 0xf) > 9 ||
+                    (word & 0xf) > 9)
+                    return false;
+                // rewind the h16 and
+                // parse it as ipv4
+                it_ = prev;
+                if(! ipv4(&bytes[2*(7-n)]))
+                    return false;
+                --n;
+                break;
+            }
+            if( b != -1 &&
+                hexdig_value(*it_) < 0)
+            {
+                // ends in "::"
+                break;
+            }
+            if(c)
+            {
+                // ':' divides a word
+                return false;
+            }
+            prev = it_;
+            if(! h16(&bytes[2*(8-n)]))
+                return false;
+            --n;
+            if(n == 0)
+                break;
+            c = true;
+        }
+        if(b == -1)
+            return true;
+
+        // move the words after "::"
+        // to the end, and zero the gap
+        int const i0 = 2 * (7 - b);
+        int const i1 = 2 * (b - n);
+        unsigned char t[16] = {};
+        for(int i = 0; i < i1; ++i)
+            t[i] = bytes[i0 + 2 + i];
+        for(int i = i0; i < 16; ++i)
+            bytes[i] = 0;
+        for(int i = 0; i < i1; ++i)
+            bytes[16 - i1 + i] = t[i];
+        return true;
+    }
+
+    // [ "?" query ] [ "#" fragment ]
+    BOOST_CXX14_CONSTEXPR
+    bool
+    query_and_fragment() noexcept
+    {
+        if( it_ != end_ &&
+            *it_ == '?')
+        {
+            char const* const p = ++it_;
+            std::size_t dn = 0;
+            if(! pct(constexpr_chars::query_chars, dn))
+                return false;
+            // as query_part_rule, which maps
+            // "?" to { {} } and counts one
+            // more param when the empty query
+            // is not at the end
+            nparam_ = 1;
+            if( it_ == p &&
+                it_ != end_)
+                ++nparam_;
+            for(auto q = p; q != it_; ++q)
+                if(*q == '&')
+                    ++nparam_;
+            n_[id_query] = 1 + (it_ - p);
+            dn_[id_query] = dn;
+        }
+        if( it_ != end_ &&
+            *it_ == '#')
+        {
+            char const* const p = ++it_;
+            std::size_t dn = 0;
+            if(! pct(constexpr_chars::fragment_chars, dn))
+                return false;
+            n_[id_frag] = 1 + (it_ - p);
+            dn_[id_frag] = dn;
+        }
+        return it_ == end_;
+    }
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
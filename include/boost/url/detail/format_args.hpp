@@ -12,6 +12,8 @@
 
 #include <boost/url/detail/encode.hpp>
 #include <boost/url/grammar/lut_chars.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
 
 #include <boost/core/ignore_unused.hpp>
 #include <array>
@@ -320,8 +320,8 @@ public:
     }
 };
 
-// formatters for a single integer
-class integer_formatter_impl
+// the format spec of a number
+struct number_spec
 {
     char fill = ' ';
     char align = '\0';
@@ -331,6 +331,16 @@ class integer_formatter_impl
     std::size_t width_idx = std::size_t(-1);
     core::string_view width_name;
 
+    // floating point only
+    int precision = -1;
+    char type = '\0';
+};
+
+// formatters for a single integer
+class integer_formatter_impl
+{
+    number_spec spec_;
+
 public:
     BOOST_URL_DECL
     char const*
@@ -411,6 +421,176 @@ public:
     }
 };
 
+// enumerations are formatted
+// as their underlying integer
+template <class T>
+struct formatter<
+    T, typename std::enable_if<
+        std::is_enum<T>::value>::type>
+{
+private:
+    integer_formatter_impl impl_;
+    using base_value_type = typename std::conditional<
+        std::is_unsigned<typename
+            std::underlying_type<T>::type>::value,
+        unsigned long long int,
+        long long int
+        >::type;
+
+public:
+    char const*
+    parse(format_parse_context& ctx)
+    {
+        return impl_.parse(ctx);
+    }
+
+    std::size_t
+    measure(
+        T v,
+        measure_context& ctx,
+        grammar::lut_chars const& cs) const
+    {
+        return impl_.measure(
+            static_cast<base_value_type>(v), ctx, cs);
+    }
+
+    char*
+    format(T v, format_context& ctx, grammar::lut_chars const& cs) const
+    {
+        return impl_.format(
+            static_cast<base_value_type>(v), ctx, cs);
+    }
+};
+
+// formatter for a floating point number
+class float_formatter_impl
+{
+    number_spec spec_;
+
+public:
+    BOOST_URL_DECL
+    char const*
+    parse(format_parse_context& ctx);
+
+    BOOST_URL_DECL
+    std::size_t
+    measure(
+        double v,
+        measure_context& ctx,
+        grammar::lut_chars const& cs) const;
+
+    BOOST_URL_DECL
+    char*
+    format(
+        double v,
+        format_context& ctx,
+        grammar::lut_chars const& cs) const;
+};
+
+template <class T>
+struct formatter<
+    T, typename std::enable_if<
+        std::is_same<T, float>::value ||
+        std::is_same<T, double>::value>::type>
+{
+private:
+    float_formatter_impl impl_;
+
+public:
+    char const*
+    parse(format_parse_context& ctx)
+    {
+        return impl_.parse(ctx);
+    }
+
+    std::size_t
+    measure(
+        T v,
+        measure_context& ctx,
+        grammar::lut_chars const& cs) const
+    {
+        return impl_.measure(v, ctx, cs);
+    }
+
+    char*
+    format(T v, format_context& ctx, grammar::lut_chars const& cs) const
+    {
+        return impl_.format(v, ctx, cs);
+    }
+};
+
+// formatters for ip addresses, which are
+// printed to the stack
+template <>
+struct formatter<ipv4_address>
+{
+    formatter<core::string_view> impl_;
+
+public:
+    char const*
+    parse(format_parse_context& ctx)
+    {
+        return impl_.parse(ctx);
+    }
+
+    std::size_t
+    measure(
+        ipv4_address const& a,
+        measure_context& ctx,
+        grammar::lut_chars const& cs) const
+    {
+        char buf[ipv4_address::max_str_len];
+        return impl_.measure(
+            a.to_buffer(buf, sizeof(buf)), ctx, cs);
+    }
+
+    char*
+    format(
+        ipv4_address const& a,
+        format_context& ctx,
+        grammar::lut_chars const& cs) const
+    {
+        char buf[ipv4_address::max_str_len];
+        return impl_.format(
+            a.to_buffer(buf, sizeof(buf)), ctx, cs);
+    }
+};
+
+template <>
+struct formatter<ipv6_address>
+{
+    formatter<core::string_view> impl_;
+
+public:
+    char const*
+    parse(format_parse_context& ctx)
+    {
+        return impl_.parse(ctx);
+    }
+
+    std::size_t
+    measure(
+        ipv6_address const& a,
+        measure_context& ctx,
+        grammar::lut_chars const& cs) const
+    {
+        char buf[ipv6_address::max_str_len];
+        return impl_.measure(
+            a.to_buffer(buf, sizeof(buf)), ctx, cs);
+    }
+
+    char*
+    format(
+        ipv6_address const& a,
+        format_context& ctx,
+        grammar::lut_chars const& cs) const
+    {
+        char buf[ipv6_address::max_str_len];
+        return impl_.format(
+            a.to_buffer(buf, sizeof(buf)), ctx, cs);
+    }
+};
+
 } // detail
 } // url
 } // boost
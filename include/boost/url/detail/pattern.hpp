@@ -0,0 +1,616 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_DETAIL_PATTERN_HPP
+#define BOOST_URL_DETAIL_PATTERN_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/detail/constexpr_parser.hpp>
+#include <boost/url/error_types.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/grammar/alnum_chars.hpp>
+#include <boost/url/grammar/alpha_chars.hpp>
+#include <boost/url/grammar/digit_chars.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+
+// This file includes functions and classes
+// to parse uri templates or format strings
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+class format_args;
+
+struct pattern
+{
+    // the sizes of the components
+    struct sizes
+    {
+        std::size_t scheme = 0;
+        std::size_t user = 0;
+        std::size_t pass = 0;
+        std::size_t host = 0;
+        std::size_t port = 0;
+        std::size_t path = 0;
+        std::size_t query = 0;
+        std::size_t frag = 0;
+    };
+
+    core::string_view scheme;
+    core::string_view user;
+    core::string_view pass;
+    core::string_view host;
+    core::string_view port;
+    core::string_view path;
+    core::string_view query;
+    core::string_view frag;
+
+    bool has_authority = false;
+    bool has_user = false;
+    bool has_pass = false;
+    bool has_port = false;
+    bool has_query = false;
+    bool has_frag = false;
+
+    // the size of the literal text of each
+    // component once it is percent-encoded,
+    // without the replacement fields
+    sizes literals;
+
+    BOOST_URL_DECL
+    void
+    apply(
+        url_base& u,
+        format_args const& args) const;
+};
+
+BOOST_URL_DECL
+system::result<pattern>
+parse_pattern(
+    core::string_view s);
+
+//------------------------------------------------
+
+/*  A parser for format strings which can
+    be used in constant expressions.
+
+    The rules used by parse_pattern return
+    system::result, whose error_code is not
+    a literal type. This parser accepts the
+    same strings and splits them into the
+    same components, so a format string can
+    be checked during compilation. It also
+    counts the arguments the replacement
+    fields refer to.
+*/
+class constexpr_pattern_parser
+{
+    char const* it_;
+    char const* const end_;
+    std::size_t nauto_ = 0;
+    std::size_t nindex_ = 0;
+
+public:
+    explicit
+    BOOST_CXX14_CONSTEXPR
+    constexpr_pattern_parser(
+        core::string_view s) noexcept
+        : it_(s.data())
+        , end_(s.data() + s.size())
+    {
+    }
+
+    /*  Parse a format string
+
+        Returns false if the string is not
+        a valid format string, else stores
+        the components in p.
+    */
+    BOOST_CXX14_CONSTEXPR
+    bool
+    parse(pattern& p) noexcept
+    {
+        if(! pattern_rule(p))
+            return false;
+        if(it_ != end_)
+            return false;
+        measure_literals(p);
+        return true;
+    }
+
+    // the number of replacement fields
+    // with an automatic argument id
+    constexpr
+    std::size_t
+    automatic_ids() const noexcept
+    {
+        return nauto_;
+    }
+
+    // one more than the largest
+    // numeric argument id
+    constexpr
+    std::size_t
+    indexed_args() const noexcept
+    {
+        return nindex_;
+    }
+
+    // Measure the literal text of the
+    // components of a valid pattern
+    static
+    BOOST_CXX14_CONSTEXPR
+    void
+    measure_literals(pattern& p) noexcept
+    {
+        using namespace constexpr_chars;
+        p.literals = {};
+        p.literals.scheme = literal_size(
+            p.scheme, grammar::alpha_chars);
+        p.literals.user = literal_size(
+            p.user, uchars);
+        p.literals.pass = literal_size(
+            p.pass, pwchars);
+        if( ! p.host.empty() &&
+            p.host.front() == '[')
+            p.literals.host = literal_size(
+                p.host.substr(1, p.host.size() - 2),
+                pwchars);
+        else
+            p.literals.host = literal_size(
+                p.host, uchars);
+        p.literals.port = literal_size(
+            p.port, grammar::digit_chars);
+        p.literals.path = literal_size(
+            p.path, path_chars);
+        p.literals.query = literal_size(
+            p.query, query_chars);
+        p.literals.frag = literal_size(
+            p.frag, fragment_chars);
+    }
+
+private:
+    struct counts
+    {
+        std::size_t nauto;
+        std::size_t nindex;
+    };
+
+    constexpr
+    counts
+    save() const noexcept
+    {
+        return { nauto_, nindex_ };
+    }
+
+    BOOST_CXX14_CONSTEXPR
+    void
+    restore(
+        char const* it,
+        counts c) noexcept
+    {
+        it_ = it;
+        nauto_ = c.nauto;
+        nindex_ = c.nindex;
+    }
+
+    // the encoded size of the text outside
+    // the replacement fields, as measured
+    // by pct_vmeasure
+    template<class CharSet>
+    static
+    BOOST_CXX14_CONSTEXPR
+    std::size_t
+    literal_size(
+        core::string_view s,
+        CharSet const& cs) noexcept
+    {
+        std::size_t n = 0;
+        char const* it = s.data();
+        char const* const end = it + s.size();
+        while(it != end)
+        {
+            if(*it != '{')
+            {
+                // '%' is always escaped
+                n += cs(*it) ? 1 : 3;
+                ++it;
+                continue;
+            }
+            // the format spec can only
+            // have one level of nesting
+            std::size_t depth = 0;
+            do
+            {
+                if(*it == '{')
+                    ++depth;
+                else if(*it == '}')
+                    --depth;
+                ++it;
+            }
+            while(depth != 0);
+        }
+        return n;
+    }
+
+    //--------------------------------------------
+
+    // identifier / integer
+    BOOST_CXX14_CONSTEXPR
+    bool
+    arg_id(bool& automatic) noexcept
+    {
+        automatic = false;
+        if(it_ == end_)
+        {
+            automatic = true;
+            return true;
+        }
+        if( grammar::alpha_chars(*it_) ||
+            *it_ == '_')
+        {
+            ++it_;
+            while( it_ != end_ && (
+                grammar::alnum_chars(*it_) ||
+                *it_ == '_'))
+                ++it_;
+            return true;
+        }
+        if(! grammar::digit_chars(*it_))
+        {
+            automatic = true;
+            return true;
+        }
+        auto const it0 = it_;
+        std::size_t v = *it_++ - '0';
+        while( it_ != end_ &&
+            grammar::digit_chars(*it_))
+        {
+            // no leading zeroes
+            if(v == 0)
+            {
+                it_ = it0;
+                return false;
+            }
+            std::size_t const d = *it_++ - '0';
+            if(v > (std::size_t(-1) - d) / 10)
+            {
+                // overflow
+                it_ = it0;
+                return false;
+            }
+            v = v * 10 + d;
+        }
+        if(v >= nindex_)
+            nindex_ = v == std::size_t(-1) ?
+                v : v + 1;
+        return true;
+    }
+
+    // *( spec-chars / "{" [arg_id] "}" )
+    BOOST_CXX14_CONSTEXPR
+    void
+    format_spec() noexcept
+    {
+        for(;;)
+        {
+            while( it_ != end_ &&
+                *it_ >= ' ' &&
+                *it_ <= '~' &&
+                *it_ != '{' &&
+                *it_ != '}')
+                ++it_;
+            auto const it0 = it_;
+            auto const c = save();
+            if( it_ == end_ ||
+                *it_ != '{')
+                return;
+            ++it_;
+            bool automatic = false;
+            if( ! arg_id(automatic) ||
+                it_ == end_ ||
+                *it_ != '}')
+            {
+                restore(it0, c);
+                return;
+            }
+            ++it_;
+            if(automatic)
+                ++nauto_;
+        }
+    }
+
+    // "{" [arg_id] [":" format_spec] "}"
+    BOOST_CXX14_CONSTEXPR
+    bool
+    replacement_field() noexcept
+    {
+        auto const it0 = it_;
+        auto const c = save();
+        if( it_ == end_ ||
+            *it_ != '{')
+            return false;
+        ++it_;
+        bool automatic = false;
+        if(! arg_id(automatic))
+        {
+            // the id is not valid, so the
+            // field can not be closed
+            restore(it0, c);
+            return false;
+        }
+        if( it_ != end_ &&
+            *it_ == ':')
+        {
+            ++it_;
+            format_spec();
+        }
+        if( it_ == end_ ||
+            *it_ != '}')
+        {
+            restore(it0, c);
+            return false;
+        }
+        ++it_;
+        if(automatic)
+            ++nauto_;
+        return true;
+    }
+
+    // *( cs / pct-encoded )
+    template<class CharSet>
+    BOOST_CXX14_CONSTEXPR
+    bool
+    pct(CharSet const& cs) noexcept
+    {
+        for(;;)
+        {
+            while( it_ != end_ &&
+                cs(*it_))
+                ++it_;
+            if( it_ == end_ ||
+                *it_ != '%')
+                return true;
+            ++it_;
+            if( it_ == end_ ||
+                ! grammar::hexdig_chars(*it_))
+                return false;
+            ++it_;
+            if( it_ == end_ ||
+                ! grammar::hexdig_chars(*it_))
+                return false;
+            ++it_;
+        }
+    }
+
+    // pct_encoded_fmt_string_rule
+    template<class CharSet>
+    BOOST_CXX14_CONSTEXPR
+    bool
+    pct_fmt(
+        CharSet const& cs,
+        core::string_view& s) noexcept
+    {
+        auto const start = it_;
+        for(;;)
+        {
+            if(! pct(cs))
+                return false;
+            if(! replacement_field())
+                break;
+        }
+        s = core::string_view(
+            start, it_ - start);
+        return true;
+    }
+
+    // *( cs / replacement_field )
+    template<class CharSet>
+    BOOST_CXX14_CONSTEXPR
+    core::string_view
+    fmt_token(CharSet const& cs) noexcept
+    {
+        auto const start = it_;
+        for(;;)
+        {
+            while( it_ != end_ &&
+                cs(*it_))
+                ++it_;
+            if(! replacement_field())
+                break;
+        }
+        return core::string_view(
+            start, it_ - start);
+    }
+
+    // scheme_template_rule ":"
+    BOOST_CXX14_CONSTEXPR
+    void
+    scheme(pattern& p) noexcept
+    {
+        auto const it0 = it_;
+        auto const c = save();
+        if(it_ == end_)
+            return;
+        if(grammar::alpha_chars(*it_))
+            ++it_;
+        else if(! replacement_field())
+            return;
+        fmt_token(constexpr_chars::scheme_chars);
+        if( it_ == end_ ||
+            *it_ != ':')
+        {
+            restore(it0, c);
+            return;
+        }
+        p.scheme = core::string_view(
+            it0, it_ - it0);
+        ++it_;
+    }
+
+    // authority_template_rule
+    BOOST_CXX14_CONSTEXPR
+    bool
+    authority(pattern& p) noexcept
+    {
+        using namespace constexpr_chars;
+
+        // [ userinfo "@" ]
+        {
+            auto const it0 = it_;
+            auto const c = save();
+            core::string_view user;
+            core::string_view pass;
+            bool has_pass = false;
+            bool ok = pct_fmt(uchars, user);
+            if( ok &&
+                it_ != end_ &&
+                *it_ == ':')
+            {
+                ++it_;
+                has_pass = true;
+                ok = pct_fmt(pwchars, pass);
+            }
+            if( ok &&
+                it_ != end_ &&
+                *it_ == '@')
+            {
+                ++it_;
+                p.has_user = true;
+                p.user = user;
+                p.has_pass = has_pass;
+                p.pass = pass;
+            }
+            else
+            {
+                restore(it0, c);
+            }
+        }
+
+        // host
+        if(it_ != end_)
+        {
+            auto const it0 = it_;
+            if(*it_ != '[')
+            {
+                if(! pct_fmt(uchars, p.host))
+                    return false;
+            }
+            else
+            {
+                auto const c = save();
+                core::string_view ip;
+                ++it_;
+                if( pct_fmt(pwchars, ip) &&
+                    it_ != end_ &&
+                    *it_ == ']')
+                    ++it_;
+                else
+                    restore(it0, c);
+                p.host = core::string_view(
+                    it0, it_ - it0);
+            }
+        }
+
+        // [ ":" port ]
+        if( it_ != end_ &&
+            *it_ == ':')
+        {
+            ++it_;
+            p.has_port = true;
+            p.port = fmt_token(
+                grammar::digit_chars);
+        }
+        return true;
+    }
+
+    // pattern_rule
+    BOOST_CXX14_CONSTEXPR
+    bool
+    pattern_rule(pattern& p) noexcept
+    {
+        using namespace constexpr_chars;
+
+        scheme(p);
+
+        if(it_ == end_)
+            return true;
+        if(end_ - it_ == 1)
+        {
+            if(*it_ == '/')
+            {
+                p.path = core::string_view(it_, 1);
+                ++it_;
+                return true;
+            }
+            if( ! p.scheme.empty() ||
+                *it_ != ':')
+            {
+                // a single segment
+                if(pchars(*it_))
+                {
+                    p.path = core::string_view(it_, 1);
+                    ++it_;
+                }
+                else if(*it_ == '%')
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        if( it_[0] == '/' &&
+            it_[1] == '/')
+        {
+            it_ += 2;
+            p.has_authority = true;
+            if(! authority(p))
+                return false;
+        }
+
+        if( it_ == end_ || (
+            p.has_authority &&
+            *it_ != '/' &&
+            *it_ != '?' &&
+            *it_ != '#'))
+            return true;
+
+        if(! pct_fmt(path_chars, p.path))
+            return false;
+
+        if( it_ != end_ &&
+            *it_ == '?')
+        {
+            ++it_;
+            p.has_query = true;
+            if(! pct_fmt(query_chars, p.query))
+                return false;
+        }
+
+        if( it_ != end_ &&
+            *it_ == '#')
+        {
+            ++it_;
+            p.has_frag = true;
+            if(! pct_fmt(fragment_chars, p.frag))
+                return false;
+        }
+        return true;
+    }
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
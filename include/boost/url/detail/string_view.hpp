@@ -21,6 +21,7 @@ namespace detail {
 // This is a workaround for GCC >=8.0 <8.4
 // See: https://github.com/boostorg/url/issues/672
 template<class T>
+BOOST_URL_CXX20_CONSTEXPR
 core::string_view
 to_sv(T const& t) noexcept
 {
@@ -54,6 +54,7 @@ struct BOOST_URL_DECL url_impl : parts_base
 
     from from_ = from::string;
 
+    BOOST_URL_CXX20_CONSTEXPR
     url_impl(
         from b) noexcept
         : from_(b)
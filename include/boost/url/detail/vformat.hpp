@@ -11,6 +11,7 @@
 #define BOOST_URL_DETAIL_FORMAT_HPP
 
 #include <boost/url/detail/format_args.hpp>
+#include <boost/url/detail/pattern.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/url/url.hpp>
 
@@ -36,6 +37,95 @@ vformat(
     return u;
 }
 
+#ifdef BOOST_URL_HAS_FORMAT_STRING
+
+// Calling these in a constant expression
+// is a compile error which names the
+// problem with the format string
+inline
+void
+format_string_is_invalid() noexcept
+{
+}
+
+inline
+void
+format_string_needs_more_arguments() noexcept
+{
+}
+
+template<class T>
+struct type_identity
+{
+    using type = T;
+};
+
+template<class T>
+using type_identity_t =
+    typename type_identity<T>::type;
+
+// The format string split into
+// components, for any arguments
+class format_string_base
+{
+protected:
+    pattern p_;
+    core::string_view s_;
+
+    constexpr
+    format_string_base() noexcept = default;
+
+public:
+    constexpr
+    pattern const&
+    get_pattern() const noexcept
+    {
+        return p_;
+    }
+
+    constexpr
+    core::string_view
+    get_string() const noexcept
+    {
+        return s_;
+    }
+};
+
+// Apply a pattern parsed during
+// compilation. This is out of line
+// so both overloads are traced alike.
+BOOST_URL_DECL
+void
+vformat_to(
+    url_base& u,
+    core::string_view fmt,
+    pattern const& p,
+    detail::format_args args);
+
+inline
+void
+vformat_to(
+    url_base& u,
+    format_string_base const& fmt,
+    detail::format_args args)
+{
+    vformat_to(u, fmt.get_string(),
+        fmt.get_pattern(), args);
+}
+
+inline
+url
+vformat(
+    format_string_base const& fmt,
+    detail::format_args args)
+{
+    url u;
+    vformat_to(u, fmt, args);
+    return u;
+}
+
+#endif
+
 } // detail
 } // url
 } // boost
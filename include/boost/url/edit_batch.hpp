@@ -0,0 +1,440 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_EDIT_BATCH_HPP
+#define BOOST_URL_EDIT_BATCH_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/ignore_case.hpp>
+#include <boost/url/param.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+class url_base;
+#endif
+
+/** A batch of changes to the params and segments of a url
+
+    Each modification made through
+    @ref params_ref or @ref segments_ref
+    resizes the buffer of the url and moves
+    every character after the change. Objects
+    of this type instead record many changes
+    to the query parameters and to the path
+    segments, and apply all of them at once
+    when @ref commit is called, with a single
+    resize of the buffer.
+
+    The resulting url is identical to the one
+    obtained by applying the same changes one
+    at a time, in the same order, through
+    `url_base::params` and `url_base::segments`.
+    Nothing is changed in the url until the
+    batch is committed; a batch which is
+    destroyed or cleared without being
+    committed discards its changes.
+
+    Changes are recorded against a copy of the
+    query or the path, made when the first
+    change to it is recorded. The url must not
+    be modified by other means while the batch
+    has pending changes.
+
+    @par Example
+    @code
+    url u( "https://www.example.com/api/v1?page=2&sort=asc&debug" );
+
+    edit_batch b( u );
+    b.set_param( "page", "3" );
+    b.erase_param( "debug" );
+    b.append_param( { "limit", "50" } );
+    b.erase_segment( 1 );
+    b.push_back_segment( "v2" );
+    b.commit();
+
+    assert( u.buffer() == "https://www.example.com/api/v2?page=3&sort=asc&limit=50" );
+    @endcode
+
+    @see
+        @ref params_ref,
+        @ref segments_ref.
+*/
+class edit_batch
+{
+    struct param
+    {
+        std::size_t key;
+        std::size_t nk;
+        std::size_t value;
+        std::size_t nv;
+        bool has_value;
+    };
+
+    struct segment
+    {
+        std::size_t pos;
+        std::size_t n;
+    };
+
+    url_base* u_;
+
+    // the encoded keys, values
+    // and segments, referenced
+    // by offset
+    std::string buf_;
+    std::vector<param> params_;
+    std::vector<segment> segs_;
+
+    // size of the path prefix,
+    // as in detail::path_prefix
+    std::size_t prefix_ = 0;
+
+    // true if the params or the
+    // segments have pending changes
+    bool has_params_ = false;
+    bool has_segs_ = false;
+
+    BOOST_URL_DECL
+    void
+    load_params();
+
+    BOOST_URL_DECL
+    void
+    load_segments();
+
+    BOOST_URL_DECL
+    bool
+    match(
+        param const& p,
+        core::string_view key,
+        ignore_case_param ic) const noexcept;
+
+    BOOST_URL_DECL
+    void
+    edit_segments(
+        std::size_t i0,
+        std::size_t i1,
+        core::string_view const* s);
+
+public:
+    /** Constructor
+
+        The batch references the url and
+        records no changes.
+        Ownership is not transferred; the
+        caller is responsible for ensuring
+        the lifetime of the url extends
+        until the batch is destroyed.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param u The url to change.
+    */
+    explicit
+    edit_batch(
+        url_base& u) noexcept
+        : u_(&u)
+    {
+    }
+
+    /** Constructor (deleted)
+    */
+    edit_batch(
+        edit_batch const&) = delete;
+
+    /** Assignment (deleted)
+    */
+    edit_batch&
+    operator=(
+        edit_batch const&) = delete;
+
+    /** Return the referenced url
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    url_base&
+    url() const noexcept
+    {
+        return *u_;
+    }
+
+    /** Return true if no changes are pending
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    bool
+    empty() const noexcept
+    {
+        return ! has_params_ &&
+            ! has_segs_;
+    }
+
+    //--------------------------------------------
+    //
+    // Params
+    //
+    //--------------------------------------------
+
+    /** Append a param
+
+        This records a change equivalent to
+        `u.params().append( p )`.
+        Reserved characters in the string are
+        percent-escaped in the result.
+
+        @par Complexity
+        Linear in `p.key.size() + p.value.size()`,
+        or in `this->url().encoded_query().size()`
+        if this is the first change to the
+        params.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param p The param to append.
+    */
+    BOOST_URL_DECL
+    void
+    append_param(
+        param_view const& p);
+
+    /** Set the value of a param by key
+
+        This records a change equivalent to
+        `u.params().set( key, value, ic )`:
+        the value of the first param with a
+        matching key is replaced, and every
+        other param with a matching key is
+        erased. If no param matches, a new
+        param is appended.
+
+        @par Complexity
+        Linear in the number of params.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param key The key to match.
+        By default, a case-sensitive
+        comparison is used.
+
+        @param value The value to assign.
+
+        @param ic An optional parameter. If
+        the value @ref ignore_case is passed
+        here, the comparison is
+        case-insensitive.
+    */
+    BOOST_URL_DECL
+    void
+    set_param(
+        core::string_view key,
+        core::string_view value,
+        ignore_case_param ic = {});
+
+    /** Erase params by key
+
+        This records a change equivalent to
+        `u.params().erase( key, ic )`.
+
+        @par Complexity
+        Linear in the number of params.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @return The number of params erased.
+
+        @param key The key to match.
+        By default, a case-sensitive
+        comparison is used.
+
+        @param ic An optional parameter. If
+        the value @ref ignore_case is passed
+        here, the comparison is
+        case-insensitive.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    erase_param(
+        core::string_view key,
+        ignore_case_param ic = {});
+
+    //--------------------------------------------
+    //
+    // Segments
+    //
+    //--------------------------------------------
+
+    /** Insert a segment
+
+        This records a change equivalent to
+        `u.segments().insert( std::next( u.segments().begin(), pos ), s )`,
+        where `pos` counts the segments
+        resulting from the changes recorded
+        so far.
+        Reserved characters in the string are
+        percent-escaped in the result.
+
+        @par Preconditions
+        `pos` is not greater than the number
+        of segments.
+
+        @par Complexity
+        Linear in the number of segments.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param pos The index of the new segment.
+
+        @param s The segment to insert.
+    */
+    BOOST_URL_DECL
+    void
+    insert_segment(
+        std::size_t pos,
+        core::string_view s);
+
+    /** Erase a segment
+
+        This records a change equivalent to
+        `u.segments().erase( std::next( u.segments().begin(), pos ) )`,
+        where `pos` counts the segments
+        resulting from the changes recorded
+        so far.
+
+        @par Preconditions
+        `pos` is less than the number of
+        segments.
+
+        @par Complexity
+        Linear in the number of segments.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param pos The index of the segment.
+    */
+    BOOST_URL_DECL
+    void
+    erase_segment(
+        std::size_t pos);
+
+    /** Append a segment
+
+        This records a change equivalent to
+        `u.segments().push_back( s )`.
+        Reserved characters in the string are
+        percent-escaped in the result.
+
+        @par Complexity
+        Linear in `s.size()`, or in
+        `this->url().encoded_path().size()`
+        if this is the first change to the
+        segments.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The segment to append.
+    */
+    BOOST_URL_DECL
+    void
+    push_back_segment(
+        core::string_view s);
+
+    /** Remove the last segment
+
+        This records a change equivalent to
+        `u.segments().pop_back()`.
+
+        @par Preconditions
+        There is at least one segment.
+
+        @par Complexity
+        Constant, or linear in
+        `this->url().encoded_path().size()`
+        if this is the first change to the
+        segments.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    void
+    pop_back_segment();
+
+    //--------------------------------------------
+
+    /** Apply the pending changes to the url
+
+        The path and the query of the url are
+        rewritten with the recorded changes,
+        with at most one resize of the buffer.
+        Afterwards, no changes are pending
+        and the batch can be reused.
+
+        @par Complexity
+        Linear in `this->url().size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw system_error
+        The resulting url would exceed the
+        maximum size.
+    */
+    BOOST_URL_DECL
+    void
+    commit();
+
+    /** Discard the pending changes
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    BOOST_URL_DECL
+    void
+    clear() noexcept;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -15,10 +15,121 @@
 #include <boost/url/url.hpp>
 #include <boost/url/detail/vformat.hpp>
 #include <initializer_list>
+#include <type_traits>
 
 namespace boost {
 namespace urls {
 
+#ifdef BOOST_URL_HAS_FORMAT_STRING
+
+/** A format URL string checked at compile time
+
+    This is the type of the format URL string
+    passed to @ref format and @ref format_to
+    when the compiler supports `consteval`.
+
+    A string literal is parsed during
+    compilation. The URL components to which
+    the replacement fields belong, and the
+    size of the text between them, are
+    determined once, so formatting only
+    measures and writes the arguments. A
+    format string which is invalid, or which
+    refers to more arguments than are passed,
+    is a compile error.
+
+    Any other string is parsed when the
+    format string is constructed.
+
+    @par Example
+    @code
+    url u = format( "{}://{}:{}/rfc/{}", "https", "www.ietf.org", 80, "rfc2396.txt" );
+
+    // error: the format string needs more arguments
+    // url v = format( "{}://{}", "https" );
+    @endcode
+
+    @tparam Args The types of the arguments
+
+    @see
+        @ref format,
+        @ref format_to.
+*/
+template<class... Args>
+class basic_format_string
+#ifndef BOOST_URL_DOCS
+    : public detail::format_string_base
+#endif
+{
+public:
+    /** Constructor
+
+        The format string is parsed during
+        compilation.
+
+        @param s The format URL string
+    */
+    template<std::size_t N>
+    consteval
+    basic_format_string(
+        char const(&s)[N]) noexcept
+    {
+        s_ = core::string_view(s);
+        detail::constexpr_pattern_parser p(s_);
+        if(! p.parse(p_))
+            detail::format_string_is_invalid();
+        if( p.automatic_ids() > sizeof...(Args) ||
+            p.indexed_args() > sizeof...(Args))
+            detail::format_string_needs_more_arguments();
+    }
+
+    /** Constructor
+
+        The format string is parsed when
+        this object is constructed.
+
+        @throws system_error
+        `s` is not a valid format string.
+
+        @param s The format URL string
+    */
+    template<
+        class String
+#ifndef BOOST_URL_DOCS
+        , class = typename std::enable_if<
+            std::is_convertible<
+                String const&,
+                core::string_view>::value>::type
+#endif
+    >
+    basic_format_string(
+        String const& s)
+    {
+        s_ = s;
+        p_ = detail::parse_pattern(s_).value();
+    }
+
+    /** Return the format URL string
+    */
+    constexpr
+    core::string_view
+    get() const noexcept
+    {
+        return s_;
+    }
+};
+
+/** A format URL string for the arguments
+
+    @see
+        @ref basic_format_string.
+*/
+template<class... Args>
+using format_string = basic_format_string<
+    detail::type_identity_t<Args>...>;
+
+#endif
+
 /** Format arguments into a URL
 
     Format arguments according to the format
@@ -46,6 +157,11 @@ namespace urls {
     assert(format("{}", "Hello world!").buffer() == "Hello%20world%21");
     @endcode
 
+    When the compiler supports `consteval`,
+    a string literal used as the format URL
+    string is checked during compilation.
+    See @ref basic_format_string.
+
     @par Preconditions
     All replacement fields must be valid and the
     resulting URL should be valid after arguments
@@ -90,7 +206,11 @@ namespace urls {
 template <class... Args>
 url
 format(
+#ifdef BOOST_URL_HAS_FORMAT_STRING
+    format_string<Args...> fmt,
+#else
     core::string_view fmt,
+#endif
     Args&&... args)
 {
     return detail::vformat(
@@ -127,6 +247,11 @@ format(
     assert(u.buffer() == "Hello%20world%21");
     @endcode
 
+    When the compiler supports `consteval`,
+    a string literal used as the format URL
+    string is checked during compilation.
+    See @ref basic_format_string.
+
     @par Preconditions
     All replacement fields must be valid and the
     resulting URL should be valid after arguments
@@ -174,7 +299,11 @@ template <class... Args>
 void
 format_to(
     url_base& u,
+#ifdef BOOST_URL_HAS_FORMAT_STRING
+    format_string<Args...> fmt,
+#else
     core::string_view fmt,
+#endif
     Args&&... args)
 {
     detail::vformat_to(
@@ -10,6 +10,9 @@
 #ifndef BOOST_URL_GRAMMAR_DETAIL_RECYCLED_HPP
 #define BOOST_URL_GRAMMAR_DETAIL_RECYCLED_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 
 namespace boost {
@@ -53,6 +56,92 @@ nearest_pow2(
 
 //------------------------------------------------
 
+// The number of thread caches in a recycle
+// bin. Threads beyond this share caches.
+#if !defined(BOOST_URL_DISABLE_THREADS)
+constexpr std::size_t recycled_caches = 64;
+#else
+constexpr std::size_t recycled_caches = 1;
+#endif
+
+// Return the index of the cache of the
+// calling thread, which is assigned the
+// first time a thread calls it
+BOOST_URL_DECL
+std::size_t
+recycled_thread_index() noexcept;
+
+// A cache is only written by one thread
+// unless there are more threads than
+// caches, and then an increment may be
+// lost, which is fine for statistics.
+inline
+void
+recycled_count(
+    std::atomic<std::size_t>& n) noexcept
+{
+    n.store(n.load(
+        std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+}
+
+// The top of the shared stack of a recycle
+// bin is packed with a version, which
+// changes on every push and pop. A pop
+// whose compare-exchange sees the version
+// it read knows the top was not popped and
+// pushed again meanwhile (the ABA problem).
+// On 64-bit targets the address uses the
+// low 48 bits, which holds user space
+// addresses on common platforms, and the
+// version the high 16 bits.
+constexpr unsigned recycled_addr_bits =
+    sizeof(void*) < 8 ? 8 * sizeof(void*) : 48;
+
+constexpr std::uint64_t recycled_addr_mask =
+    (std::uint64_t(1) << recycled_addr_bits) - 1;
+
+// Return true if p can be packed
+inline
+bool
+recycled_packable(
+    void const* p) noexcept
+{
+    return (static_cast<std::uint64_t>(
+        reinterpret_cast<std::uintptr_t>(p)) &
+            ~recycled_addr_mask) == 0;
+}
+
+inline
+std::uint64_t
+recycled_pack(
+    void const* p,
+    std::uint64_t version) noexcept
+{
+    return
+        (version << recycled_addr_bits) |
+        static_cast<std::uint64_t>(
+            reinterpret_cast<std::uintptr_t>(p));
+}
+
+inline
+void*
+recycled_addr(
+    std::uint64_t h) noexcept
+{
+    return reinterpret_cast<void*>(
+        static_cast<std::uintptr_t>(
+            h & recycled_addr_mask));
+}
+
+inline
+std::uint64_t
+recycled_next_version(
+    std::uint64_t h) noexcept
+{
+    return (h >> recycled_addr_bits) + 1;
+}
+
 BOOST_URL_DECL
 void
 recycled_add_impl(
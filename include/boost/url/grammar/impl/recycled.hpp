@@ -23,14 +23,32 @@ recycled<T>::
 ~recycled()
 {
     std::size_t n = 0;
+    for(auto& c : caches_)
+    {
+        for(auto& u : c.u)
+        {
+            U* it = u.load(
+                std::memory_order_acquire);
+            if(it)
+            {
+                ++n;
+                BOOST_ASSERT(
+                    it->refs == 0);
+                delete it;
+            }
+        }
+    }
     // VFALCO we should probably deallocate
     // in reverse order of allocation but
     // that requires a doubly-linked list.
-    auto it = head_;
+    auto it = static_cast<U*>(
+        detail::recycled_addr(head_.load(
+            std::memory_order_acquire)));
     while(it)
     {
         ++n;
-        auto next = it->next;
+        auto next = it->next.load(
+            std::memory_order_relaxed);
         BOOST_ASSERT(
             it->refs == 0);
         delete it;
@@ -40,32 +58,98 @@ recycled<T>::
         sizeof(U) * n);
 }
 
+template<class T>
+recycled_stats
+recycled<T>::
+stats() const noexcept
+{
+    recycled_stats r;
+    for(auto const& c : caches_)
+    {
+        r.hits += c.hits.load(
+            std::memory_order_relaxed);
+        r.shared_hits += c.shared_hits.load(
+            std::memory_order_relaxed);
+        r.misses += c.misses.load(
+            std::memory_order_relaxed);
+        r.cross_thread_returns += c.cross.load(
+            std::memory_order_relaxed);
+    }
+    return r;
+}
+
+template<class T>
+auto
+recycled<T>::
+pop() noexcept ->
+    U*
+{
+    std::uint64_t h = head_.load(
+        std::memory_order_acquire);
+    for(;;)
+    {
+        U* p = static_cast<U*>(
+            detail::recycled_addr(h));
+        if(! p)
+            return nullptr;
+        // if p was popped since h was read,
+        // the version changed and this
+        // compare-exchange fails
+        std::uint64_t const next =
+            detail::recycled_pack(
+                p->next.load(
+                    std::memory_order_relaxed),
+                detail::recycled_next_version(h));
+        if(head_.compare_exchange_weak(
+            h, next,
+            std::memory_order_acquire,
+            std::memory_order_acquire))
+            return p;
+    }
+}
+
 template<class T>
 auto
 recycled<T>::
 acquire() ->
     U*
 {
-    U* p;
+    std::size_t const i =
+        detail::recycled_thread_index();
+    cache& c = caches_[i];
+    U* p = nullptr;
+    for(auto& u : c.u)
     {
-#if !defined(BOOST_URL_DISABLE_THREADS)
-        std::lock_guard<
-            std::mutex> lock(m_);
-#endif
-        p = head_;
+        if( u.load(std::memory_order_relaxed) &&
+            (p = u.exchange(nullptr,
+                std::memory_order_acquire)))
+            break;
+    }
+    if(p)
+    {
+        // reuse
+        detail::recycled_count(c.hits);
+    }
+    else
+    {
+        p = pop();
         if(p)
         {
-            // reuse
-            head_ = head_->next;
-            detail::recycled_remove(
-                sizeof(U));
-            ++p->refs;
-        }
-        else
-        {
-            p = new U;
+            detail::recycled_count(c.shared_hits);
         }
     }
+    if(p)
+    {
+        detail::recycled_remove(
+            sizeof(U));
+        ++p->refs;
+    }
+    else
+    {
+        p = new U;
+        detail::recycled_count(c.misses);
+    }
+    p->owner = i;
     BOOST_ASSERT(p->refs == 1);
     return p;
 }
@@ -77,16 +161,47 @@ release(U* u) noexcept
 {
     if(--u->refs != 0)
         return;
+    std::size_t const i =
+        detail::recycled_thread_index();
+    cache& c = caches_[i];
+    if(u->owner != i)
+        detail::recycled_count(c.cross);
+    for(auto& v : c.u)
     {
-#if !defined(BOOST_URL_DISABLE_THREADS)
-        std::lock_guard<
-            std::mutex> lock(m_);
-#endif
-        u->next = head_;
-        head_ = u;
+        U* empty = nullptr;
+        if( ! v.load(std::memory_order_relaxed) &&
+            v.compare_exchange_strong(
+                empty, u,
+                std::memory_order_release,
+                std::memory_order_relaxed))
+        {
+            detail::recycled_add(
+                sizeof(U));
+            return;
+        }
+    }
+    if(! detail::recycled_packable(u))
+    {
+        // the address does not fit
+        // beside the version
+        delete u;
+        return;
     }
     detail::recycled_add(
         sizeof(U));
+    std::uint64_t h = head_.load(
+        std::memory_order_relaxed);
+    do
+    {
+        u->next.store(static_cast<U*>(
+            detail::recycled_addr(h)),
+            std::memory_order_relaxed);
+    }
+    while(! head_.compare_exchange_weak(
+        h, detail::recycled_pack(u,
+            detail::recycled_next_version(h)),
+        std::memory_order_release,
+        std::memory_order_relaxed));
 }
 
 //------------------------------------------------
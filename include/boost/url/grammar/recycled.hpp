@@ -14,13 +14,10 @@
 #include <boost/url/grammar/detail/recycled.hpp>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <stddef.h> // ::max_align_t
 
-#if !defined(BOOST_URL_DISABLE_THREADS)
-# include <mutex>
-#endif
-
 namespace boost {
 namespace urls {
 namespace grammar {
@@ -50,12 +47,44 @@ using aligned_storage =
 
 //------------------------------------------------
 
+/** Counters describing the use of a recycle bin
+
+    @see
+        @ref recycled::stats.
+*/
+struct recycled_stats
+{
+    /** Objects reused from the cache of the acquiring thread
+    */
+    std::size_t hits = 0;
+
+    /** Objects reused from the stack shared by all threads
+    */
+    std::size_t shared_hits = 0;
+
+    /** Objects which were newly allocated
+    */
+    std::size_t misses = 0;
+
+    /** Objects released by a thread other than the one which acquired them
+    */
+    std::size_t cross_thread_returns = 0;
+};
+
+//------------------------------------------------
+
 /** A thread-safe collection of instances of T
 
     Instances of this type may be used to control
     where recycled instances of T come from when
     used with @ref recycled_ptr.
 
+    Each thread has a cache in the bin holding
+    the last few instances it released, which
+    it reuses without synchronizing with other
+    threads. Other instances are kept in a
+    lock-free stack shared by all threads.
+
     @par Example
     @code
     static recycled< std::string > bin;
@@ -86,6 +115,20 @@ public:
     */
     constexpr recycled() = default;
 
+    /** Return the counters of this bin
+
+        The counters are updated without
+        synchronization, so the result is only
+        exact when no other thread is using the
+        bin, and when fewer threads than the
+        number of caches have used it.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    recycled_stats
+    stats() const noexcept;
+
 private:
     template<class>
     friend class recycled_ptr;
@@ -93,7 +136,14 @@ private:
     struct U
     {
         T t;
-        U* next = nullptr;
+
+        // read by a pop which lost
+        // the race for this instance
+        std::atomic<U*> next{nullptr};
+
+        // the cache of the thread
+        // which acquired it
+        std::size_t owner = 0;
 
 #if !defined(BOOST_URL_DISABLE_THREADS)
         std::atomic<
@@ -109,16 +159,30 @@ private:
         }
     };
 
-    struct report;
+    // Each cache is on its own cache line,
+    // so threads do not write to the same
+    // line as long as there are fewer of
+    // them than caches.
+    struct alignas(64) cache
+    {
+        std::atomic<U*> u[4] = {};
+        std::atomic<std::size_t> hits{0};
+        std::atomic<std::size_t> shared_hits{0};
+        std::atomic<std::size_t> misses{0};
+        std::atomic<std::size_t> cross{0};
+    };
 
     U* acquire();
     void release(U* u) noexcept;
+    U* pop() noexcept;
 
-    U* head_ = nullptr;
+    cache caches_[detail::recycled_caches];
 
-#if !defined(BOOST_URL_DISABLE_THREADS)
-    std::mutex m_;
-#endif
+    // The shared stack, with its top packed
+    // with a version. Instances are only
+    // deleted with the bin, so a pop can
+    // read the next of a popped instance.
+    std::atomic<std::uint64_t> head_{0};
 };
 
 //------------------------------------------------
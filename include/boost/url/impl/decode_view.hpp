@@ -128,6 +128,124 @@ public:
 
 //------------------------------------------------
 
+class decode_view::span_iterator
+{
+    char const* pos_ = nullptr;
+    char const* end_ = nullptr;
+    std::size_t n_ = 0;
+    char c_ = 0;
+    bool decoded_ = false;
+    bool space_as_plus_ = true;
+
+    friend decode_view;
+
+    span_iterator(
+        char const* pos,
+        char const* end,
+        bool space_as_plus) noexcept
+        : pos_(pos)
+        , end_(end)
+        , space_as_plus_(space_as_plus)
+    {
+        load();
+    }
+
+    BOOST_URL_DECL
+    void
+    load() noexcept;
+
+public:
+    using value_type = core::string_view;
+    using reference = core::string_view;
+    using pointer = void const*;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::input_iterator_tag;
+
+    span_iterator() = default;
+
+    span_iterator(span_iterator const&) = default;
+
+    span_iterator&
+    operator=(span_iterator const&) = default;
+
+    reference
+    operator*() const noexcept
+    {
+        BOOST_ASSERT(pos_ != end_);
+        if(decoded_)
+            return { &c_, 1 };
+        return { pos_, n_ };
+    }
+
+    span_iterator&
+    operator++() noexcept
+    {
+        BOOST_ASSERT(pos_ != end_);
+        pos_ += n_;
+        load();
+        return *this;
+    }
+
+    span_iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    /** Return true if the span is a decoded character
+    */
+    bool
+    decoded() const noexcept
+    {
+        return decoded_;
+    }
+
+    /** Return the encoded characters of the span
+    */
+    core::string_view
+    encoded() const noexcept
+    {
+        return { pos_, n_ };
+    }
+
+    bool
+    operator==(
+        span_iterator const& other) const noexcept
+    {
+        return pos_ == other.pos_;
+    }
+
+    bool
+    operator!=(
+        span_iterator const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+//------------------------------------------------
+
+inline
+auto
+decode_view::
+span_begin() const noexcept ->
+    span_iterator
+{
+    return { p_, p_ + n_, space_as_plus_ };
+}
+
+inline
+auto
+decode_view::
+span_end() const noexcept ->
+    span_iterator
+{
+    return { p_ + n_, p_ + n_, space_as_plus_ };
+}
+
 inline
 auto
 decode_view::
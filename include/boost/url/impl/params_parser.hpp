@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_IMPL_PARAMS_PARSER_HPP
+#define BOOST_URL_IMPL_PARAMS_PARSER_HPP
+
+namespace boost {
+namespace urls {
+
+template<class Handler>
+system::result<std::size_t>
+params_parser::
+put(
+    core::string_view s,
+    Handler&& h)
+{
+    char const* it = s.data();
+    char const* const end = it + s.size();
+    std::size_t n = 0;
+    param_pct_view p;
+    for(;;)
+    {
+        auto rv = parse(it, end, p);
+        if(! rv)
+            return rv.error();
+        if(! *rv)
+            break;
+        h(static_cast<
+            param_pct_view const&>(p));
+        ++n;
+    }
+    return n;
+}
+
+template<class Handler>
+system::result<std::size_t>
+params_parser::
+finish(Handler&& h)
+{
+    param_pct_view p;
+    auto rv = parse_last(p);
+    if(! rv)
+        return rv.error();
+    if(! *rv)
+        return 0;
+    h(static_cast<
+        param_pct_view const&>(p));
+    reset();
+    return 1;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_IMPL_SINK_HPP
+#define BOOST_URL_IMPL_SINK_HPP
+
+#include <boost/url/detail/encode.hpp>
+#include <boost/url/grammar/charset.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+template<class MutableBufferSequence>
+buffers_sink<MutableBufferSequence>::
+buffers_sink(
+    MutableBufferSequence const& bs) noexcept
+    : it_(std::begin(bs))
+    , end_(std::end(bs))
+{
+    next();
+}
+
+// skip to the next buffer
+// which is not empty
+template<class MutableBufferSequence>
+void
+buffers_sink<MutableBufferSequence>::
+next() noexcept
+{
+    while( n_ == 0 &&
+        it_ != end_)
+    {
+        auto const& b = *it_++;
+        p_ = static_cast<char*>(b.data());
+        n_ = b.size();
+    }
+}
+
+template<class MutableBufferSequence>
+std::size_t
+buffers_sink<MutableBufferSequence>::
+write(
+    char const* data,
+    std::size_t n) noexcept
+{
+    std::size_t const n0 = n;
+    while( n != 0 &&
+        n_ != 0)
+    {
+        std::size_t const m =
+            n < n_ ? n : n_;
+        std::memcpy(p_, data, m);
+        p_ += m;
+        n_ -= m;
+        data += m;
+        n -= m;
+        next();
+    }
+    size_ += n0 - n;
+    return n0 - n;
+}
+
+//------------------------------------------------
+
+template<class Sink>
+bool
+string_writer::
+write(Sink& sink)
+{
+    std::size_t const n =
+        sink.write(s_.data(), s_.size());
+    s_.remove_prefix(n);
+    return s_.empty();
+}
+
+//------------------------------------------------
+
+template<class CharSet>
+template<class Sink>
+bool
+encode_writer<CharSet>::
+write(Sink& sink)
+{
+/*  If you get a compile error here, it
+    means that the value you passed does
+    not meet the requirements stated in
+    the documentation.
+*/
+    static_assert(
+        grammar::is_charset<CharSet>::value,
+        "Type requirements not met");
+
+    // '%' must be reserved
+    BOOST_ASSERT(! cs_('%'));
+
+    // the rest of an escape
+    if(esc_pos_ != esc_end_)
+    {
+        esc_pos_ += static_cast<unsigned char>(
+            sink.write(esc_ + esc_pos_,
+                esc_end_ - esc_pos_));
+        if(esc_pos_ != esc_end_)
+            return false;
+    }
+
+    char const* const hex =
+        detail::hexdigs[opt_.lower_case];
+    bool const plus =
+        opt_.space_as_plus && ! cs_(' ');
+    char const* it = s_.data();
+    char const* const end = it + s_.size();
+    while(it != end)
+    {
+        // unreserved characters are
+        // written as a single run
+        char const* const first = it;
+        while( it != end &&
+                cs_(*it))
+            ++it;
+        if(it != first)
+        {
+            std::size_t const n = it - first;
+            std::size_t const m =
+                sink.write(first, n);
+            if(m != n)
+            {
+                s_ = core::string_view(
+                    first + m, end - first - m);
+                return false;
+            }
+        }
+        if(it == end)
+            break;
+        unsigned char const c = *it++;
+        if( plus &&
+            c == ' ')
+        {
+            esc_[0] = '+';
+            esc_end_ = 1;
+        }
+        else
+        {
+            esc_[0] = '%';
+            esc_[1] = hex[c>>4];
+            esc_[2] = hex[c&0xf];
+            esc_end_ = 3;
+        }
+        esc_pos_ = static_cast<unsigned char>(
+            sink.write(esc_, esc_end_));
+        if(esc_pos_ != esc_end_)
+        {
+            s_ = core::string_view(
+                it, end - it);
+            return false;
+        }
+    }
+    s_ = {};
+    return true;
+}
+
+//------------------------------------------------
+
+template<class Sink>
+bool
+decode_writer::
+write(Sink& sink)
+{
+    char const* it = s_.data();
+    char const* const end = it + s_.size();
+    while(it != end)
+    {
+        // characters which are not
+        // escaped are written as a
+        // single run
+        char const* const first = it;
+        while( it != end &&
+            *it != '%' &&
+            ! (*it == '+' && opt_.space_as_plus))
+            ++it;
+        if(it != first)
+        {
+            std::size_t const n = it - first;
+            std::size_t const m =
+                sink.write(first, n);
+            if(m != n)
+            {
+                s_ = core::string_view(
+                    first + m, end - first - m);
+                return false;
+            }
+        }
+        if(it == end)
+            break;
+        char c = ' ';
+        std::size_t n = 1;
+        if(*it == '%')
+        {
+            BOOST_ASSERT(end - it >= 3);
+            c = static_cast<char>(
+                (grammar::hexdig_value(it[1]) << 4) +
+                grammar::hexdig_value(it[2]));
+            n = 3;
+        }
+        if(sink.write(&c, 1) != 1)
+        {
+            s_ = core::string_view(
+                it, end - it);
+            return false;
+        }
+        it += n;
+    }
+    s_ = {};
+    return true;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_ARENA_HPP
+#define BOOST_URL_IMPL_URL_ARENA_HPP
+
+#include <boost/url/url_view_base.hpp>
+
+namespace boost {
+namespace urls {
+
+template<class InputIt, class OutputIt>
+OutputIt
+url_arena::
+persist(
+    InputIt first,
+    InputIt last,
+    OutputIt out)
+{
+    return persist_impl(
+        first, last, out,
+        typename std::iterator_traits<
+            InputIt>::iterator_category{});
+}
+
+template<class InputIt, class OutputIt>
+OutputIt
+url_arena::
+persist_impl(
+    InputIt first,
+    InputIt last,
+    OutputIt out,
+    std::input_iterator_tag)
+{
+    for(; first != last; ++first)
+        *out++ = persist(*first);
+    return out;
+}
+
+template<class InputIt, class OutputIt>
+OutputIt
+url_arena::
+persist_impl(
+    InputIt first,
+    InputIt last,
+    OutputIt out,
+    std::forward_iterator_tag)
+{
+    std::size_t n = 0;
+    for(auto it = first; it != last; ++it)
+    {
+        url_view_base const& u = *it;
+        n += u.size();
+    }
+    reserve(n);
+    return persist_impl(
+        first, last, out,
+        std::input_iterator_tag{});
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_ORIGIN_FORM_PARSER_HPP
+#define BOOST_URL_ORIGIN_FORM_PARSER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error_types.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** An incremental parser for origin-form
+
+    This parser accepts a request-target in
+    origin-form as a sequence of chunks, such
+    as the successive reads of an HTTP/1
+    request-line. The state of the grammar is
+    saved between chunks so that no character
+    is examined twice, and the characters are
+    copied into a buffer owned by the caller,
+    which is referenced by the resulting view.
+
+    A chunk is consumed up to the first
+    character which cannot be part of the
+    target, such as the space which follows
+    it in a request-line. Errors are reported
+    as soon as the chunk which contains them
+    is received, including targets which are
+    larger than the buffer.
+
+    @par Example
+    @code
+    char buf[ 1024 ];
+    origin_form_parser p( buf, sizeof(buf) );
+
+    p.put( "/index" ).value();
+    std::size_t n = p.put( ".htm?layout=mobile HTTP/1.1\r\n" ).value();
+    assert( n == 18 );
+    assert( p.done() );
+
+    url_view u = p.finish().value();
+    assert( u.buffer() == "/index.htm?layout=mobile" );
+    @endcode
+
+    @par BNF
+    @code
+    origin-form    = absolute-path [ "?" query ]
+
+    absolute-path = 1*( "/" segment )
+    @endcode
+
+    @par Specification
+    @li <a href="https://datatracker.ietf.org/doc/html/rfc7230#section-5.3.1"
+        >5.3.1.  origin-form (rfc7230)</a>
+
+    @see
+        @ref origin_form_rule,
+        @ref parse_origin_form.
+*/
+class BOOST_URL_DECL origin_form_parser
+{
+public:
+    /** Constructor
+
+        The buffer must remain valid while
+        the parser and the views it returns
+        are in use.
+
+        @param buf The buffer which receives
+        the characters of the target
+
+        @param size The size of the buffer,
+        which is the largest target accepted
+    */
+    origin_form_parser(
+        char* buf,
+        std::size_t size) noexcept;
+
+    /** Constructor
+
+        @param buf The buffer which receives
+        the characters of the target
+    */
+    template<std::size_t N>
+    explicit
+    origin_form_parser(
+        char (&buf)[N]) noexcept
+        : origin_form_parser(buf, N)
+    {
+    }
+
+    /** Parse a chunk of the target
+
+        The characters of `s` which belong
+        to the target are validated and
+        appended to the buffer. When a
+        character is found which ends the
+        target, @ref done returns `true` and
+        the rest of the chunk is not consumed.
+
+        Once an error is returned, subsequent
+        calls return the same error until the
+        parser is reset.
+
+        @par Complexity
+        Linear in the number of characters
+        consumed.
+
+        @return The number of characters
+        consumed, or an error if the target
+        is invalid or does not fit in the
+        buffer.
+
+        @param s The chunk
+    */
+    system::result<std::size_t>
+    put(core::string_view s) noexcept;
+
+    /** Return the view of the target
+
+        This completes the target, which
+        ends with the last character consumed.
+        If @ref done is `false`, the end of
+        the input is taken as the end of the
+        target.
+
+        @par Complexity
+        Constant.
+
+        @return A view referencing the buffer,
+        or an error if the target is incomplete.
+    */
+    system::result<url_view>
+    finish() noexcept;
+
+    /** Prepare the parser for a new target
+
+        The views previously returned
+        reference characters which will
+        be overwritten.
+    */
+    void
+    reset() noexcept;
+
+    /** Return true if the end of the target was found
+    */
+    bool
+    done() const noexcept
+    {
+        return st_ == state::done;
+    }
+
+    /** Return the number of characters consumed
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return the size of the buffer
+    */
+    std::size_t
+    capacity() const noexcept
+    {
+        return cap_;
+    }
+
+private:
+    enum class state : unsigned char
+    {
+        start,
+        path,
+        path_pct1,
+        path_pct2,
+        query,
+        query_pct1,
+        query_pct2,
+        done,
+        failed
+    };
+
+    char* buf_;
+    std::size_t cap_;
+    std::size_t size_ = 0;
+    std::size_t path_size_ = 0;
+    std::size_t path_dn_ = 0;
+    std::size_t query_dn_ = 0;
+    std::size_t nseg_ = 0;
+    std::size_t nparam_ = 0;
+    system::error_code ec_;
+    state st_ = state::start;
+    bool has_query_ = false;
+};
+
+} // urls
+} // boost
+
+#endif
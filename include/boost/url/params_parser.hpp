@@ -0,0 +1,224 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_PARAMS_PARSER_HPP
+#define BOOST_URL_PARAMS_PARSER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/encoding_opts.hpp>
+#include <boost/url/error_types.hpp>
+#include <boost/url/param.hpp>
+#include <boost/url/pct_string_view.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** An incremental parser for params
+
+    This parser accepts a query, such as an
+    application/x-www-form-urlencoded request
+    body, as a sequence of chunks and calls
+    a handler with each param as soon as it
+    is complete. The input is never stored
+    as a whole.
+
+    The key and value of a param which is
+    contained in a single chunk reference
+    the chunk. A param which is split across
+    chunks is assembled in a buffer owned
+    by the caller, whose size is the only
+    memory used by the parser, and which
+    limits the size of such params.
+
+    The handler is invoked with the
+    signature:
+    @code
+    void( param_pct_view const& p );
+    @endcode
+    The key and the value are only valid
+    until the handler returns.
+
+    @par Example
+    @code
+    char buf[ 4096 ];
+    params_parser p( buf, sizeof(buf), encoding_opts( true ) );
+    auto h = [&p]( param_pct_view const& pv )
+    {
+        char value[ 256 ];
+        std::size_t n = p.decode( pv.value, value, sizeof(value) ).value();
+        assert( core::string_view( value, n ) == "John Doe" );
+    };
+
+    p.put( "name=John+D", h ).value();
+    p.put( "oe", h ).value();
+    p.finish( h ).value();
+    @endcode
+
+    @par BNF
+    @code
+    query           = *( pchar / "/" / "?" )
+
+    query-params    = [ query-param ] *( "&" query-param )
+    query-param     = key [ "=" value ]
+    key             = *qpchar
+    value           = *( qpchar / "=" )
+    @endcode
+
+    @par Specification
+    @li <a href="https://en.wikipedia.org/wiki/Query_string"
+        >Query string (Wikipedia)</a>
+    @li <a href="https://www.w3.org/TR/html401/interact/forms.html#h-17.13.4.1">
+        application/x-www-form-urlencoded (w3.org)</a>
+
+    @see
+        @ref param_pct_view,
+        @ref parse_query.
+*/
+class BOOST_URL_DECL params_parser
+{
+public:
+    /** Constructor
+
+        The buffer must remain valid while
+        the parser is in use.
+
+        @param buf The buffer which receives
+        params split across chunks
+
+        @param size The size of the buffer
+
+        @param opt The options used by
+        @ref decode
+    */
+    params_parser(
+        char* buf,
+        std::size_t size,
+        encoding_opts opt = {}) noexcept;
+
+    /** Parse a chunk of the params
+
+        The handler is invoked for each param
+        completed by the chunk. The last param
+        of a chunk is held until it is completed
+        by a subsequent chunk or by @ref finish.
+
+        Once an error is returned, subsequent
+        calls return the same error until the
+        parser is reset.
+
+        @par Complexity
+        Linear in `s.size()`.
+
+        @return The number of params emitted,
+        or an error if the params are invalid
+        or a param split across chunks does not
+        fit in the buffer.
+
+        @param s The chunk
+
+        @param h The handler
+    */
+    template<class Handler>
+    system::result<std::size_t>
+    put(
+        core::string_view s,
+        Handler&& h);
+
+    /** Complete the params
+
+        The handler is invoked with the last
+        param, if any, and the parser is reset.
+
+        @return The number of params emitted,
+        or an error if the input ends within
+        a percent-escape.
+
+        @param h The handler
+    */
+    template<class Handler>
+    system::result<std::size_t>
+    finish(Handler&& h);
+
+    /** Prepare the parser for new params
+    */
+    void
+    reset() noexcept;
+
+    /** Decode a key or value into a buffer
+
+        The string is decoded using the
+        options of the parser, so plus signs
+        are decoded as spaces when
+        @ref encoding_opts::space_as_plus
+        is set.
+
+        @return The size of the decoded
+        string, or an error if it does not
+        fit in the buffer.
+
+        @param s The key or value
+
+        @param dest The buffer
+
+        @param size The size of the buffer
+    */
+    system::result<std::size_t>
+    decode(
+        pct_string_view s,
+        char* dest,
+        std::size_t size) const noexcept;
+
+private:
+    system::result<bool>
+    parse(
+        char const*& it,
+        char const* end,
+        param_pct_view& p) noexcept;
+
+    system::result<bool>
+    parse_last(
+        param_pct_view& p) noexcept;
+
+    void
+    clear_param() noexcept;
+
+    param_pct_view
+    make_param(
+        char const* data,
+        std::size_t size) const noexcept;
+
+    char* buf_;
+    std::size_t cap_;
+    encoding_opts opt_;
+
+    // the part of the current
+    // param in the buffer
+    std::size_t size_ = 0;
+
+    // the current param
+    std::size_t key_size_ = 0;
+    std::size_t key_dn_ = 0;
+    std::size_t value_dn_ = 0;
+    bool has_value_ = false;
+
+    system::error_code ec_;
+    unsigned char pct_ = 0;
+    bool any_ = false;
+    bool emitted_ = false;
+    bool failed_ = false;
+};
+
+} // urls
+} // boost
+
+#include <boost/url/impl/params_parser.hpp>
+
+#endif
@@ -913,6 +913,41 @@ public:
         core::string_view value,
         ignore_case_param ic = {});
 
+    /** Sort the params by key
+
+        This function sorts the params by
+        their keys, compared as if they were
+        percent-decoded. Params with equal
+        keys keep their order, so the values
+        of a key which appears more than once
+        are not reordered.
+
+        The params are reordered inside the
+        buffer of the url, which does not
+        change size.
+
+        <br>
+        All iterators are invalidated.
+
+        @par Example
+        @code
+        url u( "?last=Doe&first=John&first=Jane" );
+
+        u.params().sort();
+
+        assert( u.encoded_query() == "first=John&first=Jane&last=Doe" );
+        @endcode
+
+        @par Complexity
+        `n log n` in `this->size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    void
+    sort();
+
     //--------------------------------------------
 
 private:
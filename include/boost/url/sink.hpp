@@ -0,0 +1,401 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_SINK_HPP
+#define BOOST_URL_SINK_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/encoding_opts.hpp>
+#include <boost/url/pct_string_view.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+/** A sink which writes to a single buffer
+
+    This sink writes characters to a buffer
+    until it is full. A buffer of fixed size
+    can be reused for successive chunks of
+    the same output by resuming a writer
+    with a new sink.
+
+    Types which meet the requirements of
+    <em>Sink</em> provide this member
+    function, which returns the number of
+    characters written, less than `n` only
+    when the sink is full:
+    @code
+    std::size_t write( char const* data, std::size_t n );
+    @endcode
+
+    @par Example
+    @code
+    char buf[ 8 ];
+    encode_writer< decltype(pchars) > w( "a path/with spaces", pchars );
+    std::string s;
+    for(;;)
+    {
+        buffer_sink b( buf, sizeof(buf) );
+        bool done = w.write( b );
+        s.append( buf, b.size() );
+        if( done )
+            break;
+    }
+    assert( s == "a%20path%2Fwith%20spaces" );
+    @endcode
+
+    @see
+        @ref buffers_sink,
+        @ref decode_writer,
+        @ref encode_writer,
+        @ref string_writer.
+*/
+class buffer_sink
+{
+    char* p_;
+    std::size_t n_;
+    std::size_t size_ = 0;
+
+public:
+    /** Constructor
+
+        @param data The buffer
+        @param size The size of the buffer
+    */
+    buffer_sink(
+        char* data,
+        std::size_t size) noexcept
+        : p_(data)
+        , n_(size)
+    {
+    }
+
+    /** Write characters to the buffer
+
+        @return The number of characters
+        written, less than `n` only when
+        the buffer is full.
+
+        @param data The characters
+        @param n The number of characters
+    */
+    BOOST_URL_DECL
+    std::size_t
+    write(
+        char const* data,
+        std::size_t n) noexcept;
+
+    /** Return the number of characters written
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return true if no more characters can be written
+    */
+    bool
+    full() const noexcept
+    {
+        return n_ == 0;
+    }
+};
+
+//------------------------------------------------
+
+/** A sink which writes to a sequence of buffers
+
+    This sink fills each buffer of a sequence
+    in order, such as the header buffers of
+    a scatter/gather write. The elements of
+    the sequence provide the member functions
+    `data()`, which returns a pointer to
+    writable memory, and `size()`, as the
+    mutable buffers of Asio and `std::span`
+    do. The sequence must remain valid while
+    the sink is in use.
+
+    @par Example
+    @code
+    // the free space of two header buffers
+    std::array< asio::mutable_buffer, 2 > bufs = {{
+        asio::buffer( h0 ) + n0, asio::buffer( h1 ) }};
+    buffers_sink< std::array< asio::mutable_buffer, 2 > > sink( bufs );
+
+    string_writer w( u.buffer() );
+    if( ! w.write( sink ) )
+    {
+        // the buffers are full, resume
+        // later with another sink
+    }
+    @endcode
+
+    @tparam MutableBufferSequence The type
+    of the sequence
+
+    @see
+        @ref buffer_sink.
+*/
+template<class MutableBufferSequence>
+class buffers_sink
+{
+    using iterator = decltype(std::begin(
+        std::declval<MutableBufferSequence const&>()));
+
+    iterator it_;
+    iterator end_;
+    char* p_ = nullptr;
+    std::size_t n_ = 0;
+    std::size_t size_ = 0;
+
+    void
+    next() noexcept;
+
+public:
+    /** Constructor
+
+        @param bs The sequence of buffers
+    */
+    explicit
+    buffers_sink(
+        MutableBufferSequence const& bs) noexcept;
+
+    /** Write characters to the buffers
+
+        @return The number of characters
+        written, less than `n` only when
+        the buffers are full.
+
+        @param data The characters
+        @param n The number of characters
+    */
+    std::size_t
+    write(
+        char const* data,
+        std::size_t n) noexcept;
+
+    /** Return the number of characters written
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return true if no more characters can be written
+    */
+    bool
+    full() const noexcept
+    {
+        return n_ == 0;
+    }
+};
+
+//------------------------------------------------
+
+/** A resumable writer of a string
+
+    This writes a string, such as the buffer
+    of a URL, to sinks. When a sink is full,
+    the writer can be resumed with another
+    sink and continues where it stopped.
+    The string must remain valid while the
+    writer is in use.
+
+    @par Example
+    @code
+    url u( "https://www.example.com/path" );
+    string_writer w( u.buffer() );
+    @endcode
+
+    @see
+        @ref buffer_sink,
+        @ref buffers_sink.
+*/
+class string_writer
+{
+    core::string_view s_;
+
+public:
+    /** Constructor
+
+        @param s The string
+    */
+    explicit
+    string_writer(
+        core::string_view s) noexcept
+        : s_(s)
+    {
+    }
+
+    /** Write the rest of the string to a sink
+
+        @return `true` if the whole string
+        was written
+
+        @param sink The sink
+    */
+    template<class Sink>
+    bool
+    write(Sink& sink);
+
+    /** Return true if the whole string was written
+    */
+    bool
+    done() const noexcept
+    {
+        return s_.empty();
+    }
+};
+
+//------------------------------------------------
+
+/** A resumable writer of a percent-encoded string
+
+    This applies percent-encoding to a
+    string as if by @ref encode, and writes
+    the result to sinks. When a sink is full,
+    possibly within an escape, the writer can
+    be resumed with another sink and
+    continues where it stopped. The string
+    must remain valid while the writer is
+    in use.
+
+    @par Example
+    @code
+    encode_writer< decltype(pchars) > w( "Program Files", pchars );
+    @endcode
+
+    @tparam CharSet The type of the set of
+    characters which are not encoded
+
+    @see
+        @ref encode,
+        @ref encoded_size.
+*/
+template<class CharSet>
+class encode_writer
+{
+    core::string_view s_;
+    CharSet cs_;
+    encoding_opts opt_;
+    char esc_[3];
+    unsigned char esc_pos_ = 0;
+    unsigned char esc_end_ = 0;
+
+public:
+    /** Constructor
+
+        @param s The string to encode
+        @param unreserved The set of characters
+        which are not percent-encoded
+        @param opt The options for encoding
+    */
+    encode_writer(
+        core::string_view s,
+        CharSet const& unreserved,
+        encoding_opts opt = {}) noexcept
+        : s_(s)
+        , cs_(unreserved)
+        , opt_(opt)
+    {
+    }
+
+    /** Write the rest of the encoded string to a sink
+
+        @return `true` if the whole encoded
+        string was written
+
+        @param sink The sink
+    */
+    template<class Sink>
+    bool
+    write(Sink& sink);
+
+    /** Return true if the whole encoded string was written
+    */
+    bool
+    done() const noexcept
+    {
+        return s_.empty() &&
+            esc_pos_ == esc_end_;
+    }
+};
+
+//------------------------------------------------
+
+/** A resumable writer of a decoded string
+
+    This decodes a percent-encoded string
+    and writes the result to sinks. When a
+    sink is full, the writer can be resumed
+    with another sink and continues where it
+    stopped. The string must remain valid
+    while the writer is in use.
+
+    @par Example
+    @code
+    decode_writer w( "Program%20Files" );
+    @endcode
+
+    @see
+        @ref decode_view,
+        @ref pct_string_view::decode.
+*/
+class decode_writer
+{
+    core::string_view s_;
+    encoding_opts opt_;
+
+public:
+    /** Constructor
+
+        @param s The string to decode
+        @param opt The options for decoding
+    */
+    explicit
+    decode_writer(
+        pct_string_view s,
+        encoding_opts opt = {}) noexcept
+        : s_(s)
+        , opt_(opt)
+    {
+    }
+
+    /** Write the rest of the decoded string to a sink
+
+        @return `true` if the whole decoded
+        string was written
+
+        @param sink The sink
+    */
+    template<class Sink>
+    bool
+    write(Sink& sink);
+
+    /** Return true if the whole decoded string was written
+    */
+    bool
+    done() const noexcept
+    {
+        return s_.empty();
+    }
+};
+
+} // urls
+} // boost
+
+#include <boost/url/impl/sink.hpp>
+
+#endif
@@ -0,0 +1,560 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_SMALL_URL_HPP
+#define BOOST_URL_SMALL_URL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+template<std::size_t Capacity>
+class small_url;
+#endif
+
+/** Common implementation for all small URLs
+
+    This base class is used by the library
+    to provide common functionality for
+    small URLs. Users should not use this
+    class directly. Instead, construct an
+    instance of one of the containers
+    or call a parsing function.
+
+    @par Containers
+        @li @ref url
+        @li @ref url_view
+        @li @ref small_url
+        @li @ref static_url
+
+    @par Parsing Functions
+        @li @ref parse_absolute_uri
+        @li @ref parse_origin_form
+        @li @ref parse_relative_ref
+        @li @ref parse_uri
+        @li @ref parse_uri_reference
+*/
+class BOOST_URL_DECL
+    small_url_base
+    : public url_base
+{
+    template<std::size_t>
+    friend class small_url;
+
+    ~small_url_base();
+    small_url_base(
+        char* buf, std::size_t cap) noexcept;
+    small_url_base(
+        char* buf, std::size_t cap, core::string_view s);
+    void move_from(small_url_base&) noexcept;
+    void shrink_to_fit_impl();
+    void clear_impl() noexcept override;
+    void reserve_impl(std::size_t, op_t&) override;
+    void cleanup(op_t&) override;
+
+    void
+    copy(url_view_base const& u)
+    {
+        this->url_base::copy(u);
+    }
+
+    bool
+    is_inline() const noexcept
+    {
+        return s_ == buf_;
+    }
+
+    char* buf_;
+    std::size_t inline_cap_;
+};
+
+//------------------------------------------------
+
+/** A modifiable container for a URL with inline storage.
+
+    This container owns a url, represented
+    by a null-terminated character buffer
+    which is stored inline while the url
+    has at most `Capacity` characters. When
+    the url grows beyond that, the buffer is
+    moved to dynamically allocated memory.
+    It moves back inline when the url is
+    cleared or when @ref shrink_to_fit is
+    called on a url which fits.
+
+    The contents may be inspected and modified,
+    and the implementation maintains a useful
+    invariant: changes to the url always
+    leave it in a valid state.
+
+    @par Example
+    @code
+    small_url< 128 > u( "https://www.example.com" );
+
+    assert( u.is_inline() );
+    @endcode
+
+    @par Invariants
+    @code
+    this->capacity() >= Capacity
+    @endcode
+
+    @tparam Capacity The number of characters
+    stored inline, not including the null
+    terminator.
+
+    @see
+        @ref static_url,
+        @ref url,
+        @ref url_view.
+*/
+template<std::size_t Capacity>
+class small_url
+    : public small_url_base
+{
+    BOOST_STATIC_ASSERT(Capacity > 0);
+
+    char buf_[Capacity + 1];
+
+    friend std::hash<small_url>;
+    using url_view_base::digest;
+
+public:
+    //--------------------------------------------
+    //
+    // Special Members
+    //
+    //--------------------------------------------
+
+    /** Destructor
+
+        Any params, segments, iterators, or
+        views which reference this object are
+        invalidated. The underlying character
+        buffer is destroyed, invalidating all
+        references to it.
+    */
+    ~small_url() = default;
+
+    /** Constructor
+
+        Default constructed urls contain
+        a zero-length string stored inline.
+
+        @par Example
+        @code
+        small_url< 128 > u;
+        @endcode
+
+        @par Postconditions
+        @code
+        this->empty() == true && this->is_inline()
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    small_url() noexcept
+        : small_url_base(
+            buf_, sizeof(buf_) - 1)
+    {
+    }
+
+    /** Constructor
+
+        This function constructs a url from
+        the string `s`, which must contain a
+        valid <em>URI</em> or <em>relative-ref</em>
+        or else an exception is thrown.
+        The new url retains ownership by
+        making a copy of the passed string.
+
+        @par Example
+        @code
+        small_url< 128 > u( "https://www.example.com" );
+        @endcode
+
+        @par Effects
+        @code
+        return small_url( parse_uri_reference( s ).value() );
+        @endcode
+
+        @par Complexity
+        Linear in `s.size()`.
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        The input does not contain a valid url.
+
+        @param s The string to parse.
+    */
+    explicit
+    small_url(
+        core::string_view s)
+        : small_url_base(
+            buf_, sizeof(buf_) - 1, s)
+    {
+    }
+
+    /** Constructor
+
+        The newly constructed object contains
+        a copy of `u`.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    small_url(
+        small_url const& u)
+        : small_url()
+    {
+        copy(u);
+    }
+
+    /** Constructor
+
+        The contents of `u` are moved to the
+        newly constructed object. When `u`
+        is stored inline its characters are
+        copied, otherwise its dynamically
+        allocated buffer is transferred.
+
+        @par Postconditions
+        @code
+        u.empty() && u.is_inline()
+        @endcode
+
+        @par Complexity
+        Constant, or linear in `u.size()`
+        when `u` is stored inline.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param u The url to move from.
+    */
+    small_url(
+        small_url&& u) noexcept
+        : small_url()
+    {
+        move_from(u);
+    }
+
+    /** Constructor
+
+        The newly constructed object contains
+        a copy of `u`.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    small_url(
+        url_view_base const& u)
+        : small_url()
+    {
+        copy(u);
+    }
+
+    /** Assignment
+
+        The contents of `u` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    small_url&
+    operator=(
+        small_url const& u)
+    {
+        if (this != &u)
+            copy(u);
+        return *this;
+    }
+
+    /** Assignment
+
+        The contents of `u` are moved to this
+        object and the previous contents of
+        `this` are discarded.
+
+        @par Postconditions
+        @code
+        u.empty() && u.is_inline()
+        @endcode
+
+        @par Complexity
+        Constant, or linear in `u.size()`
+        when `u` is stored inline.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param u The url to move from.
+    */
+    small_url&
+    operator=(
+        small_url&& u) noexcept
+    {
+        if (this != &u)
+            move_from(u);
+        return *this;
+    }
+
+    /** Assignment
+
+        The contents of `u` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    small_url&
+    operator=(
+        url_view_base const& u)
+    {
+        copy(u);
+        return *this;
+    }
+
+    //--------------------------------------------
+    //
+    // Capacity
+    //
+    //--------------------------------------------
+
+    /** Return true if the url is stored inline
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    bool
+    is_inline() const noexcept
+    {
+        return small_url_base::is_inline();
+    }
+
+    /** Reduce the capacity to fit the url
+
+        If the url fits in the inline storage,
+        it is moved there and the dynamically
+        allocated buffer is released. Otherwise
+        the buffer is reallocated to the size
+        of the url.
+
+        @par Postconditions
+        @code
+        this->is_inline() || this->capacity() == this->size()
+        @endcode
+
+        @par Complexity
+        Linear in `this->size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    void
+    shrink_to_fit()
+    {
+        shrink_to_fit_impl();
+    }
+
+    //--------------------------------------------
+    //
+    // fluent api
+    //
+
+    /// @copydoc url_base::set_scheme
+    small_url& set_scheme(core::string_view s) { url_base::set_scheme(s); return *this; }
+    /// @copydoc url_base::set_scheme_id
+    small_url& set_scheme_id(urls::scheme id) { url_base::set_scheme_id(id); return *this; }
+    /// @copydoc url_base::remove_scheme
+    small_url& remove_scheme() { url_base::remove_scheme(); return *this; }
+
+    /// @copydoc url_base::set_encoded_authority
+    small_url& set_encoded_authority(pct_string_view s) { url_base::set_encoded_authority(s); return *this; }
+    /// @copydoc url_base::remove_authority
+    small_url& remove_authority() { url_base::remove_authority(); return *this; }
+
+    /// @copydoc url_base::set_userinfo
+    small_url& set_userinfo(core::string_view s) { url_base::set_userinfo(s); return *this; }
+    /// @copydoc url_base::set_encoded_userinfo
+    small_url& set_encoded_userinfo(pct_string_view s) { url_base::set_encoded_userinfo(s); return *this; }
+    /// @copydoc url_base::remove_userinfo
+    small_url& remove_userinfo() noexcept { url_base::remove_userinfo(); return *this; }
+    /// @copydoc url_base::set_user
+    small_url& set_user(core::string_view s) { url_base::set_user(s); return *this; }
+    /// @copydoc url_base::set_encoded_user
+    small_url& set_encoded_user(pct_string_view s) { url_base::set_encoded_user(s); return *this; }
+    /// @copydoc url_base::set_password
+    small_url& set_password(core::string_view s) { url_base::set_password(s); return *this; }
+    /// @copydoc url_base::set_encoded_password
+    small_url& set_encoded_password(pct_string_view s) { url_base::set_encoded_password(s); return *this; }
+    /// @copydoc url_base::remove_password
+    small_url& remove_password() noexcept { url_base::remove_password(); return *this; }
+
+    /// @copydoc url_base::set_host
+    small_url& set_host(core::string_view s) { url_base::set_host(s); return *this; }
+    /// @copydoc url_base::set_encoded_host
+    small_url& set_encoded_host(pct_string_view s) { url_base::set_encoded_host(s); return *this; }
+    /// @copydoc url_base::set_host_address
+    small_url& set_host_address(core::string_view s) { url_base::set_host_address(s); return *this; }
+    /// @copydoc url_base::set_encoded_host_address
+    small_url& set_encoded_host_address(pct_string_view s) { url_base::set_encoded_host_address(s); return *this; }
+    /// @copydoc url_base::set_host_ipv4
+    small_url& set_host_ipv4(ipv4_address const& addr) { url_base::set_host_ipv4(addr); return *this; }
+    /// @copydoc url_base::set_host_ipv6
+    small_url& set_host_ipv6(ipv6_address const& addr) { url_base::set_host_ipv6(addr); return *this; }
+    /// @copydoc url_base::set_host_ipvfuture
+    small_url& set_host_ipvfuture(core::string_view s) { url_base::set_host_ipvfuture(s); return *this; }
+    /// @copydoc url_base::set_host_name
+    small_url& set_host_name(core::string_view s) { url_base::set_host_name(s); return *this; }
+    /// @copydoc url_base::set_encoded_host_name
+    small_url& set_encoded_host_name(pct_string_view s) { url_base::set_encoded_host_name(s); return *this; }
+    /// @copydoc url_base::set_port_number
+    small_url& set_port_number(std::uint16_t n) { url_base::set_port_number(n); return *this; }
+    /// @copydoc url_base::set_port
+    small_url& set_port(core::string_view s) { url_base::set_port(s); return *this; }
+    /// @copydoc url_base::remove_port
+    small_url& remove_port() noexcept { url_base::remove_port(); return *this; }
+
+    /// @copydoc url_base::set_path_absolute
+    //bool set_path_absolute(bool absolute);
+    /// @copydoc url_base::set_path
+    small_url& set_path(core::string_view s) { url_base::set_path(s); return *this; }
+    /// @copydoc url_base::set_encoded_path
+    small_url& set_encoded_path(pct_string_view s) { url_base::set_encoded_path(s); return *this; }
+
+    /// @copydoc url_base::set_query
+    small_url& set_query(core::string_view s) { url_base::set_query(s); return *this; }
+    /// @copydoc url_base::set_encoded_query
+    small_url& set_encoded_query(pct_string_view s) { url_base::set_encoded_query(s); return *this; }
+    /// @copydoc url_base::remove_query
+    small_url& remove_query() noexcept { url_base::remove_query(); return *this; }
+
+    /// @copydoc url_base::remove_fragment
+    small_url& remove_fragment() noexcept { url_base::remove_fragment(); return *this; }
+    /// @copydoc url_base::set_fragment
+    small_url& set_fragment(core::string_view s) { url_base::set_fragment(s); return *this; }
+    /// @copydoc url_base::set_encoded_fragment
+    small_url& set_encoded_fragment(pct_string_view s) { url_base::set_encoded_fragment(s); return *this; }
+
+    /// @copydoc url_base::remove_origin
+    small_url& remove_origin() { url_base::remove_origin(); return *this; }
+
+    /// @copydoc url_base::normalize
+    small_url& normalize() { url_base::normalize(); return *this; }
+    /// @copydoc url_base::normalize_scheme
+    small_url& normalize_scheme() { url_base::normalize_scheme(); return *this; }
+    /// @copydoc url_base::normalize_authority
+    small_url& normalize_authority() { url_base::normalize_authority(); return *this; }
+    /// @copydoc url_base::normalize_path
+    small_url& normalize_path() { url_base::normalize_path(); return *this; }
+    /// @copydoc url_base::normalize_query
+    small_url& normalize_query() { url_base::normalize_query(); return *this; }
+    /// @copydoc url_base::normalize_query(bool)
+    small_url& normalize_query(bool sort_keys) { url_base::normalize_query(sort_keys); return *this; }
+    /// @copydoc url_base::normalize_fragment
+    small_url& normalize_fragment() { url_base::normalize_fragment(); return *this; }
+
+    //--------------------------------------------
+};
+
+} // urls
+} // boost
+
+//------------------------------------------------
+
+// std::hash specialization
+#ifndef BOOST_URL_DOCS
+namespace std {
+template<std::size_t N>
+struct hash< ::boost::urls::small_url<N> >
+{
+    hash() = default;
+    hash(hash const&) = default;
+    hash& operator=(hash const&) = default;
+
+    explicit
+    hash(std::size_t salt) noexcept
+        : salt_(salt)
+    {
+    }
+
+    std::size_t
+    operator()(::boost::urls::small_url<N> const& u) const noexcept
+    {
+        return u.digest(salt_);
+    }
+
+private:
+    std::size_t salt_ = 0;
+};
+} // std
+#endif
+
+#endif
@@ -429,6 +429,8 @@ public:
     static_url& normalize_path() { url_base::normalize_path(); return *this; }
     /// @copydoc url_base::normalize_query
     static_url& normalize_query() { url_base::normalize_query(); return *this; }
+    /// @copydoc url_base::normalize_query(bool)
+    static_url& normalize_query(bool sort_keys) { url_base::normalize_query(sort_keys); return *this; }
     /// @copydoc url_base::normalize_fragment
     static_url& normalize_fragment() { url_base::normalize_fragment(); return *this; }
 
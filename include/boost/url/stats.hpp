@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_STATS_HPP
+#define BOOST_URL_STATS_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/error_types.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** Counters describing the work done by the library
+
+    The counters are only updated when the
+    library is compiled with the macro
+    `BOOST_URL_ENABLE_STATS` defined, which
+    the CMake option of the same name does.
+    Otherwise, the counters are always zero
+    and the instrumentation has no cost.
+
+    @par Example
+    @code
+    reset_url_stats();
+
+    url u( "https://www.example.com" );
+    u.set_path( "/path/to/file.txt" );
+
+    url_stats st = get_url_stats();
+    if( st.enabled )
+        assert( st.allocations >= 1 );
+    @endcode
+
+    @see
+        @ref get_url_stats,
+        @ref reset_url_stats.
+*/
+struct url_stats
+{
+    /** True if the library was compiled with the counters
+    */
+    bool enabled = false;
+
+    /** Buffers allocated by @ref url, including reallocations
+    */
+    std::size_t allocations = 0;
+
+    /** Buffers allocated by @ref url to replace a smaller one
+    */
+    std::size_t reallocations = 0;
+
+    /** Characters allocated by @ref url
+    */
+    std::size_t bytes_allocated = 0;
+
+    /** Characters allocated beyond the requested size by the growth policy
+    */
+    std::size_t bytes_unused = 0;
+
+    /** Characters moved inside the buffer of a url to resize a part
+    */
+    std::size_t bytes_moved = 0;
+
+    /** Calls to the normalization functions of @ref url_base
+    */
+    std::size_t normalizations = 0;
+
+    /** Failures to parse a url or an authority
+    */
+    std::size_t parse_failures = 0;
+
+    /** Parse failures by value of @ref grammar::error
+    */
+    std::size_t grammar_errors[
+        static_cast<int>(
+            grammar::error::syntax) + 1] = {};
+
+    /** Parse failures by value of @ref error
+    */
+    std::size_t url_errors[
+        static_cast<int>(
+            error::not_a_base) + 1] = {};
+
+    /** Return the number of parse failures with an error code
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param ec The error code.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    failures(
+        system::error_code const& ec) const noexcept;
+};
+
+/** Return a snapshot of the counters
+
+    Each counter is read atomically, and can
+    be read while other threads use the
+    library. Counters incremented while the
+    snapshot is taken might be included or
+    not.
+
+    @par Exception Safety
+    Throws nothing.
+
+    @see
+        @ref reset_url_stats,
+        @ref url_stats.
+*/
+BOOST_URL_DECL
+url_stats
+get_url_stats() noexcept;
+
+/** Set all counters to zero
+
+    @par Exception Safety
+    Throws nothing.
+
+    @see
+        @ref get_url_stats,
+        @ref url_stats.
+*/
+BOOST_URL_DECL
+void
+reset_url_stats() noexcept;
+
+} // urls
+} // boost
+
+#endif
@@ -497,6 +497,8 @@ public:
     url& normalize_path() { url_base::normalize_path(); return *this; }
     /// @copydoc url_base::normalize_query
     url& normalize_query() { url_base::normalize_query(); return *this; }
+    /// @copydoc url_base::normalize_query(bool)
+    url& normalize_query(bool sort_keys) { url_base::normalize_query(sort_keys); return *this; }
     /// @copydoc url_base::normalize_fragment
     url& normalize_fragment() { url_base::normalize_fragment(); return *this; }
 
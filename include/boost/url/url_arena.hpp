@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_ARENA_HPP
+#define BOOST_URL_URL_ARENA_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+#include <iterator>
+
+namespace boost {
+namespace urls {
+
+/** An arena which persists many URLs at once
+
+    This container copies the characters of
+    URLs into large blocks of memory and
+    returns views which reference the copies.
+    The views remain valid until the arena
+    is cleared or destroyed, which releases
+    all of the copies at once.
+
+    Unlike @ref url_view_base::persist, which
+    makes one reference-counted allocation
+    for each URL, the arena only allocates
+    when a block is full, and the returned
+    views are not reference counted.
+
+    @par Example
+    @code
+    url_arena a;
+    std::vector< url_view > v;
+    {
+        std::string s( "http://example.com" );
+
+        v.push_back( a.persist( url_view( s ) ) );
+    }
+    // s is destroyed, but the view is valid
+    assert( v[0].buffer() == "http://example.com" );
+    @endcode
+
+    @par Exception Safety
+
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+
+    @see
+        @ref url_view_base::persist.
+*/
+class BOOST_URL_DECL url_arena
+{
+public:
+    /// The default size of a block
+    static constexpr std::size_t default_block_size = 64 * 1024;
+
+    /** Constructor
+
+        No memory is allocated until the first
+        URL is persisted.
+
+        @param block_size The size of each
+        block. URLs which are larger than this
+        are placed in a block of their own.
+    */
+    explicit
+    url_arena(
+        std::size_t block_size =
+            default_block_size) noexcept;
+
+    /** Destructor
+
+        All memory is released, and views
+        returned by the arena are invalidated.
+    */
+    ~url_arena();
+
+    /** Constructor
+
+        The blocks of `other` are transferred,
+        and views returned by it remain valid.
+        After the call, `other` is empty.
+    */
+    url_arena(url_arena&& other) noexcept;
+
+    /** Assignment
+
+        The memory of `this` is released, and
+        the blocks of `other` are transferred.
+    */
+    url_arena&
+    operator=(url_arena&& other) noexcept;
+
+    url_arena(url_arena const&) = delete;
+    url_arena& operator=(url_arena const&) = delete;
+
+    /** Return a view of a persistent copy of a URL
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @return A view which is valid until
+        the arena is cleared or destroyed.
+
+        @param u The URL to copy
+    */
+    url_view
+    persist(url_view_base const& u);
+
+    /** Persist a range of URLs
+
+        A copy of each URL in the range is
+        made and a view of it is written to
+        the output iterator. When the range
+        is a forward range, its total size
+        is reserved at once first.
+
+        @par Complexity
+        Linear in the total size of the URLs.
+
+        @return The output iterator after the
+        last view
+
+        @param first, last The range of URLs,
+        whose value type is convertible to
+        `url_view_base const&`.
+
+        @param out The output iterator, which
+        accepts values of type @ref url_view.
+    */
+    template<class InputIt, class OutputIt>
+    OutputIt
+    persist(
+        InputIt first,
+        InputIt last,
+        OutputIt out);
+
+    /** Ensure a number of bytes can be persisted without allocating
+
+        @param n The number of bytes
+    */
+    void
+    reserve(std::size_t n);
+
+    /** Release the copies
+
+        All views returned by the arena are
+        invalidated. The last block allocated
+        is kept to be reused.
+    */
+    void
+    clear() noexcept;
+
+    /** Return the number of bytes persisted
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return the number of bytes allocated
+    */
+    std::size_t
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /** Return the number of blocks allocated
+    */
+    std::size_t
+    block_count() const noexcept
+    {
+        return blocks_;
+    }
+
+private:
+    struct block;
+
+    void
+    release() noexcept;
+
+    char*
+    allocate(std::size_t n);
+
+    template<class InputIt, class OutputIt>
+    OutputIt
+    persist_impl(
+        InputIt first,
+        InputIt last,
+        OutputIt out,
+        std::input_iterator_tag);
+
+    template<class InputIt, class OutputIt>
+    OutputIt
+    persist_impl(
+        InputIt first,
+        InputIt last,
+        OutputIt out,
+        std::forward_iterator_tag);
+
+    block* head_ = nullptr;
+    char* pos_ = nullptr;
+    char* end_ = nullptr;
+    std::size_t block_size_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+    std::size_t blocks_ = 0;
+};
+
+} // urls
+} // boost
+
+#include <boost/url/impl/url_arena.hpp>
+
+#endif
@@ -69,11 +69,13 @@ class BOOST_URL_DECL
 
     friend class url;
     friend class static_url_base;
+    friend class small_url_base;
     friend class params_ref;
     friend class segments_ref;
     friend class segments_encoded_ref;
     friend class params_encoded_ref;
     friend struct detail::pattern;
+    friend class edit_batch;
 
     struct op_t
     {
@@ -2527,6 +2529,18 @@ public:
         Applies Syntax-based normalization to
         all components of the URL.
 
+        The result is the same as calling
+        @ref normalize_fragment,
+        @ref normalize_query,
+        @ref normalize_path,
+        @ref normalize_authority and
+        @ref normalize_scheme, but the
+        buffer is rewritten in a single
+        forward pass.
+
+        @par Complexity
+        Linear in `this->size()`.
+
         @par Exception Safety
         Strong guarantee.
         Calls to allocate may throw.
@@ -2625,6 +2639,42 @@ public:
     url_base&
     normalize_query();
 
+    /** Normalize the URL query and sort its params
+
+        Applies Syntax-based normalization to the
+        URL query and, if `sort_keys` is true,
+        sorts the params by their decoded keys.
+        Params with equal keys keep their order.
+
+        The params are reordered inside the
+        buffer of the URL, so the size of the
+        URL does not change.
+
+        @par Example
+        @code
+        url u( "?b=2&a=%31&b=1" );
+
+        u.normalize_query( true );
+
+        assert( u.encoded_query() == "a=1&b=2&b=1" );
+        @endcode
+
+        @par Complexity
+        `n log n` in the number of params.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param sort_keys If true, the params
+        are sorted.
+
+        @see
+            @ref params_ref::sort.
+    */
+    url_base&
+    normalize_query(bool sort_keys);
+
     /** Normalize the URL fragment
 
         Applies Syntax-based normalization to the
@@ -2799,11 +2849,17 @@ private:
         url_view_base const& base,
         url_view_base const& ref);
 
+    system::result<void>
+    resolve_impl(
+        url_view_base const& ref);
+
     template<class CharSet>
     void normalize_octets_impl(int,
         CharSet const& allowed, op_t&) noexcept;
+    void sort_params_impl();
     void decoded_to_lower_impl(int id) noexcept;
     void to_lower_impl(int id) noexcept;
+    void update_path_counts() noexcept;
 };
 
 //------------------------------------------------
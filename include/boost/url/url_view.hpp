@@ -13,6 +13,9 @@
 
 #include <boost/url/detail/config.hpp>
 #include <boost/url/url_view_base.hpp>
+#ifdef BOOST_URL_HAS_CONSTEXPR_PARSE
+#include <boost/url/detail/constexpr_parser.hpp>
+#endif
 #include <utility>
 
 namespace boost {
@@ -78,6 +81,7 @@ class BOOST_URL_DECL url_view
     friend class url_view_base;
     friend class params_base;
     friend class params_encoded_base;
+    friend class url_arena;
 
 #ifndef BOOST_URL_DOCS
     // VFALCO docca emits this erroneously
@@ -87,12 +91,37 @@ class BOOST_URL_DECL url_view
     using url_view_base::digest;
 
     explicit
+    BOOST_URL_CXX20_CONSTEXPR
     url_view(
         detail::url_impl const& impl) noexcept
         : url_view_base(impl)
     {
     }
 
+    static
+    BOOST_URL_CXX20_CONSTEXPR
+    detail::url_impl
+    parse_impl(core::string_view s)
+    {
+#ifdef BOOST_URL_HAS_CONSTEXPR_PARSE
+        if(std::is_constant_evaluated())
+        {
+            detail::url_impl u(from::string);
+            if(detail::constexpr_parser::
+                    parse_uri_reference(s, u))
+                return u;
+            // If you get a compile error here, it
+            // means that the string is not a valid
+            // URI or relative-ref.
+        }
+#endif
+        return parse_runtime(s);
+    }
+
+    static
+    detail::url_impl
+    parse_runtime(core::string_view s);
+
 public:
     //--------------------------------------------
     //
@@ -172,6 +201,16 @@ public:
         @par Complexity
         Linear in `s.size()`.
 
+        When evaluated in a constant expression
+        (C++20 or later), the string is parsed
+        and validated at compile time. Invalid
+        input is a compile error. The view
+        refers to itself, so a constant must
+        have static storage duration:
+        @code
+        static constexpr url_view u( "https://www.example.com/index.htm" );
+        @endcode
+
         @par Exception Safety
         Exceptions thrown on invalid input.
 
@@ -194,7 +233,11 @@ public:
         @see
             @ref parse_uri_reference.
     */
-    url_view(core::string_view s);
+    BOOST_URL_CXX20_CONSTEXPR
+    url_view(core::string_view s)
+        : url_view_base(parse_impl(s))
+    {
+    }
 
     /// @copydoc url_view(core::string_view)
     template<
@@ -212,6 +255,7 @@ public:
             >::type
 #endif
     >
+    BOOST_URL_CXX20_CONSTEXPR
     url_view(
         String const& s)
         : url_view(
@@ -236,6 +280,7 @@ public:
         @par Exception Safety
         Throws nothing.
     */
+    BOOST_URL_CXX20_CONSTEXPR
     url_view(
         url_view const& other) noexcept
         : url_view(static_cast<
@@ -260,8 +305,14 @@ public:
         @par Exception Safety
         Throws nothing.
     */
+    BOOST_URL_CXX20_CONSTEXPR
     url_view(
-        url_view_base const& other) noexcept;
+        url_view_base const& other) noexcept
+        : url_view_base(other.impl_)
+    {
+        if(other.pi_->from_ == from::url)
+            pi_ = other.pi_;
+    }
 
     /** Assignment
 
@@ -72,7 +72,9 @@ class BOOST_URL_DECL
     friend class url;
     friend class url_base;
     friend class url_view;
+    friend class url_arena;
     friend class static_url_base;
+    friend class small_url_base;
     friend class params_base;
     friend class params_encoded_base;
     friend class params_encoded_ref;
@@ -85,17 +87,25 @@ class BOOST_URL_DECL
     friend class segments_encoded_view;
     friend class segments_ref;
     friend class segments_view;
+    friend class edit_batch;
     friend struct detail::pattern;
 
     struct shared_impl;
 
     url_view_base() noexcept;
 
-    explicit url_view_base(
-        detail::url_impl const&) noexcept;
+    explicit
+    BOOST_URL_CXX20_CONSTEXPR
+    url_view_base(
+        detail::url_impl const& impl) noexcept
+        : impl_(impl)
+        , pi_(&impl_)
+    {
+    }
 
     ~url_view_base() = default;
 
+    BOOST_URL_CXX20_CONSTEXPR
     url_view_base(
         url_view_base const& o) noexcept
         : impl_(o.impl_)
@@ -114,6 +124,43 @@ public:
     std::size_t
     digest(std::size_t = 0) const noexcept;
 
+public:
+    /** Return a 128-bit digest of the URL
+
+        The digest is computed as if the URL
+        were normalized, without modifying
+        or copying it. URLs which compare
+        equal have the same digest.
+
+        The hash function is keyed: choosing
+        a secret key makes digests hard to
+        predict, which resists hash flooding.
+        Each part is hashed together with
+        its decoded size, so an escaped
+        delimiter such as `%23` cannot be
+        mistaken for the end of a part.
+        With the wide output, unrelated URLs
+        are unlikely to share a digest, so it
+        can stand in for the URL when
+        deduplicating.
+
+        @par Complexity
+        Linear in `this->size()`.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param k0 The first half of the key
+        @param k1 The second half of the key
+
+        @see
+            @ref compare.
+    */
+    std::pair<std::uint64_t, std::uint64_t>
+    digest128(
+        std::uint64_t k0 = 0,
+        std::uint64_t k1 = 0) const noexcept;
+
 public:
     //--------------------------------------------
     //
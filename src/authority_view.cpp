@@ -11,6 +11,7 @@
 #include <boost/url/detail/config.hpp>
 #include <boost/url/authority_view.hpp>
 #include "detail/normalize.hpp"
+#include "detail/stats.hpp"
 #include <boost/url/grammar/parse.hpp>
 #include <boost/url/rfc/authority_rule.hpp>
 #include <boost/url/rfc/pct_encoded_rule.hpp>
@@ -336,7 +337,8 @@ system::result<authority_view>
 parse_authority(
     core::string_view s) noexcept
 {
-    return grammar::parse(s, authority_rule);
+    return detail::stats_parse(
+        grammar::parse(s, authority_rule));
 }
 
 //------------------------------------------------
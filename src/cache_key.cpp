@@ -0,0 +1,381 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/cache_key.hpp>
+#include <boost/url/scheme.hpp>
+#include "detail/normalize.hpp"
+#include "rfc/detail/charsets.hpp"
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <memory>
+
+namespace boost {
+namespace urls {
+
+cache_key_opts::
+cache_key_opts(
+    bool remove_default_port_,
+    bool remove_dot_segments_,
+    bool sort_params_,
+    bool remove_fragment_) noexcept
+    : remove_default_port(remove_default_port_)
+    , remove_dot_segments(remove_dot_segments_)
+    , sort_params(sort_params_)
+    , remove_fragment(remove_fragment_)
+{}
+
+//------------------------------------------------
+
+namespace {
+
+// Receives the canonical form, which is
+// hashed and optionally appended to a
+// string
+struct cache_key_sink
+{
+    detail::sip_hasher h;
+    std::string* s;
+
+    void
+    put(char c)
+    {
+        h.put(c);
+        if(s)
+            s->push_back(c);
+    }
+
+    void
+    put(core::string_view v)
+    {
+        h.put(v);
+        if(s)
+            s->append(v.data(), v.size());
+    }
+};
+
+// Put s with the same percent-encoding
+// as detail::normalize_octets, without
+// writing it to a buffer first
+template<class CharSet>
+void
+put_octets(
+    cache_key_sink& dest,
+    core::string_view s,
+    CharSet const& allowed,
+    bool lower = false)
+{
+    char const* it = s.data();
+    char const* const end = it + s.size();
+    char const* first = it;
+    while(it != end)
+    {
+        char c = *it;
+        if( c != '%' &&
+            ! (lower && grammar::to_lower(c) != c))
+        {
+            ++it;
+            continue;
+        }
+        dest.put(core::string_view(first,
+            static_cast<std::size_t>(it - first)));
+        if(c != '%')
+        {
+            dest.put(grammar::to_lower(c));
+            first = ++it;
+            continue;
+        }
+        BOOST_ASSERT(end - it >= 3);
+        c = detail::decode_one(it + 1);
+        if(allowed(c))
+        {
+            dest.put(lower ?
+                grammar::to_lower(c) : c);
+        }
+        else
+        {
+            dest.put('%');
+            dest.put(grammar::to_upper(it[1]));
+            dest.put(grammar::to_upper(it[2]));
+        }
+        it += 3;
+        first = it;
+    }
+    dest.put(core::string_view(first,
+        static_cast<std::size_t>(it - first)));
+}
+
+// A param in the query, which is
+// only split when it is put
+struct param_ref
+{
+    char const* data;
+    std::uint32_t size;
+    std::uint32_t key_size;
+
+    core::string_view
+    key() const noexcept
+    {
+        return { data, key_size };
+    }
+
+    core::string_view
+    value() const noexcept
+    {
+        if(key_size == size)
+            return {};
+        return { data + key_size + 1,
+            size - key_size - 1 };
+    }
+
+    core::string_view
+    str() const noexcept
+    {
+        return { data, size };
+    }
+};
+
+// Params are decoded as if by
+// application/x-www-form-urlencoded,
+// so "+" and "%2B" are not equivalent
+constexpr auto cache_key_chars =
+    detail::param_key_chars - '+';
+
+constexpr auto cache_value_chars =
+    detail::param_value_chars - '+';
+
+bool
+param_less(
+    param_ref const& a,
+    param_ref const& b) noexcept
+{
+    int r = detail::compare_encoded(
+        a.key(), b.key());
+    if(r != 0)
+        return r < 0;
+    r = detail::compare_encoded(
+        a.value(), b.value());
+    if(r != 0)
+        return r < 0;
+    // keeps the order deterministic
+    // when only the escapes differ
+    return a.str() < b.str();
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+cache_key_generator::
+cache_key_generator(
+    cache_key_opts const& opt,
+    std::uint64_t k0,
+    std::uint64_t k1) noexcept
+    : opt_(opt)
+    , k0_(k0)
+    , k1_(k1)
+{
+}
+
+cache_key_generator&
+cache_key_generator::
+ignore_param(core::string_view key)
+{
+    auto const less =
+        [](std::string const& a,
+            core::string_view b)
+        {
+            return detail::compare_encoded(a, b) < 0;
+        };
+    auto it = std::lower_bound(
+        ignored_.begin(), ignored_.end(),
+        key, less);
+    if( it == ignored_.end() ||
+        detail::compare_encoded(*it, key) != 0)
+        ignored_.emplace(it, key.data(), key.size());
+    return *this;
+}
+
+cache_key
+cache_key_generator::
+make(
+    url_view_base const& u,
+    char* scratch,
+    std::size_t n,
+    std::string* canonical) const
+{
+    if(canonical)
+        canonical->clear();
+    cache_key_sink out{
+        detail::sip_hasher(k0_, k1_, true),
+        canonical };
+
+    // The normalized path and the params
+    // share the scratch buffer, which is
+    // only replaced when they do not fit
+    core::string_view const path =
+        u.encoded_path();
+    core::string_view const query =
+        u.encoded_query();
+    std::size_t np = 0;
+    if(! query.empty())
+        np = 1 + static_cast<std::size_t>(
+            std::count(query.begin(),
+                query.end(), '&'));
+    std::size_t const path_size =
+        (path.size() + alignof(param_ref) - 1) &
+            ~(alignof(param_ref) - 1);
+    std::size_t const needed =
+        path_size + np * sizeof(param_ref);
+    std::unique_ptr<char[]> heap;
+    if(needed > n)
+    {
+        heap.reset(new char[needed]);
+        scratch = heap.get();
+    }
+
+    // scheme
+    if(u.has_scheme())
+    {
+        for(char c : u.scheme())
+            out.put(grammar::to_lower(c));
+        out.put(':');
+    }
+
+    // authority
+    if(u.has_authority())
+    {
+        out.put("//");
+        if(u.has_userinfo())
+        {
+            put_octets(out, u.encoded_user(),
+                detail::user_chars);
+            if(u.has_password())
+            {
+                out.put(':');
+                put_octets(out, u.encoded_password(),
+                    detail::password_chars);
+            }
+            out.put('@');
+        }
+        put_octets(out, u.encoded_host(),
+            detail::reg_name_chars, true);
+        if(u.has_port())
+        {
+            bool keep = true;
+            if(opt_.remove_default_port)
+            {
+                std::uint16_t const def =
+                    default_port(string_to_scheme(
+                        u.scheme()));
+                keep = ! u.port().empty() &&
+                    (def == 0 ||
+                        u.port_number() != def);
+            }
+            if(keep)
+            {
+                out.put(':');
+                out.put(u.port());
+            }
+        }
+    }
+
+    // path
+    {
+        char* const first = scratch;
+        char* last = detail::normalize_octets(
+            first, path, detail::segment_chars);
+        if(opt_.remove_dot_segments)
+        {
+            last = first + detail::remove_dot_segments(
+                first, last, core::string_view(
+                    first, static_cast<std::size_t>(
+                        last - first)));
+        }
+        if(first == last && u.has_authority())
+            out.put('/');
+        else
+            out.put(core::string_view(first,
+                static_cast<std::size_t>(last - first)));
+    }
+
+    // query
+    if(np != 0)
+    {
+        param_ref* const p0 =
+            reinterpret_cast<param_ref*>(
+                scratch + path_size);
+        param_ref* pn = p0;
+        char const* it = query.data();
+        char const* const end = it + query.size();
+        for(;;)
+        {
+            char const* const first = it;
+            char const* eq = nullptr;
+            while(it != end && *it != '&')
+            {
+                if(! eq && *it == '=')
+                    eq = it;
+                ++it;
+            }
+            param_ref const p{ first,
+                static_cast<std::uint32_t>(it - first),
+                static_cast<std::uint32_t>(
+                    (eq ? eq : it) - first) };
+            if(! std::binary_search(
+                ignored_.begin(), ignored_.end(),
+                p.key(),
+                [](core::string_view a,
+                    core::string_view b)
+                {
+                    return detail::compare_encoded(a, b) < 0;
+                }))
+            {
+                *pn++ = p;
+            }
+            if(it == end)
+                break;
+            ++it;
+        }
+        if(opt_.sort_params)
+            std::sort(p0, pn, param_less);
+        char sep = '?';
+        for(param_ref const* p = p0; p != pn; ++p)
+        {
+            out.put(sep);
+            put_octets(out, p->key(),
+                cache_key_chars);
+            if(p->key_size != p->size)
+            {
+                out.put('=');
+                put_octets(out, p->value(),
+                    cache_value_chars);
+            }
+            sep = '&';
+        }
+    }
+
+    // fragment
+    if( ! opt_.remove_fragment &&
+        u.has_fragment())
+    {
+        out.put('#');
+        put_octets(out, u.encoded_fragment(),
+            detail::fragment_chars);
+    }
+
+    auto const d = out.h.digest128();
+    return { d.first, d.second };
+}
+
+} // urls
+} // boost
+
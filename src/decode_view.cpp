@@ -11,35 +11,93 @@
 #include <boost/url/detail/config.hpp>
 #include <boost/url/decode_view.hpp>
 #include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstring>
 #include <ostream>
 
 namespace boost {
 namespace urls {
 
-namespace detail {
+namespace {
 
-template <class T>
+// The spans of a decoded string
+// as a sequence of characters
+struct decoded_spans
+{
+    decode_view::span_iterator it;
+    decode_view::span_iterator end;
+    core::string_view cur;
+    bool first = true;
+
+    explicit
+    decoded_spans(
+        decode_view const& s) noexcept
+        : it(s.span_begin())
+        , end(s.span_end())
+    {
+    }
+
+    decoded_spans(
+        decoded_spans const&) = delete;
+
+    // ensure cur is not empty, or
+    // return false at the end
+    bool
+    fill() noexcept
+    {
+        if(! cur.empty())
+            return true;
+        if(it == end)
+            return false;
+        if(! first)
+        {
+            ++it;
+            if(it == end)
+                return false;
+        }
+        first = false;
+        // cur may reference it
+        cur = *it;
+        return true;
+    }
+};
+
+struct string_spans
+{
+    core::string_view cur;
+
+    bool
+    fill() const noexcept
+    {
+        return ! cur.empty();
+    }
+};
+
+template<class S0, class S1>
 int
-decoded_strcmp(decode_view s0, T s1)
-{
-    auto const n0 = s0.size();
-    auto const n1 = s1.size();
-    auto n = (std::min)(n0, n1);
-    auto it0 = s0.begin();
-    auto it1 = s1.begin();
-    while (n--)
-    {
-        const char c0 = *it0++;
-        const char c1 = *it1++;
-        if (c0 == c1)
-            continue;
-        return 1 - 2 * (static_cast<unsigned char>(c0)
-                      < static_cast<unsigned char>(c1));
+compare_spans(
+    S0& s0,
+    S1& s1) noexcept
+{
+    for(;;)
+    {
+        bool const b0 = s0.fill();
+        bool const b1 = s1.fill();
+        if(! b0 || ! b1)
+            return b0 - b1;
+        std::size_t const n = (std::min)(
+            s0.cur.size(), s1.cur.size());
+        int const r = std::memcmp(
+            s0.cur.data(), s1.cur.data(), n);
+        if(r != 0)
+            return r < 0 ? -1 : 1;
+        s0.cur.remove_prefix(n);
+        s1.cur.remove_prefix(n);
     }
-    return 1 - (n0 == n1) - 2 * (n0 < n1);
 }
 
-} // detail
+} // (anon)
 
 //------------------------------------------------
 
@@ -63,6 +121,54 @@ operator*() const noexcept ->
              unsigned char>(d1))));
 }
 
+void
+decode_view::
+span_iterator::
+load() noexcept
+{
+    decoded_ = false;
+    if(pos_ == end_)
+    {
+        n_ = 0;
+        return;
+    }
+    if(*pos_ == '%')
+    {
+        BOOST_ASSERT(end_ - pos_ >= 3);
+        auto d0 = grammar::hexdig_value(pos_[1]);
+        auto d1 = grammar::hexdig_value(pos_[2]);
+        c_ = static_cast<char>(
+            ((static_cast<
+                unsigned char>(d0) << 4) +
+            (static_cast<
+                unsigned char>(d1))));
+        n_ = 3;
+        decoded_ = true;
+        return;
+    }
+    if(! space_as_plus_)
+    {
+        auto const p = static_cast<
+            char const*>(std::memchr(
+                pos_, '%', end_ - pos_));
+        n_ = (p ? p : end_) - pos_;
+        return;
+    }
+    if(*pos_ == '+')
+    {
+        c_ = ' ';
+        n_ = 1;
+        decoded_ = true;
+        return;
+    }
+    auto p = pos_ + 1;
+    while( p != end_ &&
+        *p != '%' &&
+        *p != '+')
+        ++p;
+    n_ = p - pos_;
+}
+
 // unchecked constructor
 decode_view::
 decode_view(
@@ -81,40 +187,94 @@ int
 decode_view::
 compare(core::string_view other) const noexcept
 {
-    return detail::decoded_strcmp(*this, other);
+    decoded_spans s0(*this);
+    string_spans s1{other};
+    return compare_spans(s0, s1);
 }
 
 int
 decode_view::
 compare(decode_view other) const noexcept
 {
-    return detail::decoded_strcmp(*this, other);
+    decoded_spans s0(*this);
+    decoded_spans s1(other);
+    return compare_spans(s0, s1);
 }
 
 void
 decode_view::
 write(std::ostream& os) const
 {
-    auto it = begin();
-    auto const end_ = end();
-    while(it != end_)
-        os.put(*it++);
+    auto it = span_begin();
+    auto const end = span_end();
+    for(; it != end; ++it)
+    {
+        auto const s = *it;
+        os.write(s.data(), s.size());
+    }
+}
+
+auto
+decode_view::
+copy(
+    char* dest,
+    size_type count,
+    size_type pos) const noexcept ->
+        size_type
+{
+    BOOST_ASSERT(pos <= size());
+    decoded_spans s(*this);
+    while(pos != 0)
+    {
+        s.fill();
+        std::size_t const n = (std::min)(
+            pos, s.cur.size());
+        s.cur.remove_prefix(n);
+        pos -= n;
+    }
+    size_type n0 = 0;
+    while( count != 0 &&
+        s.fill())
+    {
+        std::size_t const n = (std::min)(
+            count, s.cur.size());
+        std::memcpy(dest, s.cur.data(), n);
+        s.cur.remove_prefix(n);
+        dest += n;
+        count -= n;
+        n0 += n;
+    }
+    return n0;
 }
 
 void
 decode_view::
 remove_prefix( size_type n )
 {
-    auto it = begin();
-    auto n0 = n;
-    while (n)
+    BOOST_ASSERT(n <= size());
+    char const* p = p_;
+    auto it = span_begin();
+    auto const end = span_end();
+    size_type k = n;
+    for(; k != 0; ++it)
     {
-        ++it;
-        --n;
+        BOOST_ASSERT(it != end);
+        core::string_view const e =
+            it.encoded();
+        if(it.decoded())
+        {
+            p = e.data() + e.size();
+            --k;
+            continue;
+        }
+        std::size_t const m =
+            (std::min)(k, e.size());
+        p = e.data() + m;
+        k -= m;
     }
-    n_ -= (it.base() - begin().base());
-    dn_ -= n0;
-    p_ = it.base();
+    n_ -= p - p_;
+    dn_ -= n;
+    p_ = p;
 }
 
 void
@@ -138,16 +298,18 @@ starts_with( core::string_view s ) const noexcept
 {
     if (s.size() > size())
         return false;
-    auto it0 = begin();
-    auto it1 = s.begin();
-    std::size_t n = s.size();
-    while (n)
+    decoded_spans s0(*this);
+    string_spans s1{s};
+    while(s1.fill())
     {
-        if (*it0 != *it1)
+        s0.fill();
+        std::size_t const n = (std::min)(
+            s0.cur.size(), s1.cur.size());
+        if(std::memcmp(
+            s0.cur.data(), s1.cur.data(), n) != 0)
             return false;
-        ++it0;
-        ++it1;
-        --n;
+        s0.cur.remove_prefix(n);
+        s1.cur.remove_prefix(n);
     }
     return true;
 }
@@ -196,15 +358,29 @@ decode_view::const_iterator
 decode_view::
 find( char ch ) const noexcept
 {
-    auto it = begin();
-    auto end = this->end();
-    while (it != end)
+    auto it = span_begin();
+    auto const end = span_end();
+    for(; it != end; ++it)
     {
-        if (*it == ch)
-            return it;
-        ++it;
+        core::string_view const e =
+            it.encoded();
+        char const* p = e.data();
+        if(it.decoded())
+        {
+            if(*(*it).data() != ch)
+                continue;
+        }
+        else
+        {
+            p = static_cast<char const*>(
+                std::memchr(e.data(), ch, e.size()));
+            if(! p)
+                continue;
+        }
+        return { p_, static_cast<
+            size_type>(p - p_), space_as_plus_ };
     }
-    return it;
+    return this->end();
 }
 
 decode_view::const_iterator
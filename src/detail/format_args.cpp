@@ -17,6 +17,19 @@
 #include <boost/url/grammar/parse.hpp>
 #include <boost/url/grammar/tuple_rule.hpp>
 #include <boost/url/grammar/unsigned_rule.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <clocale>
+#include <limits>
+#ifndef BOOST_NO_CXX17_HDR_CHARCONV
+#include <charconv>
+# define BOOST_URL_HAS_TO_CHARS
+# if defined(__cpp_lib_to_chars) && \
+    __cpp_lib_to_chars >= 201611L
+#  define BOOST_URL_HAS_FLOAT_TO_CHARS
+# endif
+#endif
 
 namespace boost {
 namespace urls {
@@ -229,9 +242,21 @@ get_width_from_args(
     w = warg.value();
 }
 
+namespace {
+
+// the largest precision of a floating
+// point number, which bounds the size
+// of the buffer it is printed to
+constexpr std::size_t max_float_precision = 100;
+constexpr std::size_t float_buffer_size = 512;
+
+// [[fill] align] [sign] ["#"] ["0"] [width]
+// ["." precision] [type]
 char const*
-integer_formatter_impl::
-parse(format_parse_context& ctx)
+parse_number_spec(
+    format_parse_context& ctx,
+    number_spec& spec,
+    bool floating)
 {
     char const* it = ctx.begin();
     char const* end = ctx.end();
@@ -246,19 +271,19 @@ parse(format_parse_context& ctx)
              *(it + 1) == '>' ||
              *(it + 1) == '^'))
         {
-            fill = *it;
-            align = *(it + 1);
+            spec.fill = *it;
+            spec.align = *(it + 1);
             it += 2;
         }
     }
 
     // align
-    if (align == '\0' &&
+    if (spec.align == '\0' &&
         (*it == '<' ||
          *it == '>' ||
          *it == '^'))
     {
-        align = *it++;
+        spec.align = *it++;
     }
 
     // sign
@@ -266,7 +291,7 @@ parse(format_parse_context& ctx)
         *it == '-' ||
         *it == ' ')
     {
-        sign = *it++;
+        spec.sign = *it++;
     }
 
     // #
@@ -279,7 +304,7 @@ parse(format_parse_context& ctx)
     // 0
     if (*it == '0')
     {
-        zeros = *it++;
+        spec.zeros = *it++;
     }
 
     // width
@@ -299,13 +324,13 @@ parse(format_parse_context& ctx)
         // rewind
         it = it0;
     }
-    else if (align != '\0')
+    else if (spec.align != '\0')
     {
         // width is ignored when align is '\0'
         if (rw->index() == 0)
         {
             // unsigned_rule
-            width = variant2::get<0>(*rw);
+            spec.width = variant2::get<0>(*rw);
         }
         else
         {
@@ -315,25 +340,47 @@ parse(format_parse_context& ctx)
             {
                 // empty arg_id, use and consume
                 // the next arg idx
-                width_idx = ctx.next_arg_id();
+                spec.width_idx = ctx.next_arg_id();
             }
             else if (arg_id->index() == 0)
             {
                 // string identifier
-                width_name = variant2::get<0>(*arg_id);
+                spec.width_name = variant2::get<0>(*arg_id);
             }
             else
             {
                 // integer identifier: use the
                 // idx of this format_arg
-                width_idx = variant2::get<1>(*arg_id);
+                spec.width_idx = variant2::get<1>(*arg_id);
             }
         }
     }
 
-    // type is parsed but doesn't have to
-    // be stored for strings
-    if (*it == 'd')
+    if (floating)
+    {
+        // precision
+        if (*it == '.')
+        {
+            ++it;
+            auto rp = grammar::parse(
+                it, end, grammar::unsigned_rule<std::size_t>{});
+            if (!rp ||
+                *rp > max_float_precision)
+            {
+                urls::detail::throw_invalid_argument();
+            }
+            spec.precision = static_cast<int>(*rp);
+        }
+
+        // type
+        if (*it == 'e' ||
+            *it == 'f' ||
+            *it == 'g')
+        {
+            spec.type = *it++;
+        }
+    }
+    else if (*it == 'd')
     {
         // we don't include other presentation
         // modes for integers as they are not
@@ -352,144 +399,180 @@ parse(format_parse_context& ctx)
 }
 
 std::size_t
-integer_formatter_impl::
-measure(
-    long long int v,
-    measure_context& ctx,
-    grammar::lut_chars const& cs) const
+get_number_width(
+    number_spec const& spec,
+    format_args args)
 {
-    std::size_t dn = 0;
-    std::size_t n = 0;
-    if (v < 0)
-    {
-        dn += measure_one('-', cs);
-        ++n;
-        v *= -1;
-    }
-    else if (sign != '-')
-    {
-        dn += measure_one(sign, cs);
-        ++n;
-    }
-    do
-    {
-        int d = v % 10;
-        v /= 10;
-        dn += measure_one('0' + static_cast<char>(d), cs);
-        ++n;
-    }
-    while (v > 0);
-
-    std::size_t w = width;
-    if (width_idx != std::size_t(-1) ||
-        !width_name.empty())
+    std::size_t w = spec.width;
+    if (spec.width_idx != std::size_t(-1) ||
+        !spec.width_name.empty())
     {
         get_width_from_args(
-            width_idx, width_name, ctx.args(), w);
+            spec.width_idx, spec.width_name, args, w);
     }
-    if (w > n)
-    {
-        if (!zeros)
-            dn += measure_one(fill, cs) * (w - n);
-        else
-            dn += measure_one('0', cs) * (w - n);
-    }
-    return ctx.out() + dn;
+    return w;
 }
 
-std::size_t
-integer_formatter_impl::
-measure(
-    unsigned long long int v,
-    measure_context& ctx,
-    grammar::lut_chars const& cs) const
+// print the decimal digits of v,
+// returning the end of the digits
+char*
+print_digits(
+    char* first,
+    char* last,
+    unsigned long long int v) noexcept
 {
-    std::size_t dn = 0;
-    std::size_t n = 0;
-    if (sign != '-')
-    {
-        dn += measure_one(sign, cs);
-        ++n;
-    }
+#ifdef BOOST_URL_HAS_TO_CHARS
+    auto r = std::to_chars(first, last, v);
+    BOOST_ASSERT(r.ec == std::errc());
+    return r.ptr;
+#else
+    char tmp[std::numeric_limits<
+        unsigned long long int>::digits10 + 1];
+    char* const tmp_end = tmp + sizeof(tmp);
+    char* p = tmp_end;
     do
     {
-        int d = v % 10;
+        *--p = '0' + static_cast<char>(v % 10);
         v /= 10;
-        dn += measure_one('0' + static_cast<char>(d), cs);
-        ++n;
     }
     while (v != 0);
+    std::size_t const n = tmp_end - p;
+    BOOST_ASSERT(n <= static_cast<std::size_t>(last - first));
+    ignore_unused(last);
+    std::memcpy(first, p, n);
+    return first + n;
+#endif
+}
 
-    std::size_t w = width;
-    if (width_idx != std::size_t(-1) ||
-        !width_name.empty())
-    {
-        get_width_from_args(
-            width_idx, width_name, ctx.args(), w);
-    }
-    if (w > n)
-    {
-        if (!zeros)
-            dn += measure_one(fill, cs) * (w - n);
-        else
-            dn += measure_one('0', cs) * (w - n);
-    }
-    return ctx.out() + dn;
+// print an integer with its sign
+core::string_view
+print_integer(
+    char (&buf)[24],
+    unsigned long long int v,
+    bool negative,
+    char sign) noexcept
+{
+    char* p = buf;
+    if (negative)
+        *p++ = '-';
+    else if (sign != '-')
+        *p++ = sign;
+    p = print_digits(p, buf + sizeof(buf), v);
+    return core::string_view(buf, p - buf);
 }
 
-char*
-integer_formatter_impl::
-format(
+core::string_view
+print_integer(
+    char (&buf)[24],
     long long int v,
-    format_context& ctx,
-    grammar::lut_chars const& cs) const
+    char sign) noexcept
 {
-    // get n digits
-    long long int v0 = v;
-    long long int p = 1;
-    std::size_t n = 0;
-    if (v < 0)
-    {
-        v *= - 1;
-        ++n;
-    }
-    else if (sign != '-')
-    {
-        ++n;
+    // the magnitude of the smallest
+    // value is not a long long int
+    bool const negative = v < 0;
+    unsigned long long int const u = negative ?
+        0ull - static_cast<unsigned long long int>(v) :
+        static_cast<unsigned long long int>(v);
+    return print_integer(buf, u, negative, sign);
+}
+
+// print a floating point number with its sign
+core::string_view
+print_float(
+    char (&buf)[float_buffer_size],
+    double v,
+    number_spec const& spec) noexcept
+{
+    char* p = buf;
+    char* const last = buf + sizeof(buf);
+    if (!std::signbit(v) &&
+        spec.sign != '-')
+        *p++ = spec.sign;
+#ifdef BOOST_URL_HAS_FLOAT_TO_CHARS
+    std::to_chars_result r;
+    if (spec.type == '\0' &&
+        spec.precision < 0)
+    {
+        // shortest representation
+        r = std::to_chars(p, last, v);
     }
-    do
+    else
     {
-        if (v >= 10)
-            p *= 10;
-        v /= 10;
-        ++n;
-    }
-    while (v > 0);
-    static constexpr auto m =
-        std::numeric_limits<long long int>::digits10;
-    BOOST_ASSERT(n <= m + 1);
-    ignore_unused(m);
+        std::chars_format f =
+            spec.type == 'e' ? std::chars_format::scientific :
+            spec.type == 'f' ? std::chars_format::fixed :
+            std::chars_format::general;
+        r = std::to_chars(p, last, v, f,
+            spec.precision < 0 ? 6 : spec.precision);
+    }
+    BOOST_ASSERT(r.ec == std::errc());
+    p = r.ptr;
+#else
+    // without to_chars, the shortest
+    // representation is approximated
+    // with the precision of a double
+    char f[] = "%.*g";
+    if (spec.type != '\0')
+        f[3] = spec.type;
+    int const precision =
+        spec.precision >= 0 ? spec.precision :
+        spec.type != '\0' ? 6 :
+        std::numeric_limits<double>::max_digits10;
+    int const n = std::snprintf(
+        p, last - p, f, precision, v);
+    BOOST_ASSERT(n >= 0 && n < last - p);
+    // the decimal point depends on the locale
+    char const dp = *std::localeconv()->decimal_point;
+    for (char* it = p; it != p + n; ++it)
+    {
+        if (*it == dp)
+            *it = '.';
+    }
+    p += n;
+#endif
+    return core::string_view(buf, p - buf);
+}
 
-    // get pad
-    std::size_t w = width;
-    if (width_idx != std::size_t(-1) ||
-        !width_name.empty())
+std::size_t
+measure_number(
+    core::string_view s,
+    number_spec const& spec,
+    measure_context& ctx,
+    grammar::lut_chars const& cs)
+{
+    std::size_t n = encoded_size(s, cs);
+    std::size_t const w = get_number_width(
+        spec, ctx.args());
+    if (w > s.size())
     {
-        get_width_from_args(
-            width_idx, width_name, ctx.args(), w);
+        n += measure_one(
+            spec.zeros ? '0' : spec.fill, cs) *
+                (w - s.size());
     }
+    return ctx.out() + n;
+}
+
+char*
+format_number(
+    core::string_view s,
+    number_spec const& spec,
+    format_context& ctx,
+    grammar::lut_chars const& cs)
+{
+    std::size_t const w = get_number_width(
+        spec, ctx.args());
     std::size_t lpad = 0;
     std::size_t rpad = 0;
-    if (w > n)
+    if (w > s.size())
     {
-        std::size_t pad = w - n;
-        if (zeros)
+        std::size_t pad = w - s.size();
+        if (spec.zeros)
         {
             lpad = pad;
         }
         else
         {
-            switch (align)
+            switch (spec.align)
             {
             case '<':
                 rpad = pad;
@@ -505,141 +588,138 @@ format(
         }
     }
 
-    // write
-    v = v0;
     char* out = ctx.out();
-    if (!zeros)
+    if (spec.zeros)
     {
+        // zeros go after the sign
+        if (!s.empty() &&
+            (s.front() == '-' ||
+             s.front() == '+' ||
+             s.front() == ' '))
+        {
+            encode_one(out, s.front(), cs);
+            s.remove_prefix(1);
+        }
         for (std::size_t i = 0; i < lpad; ++i)
-            encode_one(out, fill, cs);
-    }
-    if (v < 0)
-    {
-        encode_one(out, '-', cs);
-        v *= -1;
-        --n;
-    }
-    else if (sign != '-')
-    {
-        encode_one(out, sign, cs);
-        --n;
+            encode_one(out, '0', cs);
     }
-    if (zeros)
+    else
     {
         for (std::size_t i = 0; i < lpad; ++i)
-            encode_one(out, '0', cs);
+            encode_one(out, spec.fill, cs);
     }
-    while (n)
+    if (grammar::find_if_not(
+            s.begin(), s.end(), cs) == s.end())
     {
-        unsigned long long int d = v / p;
-        encode_one(out, '0' + static_cast<char>(d), cs);
-        --n;
-        v %= p;
-        p /= 10;
+        // digits are unreserved in
+        // most components
+        std::memcpy(out, s.data(), s.size());
+        out += s.size();
     }
-    if (!zeros)
+    else
     {
-        for (std::size_t i = 0; i < rpad; ++i)
-            encode_one(out, fill, cs);
+        for (char c : s)
+            encode_one(out, c, cs);
     }
+    for (std::size_t i = 0; i < rpad; ++i)
+        encode_one(out, spec.fill, cs);
     return out;
 }
 
+} // (anon)
+
+char const*
+integer_formatter_impl::
+parse(format_parse_context& ctx)
+{
+    return parse_number_spec(
+        ctx, spec_, false);
+}
+
+std::size_t
+integer_formatter_impl::
+measure(
+    long long int v,
+    measure_context& ctx,
+    grammar::lut_chars const& cs) const
+{
+    char buf[24];
+    return measure_number(
+        print_integer(buf, v, spec_.sign),
+        spec_, ctx, cs);
+}
+
+std::size_t
+integer_formatter_impl::
+measure(
+    unsigned long long int v,
+    measure_context& ctx,
+    grammar::lut_chars const& cs) const
+{
+    char buf[24];
+    return measure_number(
+        print_integer(buf, v, false, spec_.sign),
+        spec_, ctx, cs);
+}
+
 char*
 integer_formatter_impl::
 format(
-unsigned long long int v,
-format_context& ctx,
-grammar::lut_chars const& cs) const
+    long long int v,
+    format_context& ctx,
+    grammar::lut_chars const& cs) const
 {
-    // get n digits
-    unsigned long long int v0 = v;
-    unsigned long long int p = 1;
-    std::size_t n = 0;
-    if (sign != '-')
-    {
-        ++n;
-    }
-    do
-    {
-        if (v >= 10)
-            p *= 10;
-        v /= 10;
-        ++n;
-    }
-    while (v > 0);
-    static constexpr auto m =
-        std::numeric_limits<unsigned long long int>::digits10;
-    BOOST_ASSERT(n <= m + 1);
-    ignore_unused(m);
+    char buf[24];
+    return format_number(
+        print_integer(buf, v, spec_.sign),
+        spec_, ctx, cs);
+}
 
-    // get pad
-    std::size_t w = width;
-    if (width_idx != std::size_t(-1) ||
-        !width_name.empty())
-    {
-        get_width_from_args(
-            width_idx, width_name, ctx.args(), w);
-    }
-    std::size_t lpad = 0;
-    std::size_t rpad = 0;
-    if (w > n)
-    {
-        std::size_t pad = w - n;
-        if (zeros)
-        {
-            lpad = pad;
-        }
-        else
-        {
-            switch (align)
-            {
-            case '<':
-                rpad = pad;
-                break;
-            case '>':
-                lpad = pad;
-                break;
-            case '^':
-                lpad = pad / 2;
-                rpad = pad - lpad;
-                break;
-            }
-        }
-    }
+char*
+integer_formatter_impl::
+format(
+    unsigned long long int v,
+    format_context& ctx,
+    grammar::lut_chars const& cs) const
+{
+    char buf[24];
+    return format_number(
+        print_integer(buf, v, false, spec_.sign),
+        spec_, ctx, cs);
+}
 
-    // write
-    v = v0;
-    char* out = ctx.out();
-    if (!zeros)
-    {
-        for (std::size_t i = 0; i < lpad; ++i)
-            encode_one(out, fill, cs);
-    }
-    if (sign != '-')
-    {
-        encode_one(out, sign, cs);
-        --n;
-    }
-    if (zeros)
-    {
-        for (std::size_t i = 0; i < lpad; ++i)
-            encode_one(out, '0', cs);
-    }
-    while (n)
-    {
-        unsigned long long int d = v / p;
-        encode_one(out, '0' + static_cast<char>(d), cs);
-        --n;
-        v %= p;
-        p /= 10;
-    }
-    if (!zeros)
-    {
-        for (std::size_t i = 0; i < rpad; ++i)
-            encode_one(out, fill, cs);
-    }
-    return out;
+char const*
+float_formatter_impl::
+parse(format_parse_context& ctx)
+{
+    return parse_number_spec(
+        ctx, spec_, true);
+}
+
+std::size_t
+float_formatter_impl::
+measure(
+    double v,
+    measure_context& ctx,
+    grammar::lut_chars const& cs) const
+{
+    char buf[float_buffer_size];
+    return measure_number(
+        print_float(buf, v, spec_),
+        spec_, ctx, cs);
+}
+
+char*
+float_formatter_impl::
+format(
+    double v,
+    format_context& ctx,
+    grammar::lut_chars const& cs) const
+{
+    char buf[float_buffer_size];
+    return format_number(
+        print_float(buf, v, spec_),
+        spec_, ctx, cs);
 }
 
 } // detail
@@ -77,14 +77,24 @@ compare_encoded(
 void
 digest_encoded(
     core::string_view s,
-    fnv_1a& hasher) noexcept
+    sip_hasher& hasher) noexcept
 {
-    char c = 0;
-    std::size_t n = 0;
+    // unescaped runs are hashed
+    // a word at a time
     while(!s.empty())
     {
-        pop_encoded_front(s, c, n);
+        auto const i = s.find('%');
+        if(i == core::string_view::npos)
+        {
+            hasher.put(s);
+            return;
+        }
+        hasher.put(s.substr(0, i));
+        char c = 0;
+        detail::decode_unsafe(
+            &c, &c + 1, s.substr(i, 3));
         hasher.put(c);
+        s.remove_prefix(i + 3);
     }
 }
 
@@ -122,7 +132,7 @@ ci_compare_encoded(
 void
 ci_digest_encoded(
     core::string_view s,
-    fnv_1a& hasher) noexcept
+    sip_hasher& hasher) noexcept
 {
     char c = 0;
     std::size_t n = 0;
@@ -181,7 +191,7 @@ ci_compare(
 void
 ci_digest(
     core::string_view s,
-    fnv_1a& hasher) noexcept
+    sip_hasher& hasher) noexcept
 {
     for (char c: s)
     {
@@ -287,6 +297,75 @@ path_ends_with(
     return 0;
 }
 
+std::size_t
+normalized_path_prefix(
+    core::string_view p,
+    bool has_scheme,
+    bool has_authority,
+    bool& encode_colons,
+    core::string_view& first_seg) noexcept
+{
+    std::size_t skip_dot = 0;
+    encode_colons = false;
+    first_seg = {};
+    if (
+        !has_authority &&
+        p.starts_with("/./"))
+    {
+        // check if removing the "/./" would result in "//"
+        // ex: "/.//", "/././/", "/././/", ...
+        skip_dot = 2;
+        while (p.substr(skip_dot, 3).starts_with("/./"))
+            skip_dot += 2;
+        if (p.substr(skip_dot).starts_with("//"))
+            skip_dot = 2;
+        else
+            skip_dot = 0;
+    }
+    else if (
+        !has_scheme &&
+        !has_authority)
+    {
+        if (p.starts_with("./"))
+        {
+            // check if removing the "./" would result in "//"
+            // ex: ".//", "././/", "././/", ...
+            skip_dot = 1;
+            while (p.substr(skip_dot, 3).starts_with("/./"))
+                skip_dot += 2;
+            if (p.substr(skip_dot).starts_with("//"))
+                skip_dot = 2;
+            else
+                skip_dot = 0;
+
+            if ( !skip_dot )
+            {
+                // check if removing "./"s would leave us
+                // a first segment with an ambiguous ":"
+                first_seg = p.substr(2);
+                while (first_seg.starts_with("./"))
+                    first_seg = first_seg.substr(2);
+                auto i = first_seg.find('/');
+                if (i != core::string_view::npos)
+                    first_seg = first_seg.substr(0, i);
+                encode_colons = first_seg.contains(':');
+            }
+        }
+        else
+        {
+            // check if normalize_octets
+            // didn't already create a ":"
+            // in the first segment
+            first_seg = p;
+            auto i = first_seg.find('/');
+            if (i != core::string_view::npos)
+                first_seg = p.substr(0, i);
+            encode_colons = first_seg.contains(':');
+        }
+    }
+    return skip_dot;
+}
+
 std::size_t
 remove_dot_segments(
     char* dest0,
@@ -601,18 +680,15 @@ pop_last_segment(
         // a complete path segment, then replace
         // that prefix with "/" in the input
         // buffer; otherwise,
+        // the "/" is kept so an empty
+        // segment before the prefix is
+        // not merged with the previous one
         n = detail::path_ends_with(s, "/./");
+        if (!n)
+            n = detail::path_ends_with(s, "/.");
         if (n)
         {
-            c = s.substr(s.size() - n);
-            s.remove_suffix(n);
-            continue;
-        }
-        n = detail::path_ends_with(s, "/.");
-        if (n)
-        {
-            c = s.substr(s.size() - n, 1);
-            s.remove_suffix(n);
+            s.remove_suffix(n - 1);
             continue;
         }
 
@@ -625,18 +701,11 @@ pop_last_segment(
         // (if any) from the output buffer
         // otherwise,
         n = detail::path_ends_with(s, "/../");
+        if (!n)
+            n = detail::path_ends_with(s, "/..");
         if (n)
         {
-            c = s.substr(s.size() - n);
-            s.remove_suffix(n);
-            ++level;
-            continue;
-        }
-        n = detail::path_ends_with(s, "/..");
-        if (n)
-        {
-            c = s.substr(s.size() - n);
-            s.remove_suffix(n);
+            s.remove_suffix(n - 1);
             ++level;
             continue;
         }
@@ -691,7 +760,7 @@ void
 normalized_path_digest(
     core::string_view s,
     bool remove_unmatched,
-    fnv_1a& hasher) noexcept
+    sip_hasher& hasher) noexcept
 {
     core::string_view child;
     std::size_t level = 0;
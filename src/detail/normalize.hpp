@@ -13,60 +13,155 @@
 
 #include <boost/core/detail/string_view.hpp>
 #include "boost/url/segments_encoded_view.hpp"
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/assert.hpp>
+#include "decode.hpp"
+#include <cstdint>
+#include <utility>
 
 namespace boost {
 namespace urls {
 namespace detail {
 
-class fnv_1a
+// SipHash, fed one 64-bit word at a time.
+// The key makes the digest unpredictable,
+// which resists hash flooding, and the
+// 128-bit mode is suitable for dedup.
+// C and D are the number of compression
+// and finalization rounds.
+template<int C, int D>
+class basic_sip_hasher
 {
 public:
     using digest_type = std::size_t;
 
-#if BOOST_URL_ARCH == 64
-    static constexpr std::size_t const prime =
-        static_cast<std::size_t>(0x100000001B3ULL);
-    static constexpr std::size_t init_hash  =
-        static_cast<std::size_t>(0xcbf29ce484222325ULL);
-#else
-    static constexpr std::size_t const prime =
-        static_cast<std::size_t>(0x01000193UL);
-    static constexpr std::size_t init_hash  =
-        static_cast<std::size_t>(0x811C9DC5UL);
-#endif
-
     explicit
-    fnv_1a(std::size_t salt) noexcept
-    : h_(init_hash + salt)
+    basic_sip_hasher(
+        std::uint64_t k0,
+        std::uint64_t k1 = 0,
+        bool wide = false) noexcept
+        : v0_(k0 ^ 0x736f6d6570736575ULL)
+        , v1_(k1 ^ 0x646f72616e646f6dULL)
+        , v2_(k0 ^ 0x6c7967656e657261ULL)
+        , v3_(k1 ^ 0x7465646279746573ULL)
+        , wide_(wide)
     {
+        if(wide_)
+            v1_ ^= 0xee;
     }
 
     void
     put(char c) noexcept
     {
-        h_ ^= c;
-        h_ *= prime;
+        b_ |= static_cast<std::uint64_t>(
+            static_cast<unsigned char>(c)) <<
+                (8 * (n_ & 7));
+        if((++n_ & 7) == 0)
+        {
+            compress(b_);
+            b_ = 0;
+        }
     }
 
     void
     put(core::string_view s) noexcept
     {
-        for (char c: s)
+        char const* p = s.data();
+        std::size_t n = s.size();
+        while(n && (n_ & 7))
+        {
+            put(*p++);
+            --n;
+        }
+        while(n >= 8)
         {
-            put(c);
+            std::uint64_t m = 0;
+            for(int i = 7; i >= 0; --i)
+                m = (m << 8) |
+                    static_cast<unsigned char>(p[i]);
+            compress(m);
+            n_ += 8;
+            p += 8;
+            n -= 8;
         }
+        while(n--)
+            put(*p++);
     }
 
     digest_type
     digest() const noexcept
     {
-        return h_;
+        basic_sip_hasher h(*this);
+        return static_cast<digest_type>(
+            h.finish());
+    }
+
+    std::pair<std::uint64_t, std::uint64_t>
+    digest128() const noexcept
+    {
+        BOOST_ASSERT(wide_);
+        basic_sip_hasher h(*this);
+        std::uint64_t const lo = h.finish();
+        h.v1_ ^= 0xdd;
+        for(int i = 0; i < D; ++i)
+            h.round();
+        return { lo,
+            h.v0_ ^ h.v1_ ^ h.v2_ ^ h.v3_ };
     }
 
 private:
-    std::size_t h_;
+    static
+    std::uint64_t
+    rotl(std::uint64_t x, int b) noexcept
+    {
+        return (x << b) | (x >> (64 - b));
+    }
+
+    void
+    round() noexcept
+    {
+        v0_ += v1_; v1_ = rotl(v1_, 13);
+        v1_ ^= v0_; v0_ = rotl(v0_, 32);
+        v2_ += v3_; v3_ = rotl(v3_, 16);
+        v3_ ^= v2_;
+        v0_ += v3_; v3_ = rotl(v3_, 21);
+        v3_ ^= v0_;
+        v2_ += v1_; v1_ = rotl(v1_, 17);
+        v1_ ^= v2_; v2_ = rotl(v2_, 32);
+    }
+
+    void
+    compress(std::uint64_t m) noexcept
+    {
+        v3_ ^= m;
+        for(int i = 0; i < C; ++i)
+            round();
+        v0_ ^= m;
+    }
+
+    std::uint64_t
+    finish() noexcept
+    {
+        compress(b_ | (static_cast<
+            std::uint64_t>(n_ & 0xff) << 56));
+        v2_ ^= wide_ ? 0xee : 0xff;
+        for(int i = 0; i < D; ++i)
+            round();
+        return v0_ ^ v1_ ^ v2_ ^ v3_;
+    }
+
+    std::uint64_t v0_;
+    std::uint64_t v1_;
+    std::uint64_t v2_;
+    std::uint64_t v3_;
+    std::uint64_t b_ = 0;
+    std::size_t n_ = 0;
+    bool wide_;
 };
 
+// SipHash-1-3
+using sip_hasher = basic_sip_hasher<1, 3>;
+
 void
 pop_encoded_front(
     core::string_view& s,
@@ -85,12 +180,12 @@ compare_encoded(
 void
 digest_encoded(
     core::string_view s,
-    fnv_1a& hasher) noexcept;
+    sip_hasher& hasher) noexcept;
 
 void
 digest(
     core::string_view s,
-    fnv_1a& hasher) noexcept;
+    sip_hasher& hasher) noexcept;
 
 // check if core::string_view lhs starts with core::string_view
 // rhs as if they are both percent-decoded. If
@@ -122,7 +217,7 @@ ci_compare_encoded(
 void
 ci_digest_encoded(
     core::string_view s,
-    fnv_1a& hasher) noexcept;
+    sip_hasher& hasher) noexcept;
 
 // compare two ascii core::string_views
 int
@@ -141,7 +236,62 @@ ci_compare(
 void
 ci_digest(
     core::string_view s,
-    fnv_1a& hasher) noexcept;
+    sip_hasher& hasher) noexcept;
+
+// normalize the percent-encoding of s
+// into dest, which may be s.data().
+// Escaped chars in the allowed set are
+// decoded and the hexdigs of the other
+// triplets are made uppercase. Return
+// the new end of the output.
+template<class CharSet>
+char*
+normalize_octets(
+    char* dest,
+    core::string_view s,
+    CharSet const& allowed) noexcept
+{
+    char const* it = s.data();
+    char const* const end = it + s.size();
+    while (it < end)
+    {
+        if (*it != '%')
+        {
+            *dest++ = *it++;
+            continue;
+        }
+        BOOST_ASSERT(end - it >= 3);
+
+        // decode unreserved octets
+        char const d = detail::decode_one(it + 1);
+        if (allowed(d))
+        {
+            *dest++ = d;
+            it += 3;
+            continue;
+        }
+
+        // uppercase percent-encoding triplets
+        *dest++ = '%';
+        ++it;
+        *dest++ = grammar::to_upper(*it++);
+        *dest++ = grammar::to_upper(*it++);
+    }
+    return dest;
+}
+
+// return the size of a prefix of dot
+// segments the normalized path p can
+// drop, and whether colons in its first
+// segment first_seg need to be encoded
+// so it is not mistaken for a scheme
+std::size_t
+normalized_path_prefix(
+    core::string_view p,
+    bool has_scheme,
+    bool has_authority,
+    bool& encode_colons,
+    core::string_view& first_seg) noexcept;
 
 BOOST_URL_DECL
 std::size_t
@@ -164,7 +314,7 @@ void
 normalized_path_digest(
     core::string_view s,
     bool remove_unmatched,
-    fnv_1a& hasher) noexcept;
+    sip_hasher& hasher) noexcept;
 
 int
 segments_compare(
@@ -9,7 +9,7 @@
 
 
 #include <boost/url/detail/config.hpp>
-#include "pattern.hpp"
+#include <boost/url/detail/pattern.hpp>
 #include "pct_format.hpp"
 #include "boost/url/detail/replacement_field_rule.hpp"
 #include <boost/url/grammar/alpha_chars.hpp>
@@ -33,18 +33,8 @@ apply(
     url_base& u,
     format_args const& args) const
 {
-    // measure total
-    struct sizes
-    {
-        std::size_t scheme = 0;
-        std::size_t user = 0;
-        std::size_t pass = 0;
-        std::size_t host = 0;
-        std::size_t port = 0;
-        std::size_t path = 0;
-        std::size_t query = 0;
-        std::size_t frag = 0;
-    };
+    // measure total, the literal
+    // text is measured when parsing
     sizes n;
 
     format_parse_context pctx(nullptr, nullptr, 0);
@@ -52,7 +42,7 @@ apply(
     if (!scheme.empty())
     {
         pctx = {scheme, pctx.next_arg_id()};
-        n.scheme = pct_vmeasure(
+        n.scheme = literals.scheme + pct_vmeasure(
             grammar::alpha_chars, pctx, mctx);
         mctx.advance_to(0);
     }
@@ -61,13 +51,13 @@ apply(
         if (has_user)
         {
             pctx = {user, pctx.next_arg_id()};
-            n.user = pct_vmeasure(
+            n.user = literals.user + pct_vmeasure(
                 user_chars, pctx, mctx);
             mctx.advance_to(0);
             if (has_pass)
             {
                 pctx = {pass, pctx.next_arg_id()};
-                n.pass = pct_vmeasure(
+                n.pass = literals.pass + pct_vmeasure(
                     password_chars, pctx, mctx);
                 mctx.advance_to(0);
             }
@@ -76,21 +66,21 @@ apply(
         {
             BOOST_ASSERT(host.ends_with(']'));
             pctx = {host.substr(1, host.size() - 2), pctx.next_arg_id()};
-            n.host = pct_vmeasure(
+            n.host = literals.host + pct_vmeasure(
                 lhost_chars, pctx, mctx) + 2;
             mctx.advance_to(0);
         }
         else
         {
             pctx = {host, pctx.next_arg_id()};
-            n.host = pct_vmeasure(
+            n.host = literals.host + pct_vmeasure(
                 host_chars, pctx, mctx);
             mctx.advance_to(0);
         }
         if (has_port)
         {
             pctx = {port, pctx.next_arg_id()};
-            n.port = pct_vmeasure(
+            n.port = literals.port + pct_vmeasure(
                 grammar::digit_chars, pctx, mctx);
             mctx.advance_to(0);
         }
@@ -98,21 +88,21 @@ apply(
     if (!path.empty())
     {
         pctx = {path, pctx.next_arg_id()};
-        n.path = pct_vmeasure(
+        n.path = literals.path + pct_vmeasure(
             path_chars, pctx, mctx);
         mctx.advance_to(0);
     }
     if (has_query)
     {
         pctx = {query, pctx.next_arg_id()};
-        n.query = pct_vmeasure(
+        n.query = literals.query + pct_vmeasure(
             query_chars, pctx, mctx);
         mctx.advance_to(0);
     }
     if (has_frag)
     {
         pctx = {frag, pctx.next_arg_id()};
-        n.frag = pct_vmeasure(
+        n.frag = literals.frag + pct_vmeasure(
             fragment_chars, pctx, mctx);
         mctx.advance_to(0);
     }
@@ -340,7 +330,7 @@ apply(
 template<class CharSet>
 struct pct_encoded_fmt_string_rule_t
 {
-    using value_type = pct_string_view;
+    using value_type = core::string_view;
 
     constexpr
     pct_encoded_fmt_string_rule_t(
@@ -385,6 +375,11 @@ struct pct_encoded_fmt_string_rule_t
             }
             rv = literal_rule.parse(it, end);
         }
+        if(! rv)
+        {
+            // invalid escape
+            return rv.error();
+        }
 
         return core::string_view(start, it - start);
     }
@@ -417,7 +412,7 @@ pct_encoded_fmt_string_rule(
 template<class CharSet>
 struct fmt_token_rule_t
 {
-    using value_type = pct_string_view;
+    using value_type = core::string_view;
 
     constexpr
     fmt_token_rule_t(
@@ -535,7 +530,8 @@ struct userinfo_template_rule_t
             pct_encoded_fmt_string_rule(uchars);
         auto rv = grammar::parse(
             it, end, user_fmt_rule);
-        BOOST_ASSERT(rv);
+        if(! rv)
+            return rv.error();
         t.user = *rv;
 
         // ':'
@@ -553,7 +549,8 @@ struct userinfo_template_rule_t
             pct_encoded_fmt_string_rule(grammar::ref(pwchars));
         rv = grammar::parse(
             it, end, pass_fmt_rule);
-        BOOST_ASSERT(rv);
+        if(! rv)
+            return rv.error();
         t.has_password = true;
         t.password = *rv;
 
@@ -592,10 +589,11 @@ struct host_template_rule_t
                 pct_encoded_fmt_string_rule(host_chars);
             auto rv = grammar::parse(
                 it, end, any_host_template_rule);
-            // any_host_template_rule can always
-            // be empty, so it's never invalid
-            BOOST_ASSERT(rv);
-            return detail::to_sv(*rv);
+            // any_host_template_rule can be
+            // empty but escapes must be valid
+            if(! rv)
+                return rv.error();
+            return *rv;
         }
         // IP-literals need to be enclosed in
         // "[]" if using ':' in the template
@@ -615,9 +613,8 @@ struct host_template_rule_t
                     ip_literal_template_rule,
                     grammar::squelch(
                         grammar::delim_rule(']')))));
-        // ip_literal_template_rule can always
-        // be empty, so it's never invalid, but
-        // the rule might fail to match the
+        // the optional rule is never invalid,
+        // but the rule might fail to match the
         // closing "]"
         BOOST_ASSERT(rv);
         return core::string_view{it0, it};
@@ -664,7 +661,8 @@ struct authority_template_rule_t
                 it, end,
                 host_template_rule);
             // host is allowed to be empty
-            BOOST_ASSERT(rv);
+            if(! rv)
+                return rv.error();
             u.host = *rv;
         }
 
@@ -854,7 +852,8 @@ struct pattern_rule_t
                 it, end,
                 authority_template_rule);
             // authority is allowed to be empty
-            BOOST_ASSERT(rv);
+            if(! rv)
+                return rv.error();
             u.has_authority = true;
             u.has_user = rv->has_user;
             u.user = rv->user;
@@ -886,23 +885,24 @@ struct pattern_rule_t
         auto rp = grammar::parse(
             it, end, segment_fmt_rule);
         // path-abempty is allowed to be empty
-        BOOST_ASSERT(rp);
+        if(! rp)
+            return rp.error();
         u.path = *rp;
 
         // [ "?" query ]
         {
             static constexpr auto query_fmt_rule =
                 pct_encoded_fmt_string_rule(query_chars);
-            auto rv = grammar::parse(
-                it, end,
-                grammar::tuple_rule(
-                    grammar::squelch(
-                        grammar::delim_rule('?')),
-                    query_fmt_rule));
             // query is allowed to be empty but
-            // delim rule is not
-            if (rv)
+            // escapes must be valid
+            if( it != end &&
+                *it == '?')
             {
+                ++it;
+                auto rv = grammar::parse(
+                    it, end, query_fmt_rule);
+                if(! rv)
+                    return rv.error();
                 u.has_query = true;
                 u.query = *rv;
             }
@@ -912,16 +912,16 @@ struct pattern_rule_t
         {
             static constexpr auto frag_fmt_rule =
                 pct_encoded_fmt_string_rule(fragment_chars);
-            auto rv = grammar::parse(
-                it, end,
-                grammar::tuple_rule(
-                    grammar::squelch(
-                        grammar::delim_rule('#')),
-                    frag_fmt_rule));
             // frag is allowed to be empty but
-            // delim rule is not
-            if (rv)
+            // escapes must be valid
+            if( it != end &&
+                *it == '#')
             {
+                ++it;
+                auto rv = grammar::parse(
+                    it, end, frag_fmt_rule);
+                if(! rv)
+                    return rv.error();
                 u.has_frag = true;
                 u.frag = *rv;
             }
@@ -937,8 +937,12 @@ system::result<pattern>
 parse_pattern(
     core::string_view s)
 {
-    return grammar::parse(
+    auto rv = grammar::parse(
         s, pattern_rule);
+    if(! rv)
+        return rv.error();
+    constexpr_pattern_parser::measure_literals(*rv);
+    return rv;
 }
 
 } // detail
@@ -36,12 +36,8 @@ pct_vmeasure(
             ++it1;
         }
 
-        // output literal prefix
-        if( it0 != it1 )
-        {
-            for (char const* i = it0; i != it1; ++i)
-                mctx.advance_to( mctx.out() + measure_one(*i, cs));
-        }
+        // the literal prefix was measured
+        // by parse_pattern
 
         // over
         if( it1 == end )
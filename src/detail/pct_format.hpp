@@ -19,7 +19,9 @@ namespace boost {
 namespace urls {
 namespace detail {
 
-// measure a single string
+// measure the replacement fields of a
+// single string, the literal text is
+// measured when the pattern is parsed
 BOOST_URL_DECL
 std::size_t
 pct_vmeasure(
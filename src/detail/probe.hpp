@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_DETAIL_PROBE_HPP
+#define BOOST_URL_DETAIL_PROBE_HPP
+
+#include <boost/url/detail/config.hpp>
+
+/*  Static tracepoints
+
+    When the library is built with
+    BOOST_URL_ENABLE_PROBES defined, each
+    probe is a USDT probe of the provider
+    `boost_url`, which tools like bpftrace
+    and perf can attach to without
+    recompiling:
+
+    @code
+    bpftrace -e 'usdt:./app:boost_url:parse_uri_return { @[arg1] = count(); }'
+    @endcode
+
+    A disabled USDT probe is a single nop.
+    Otherwise, probes expand to nothing and
+    their arguments are not evaluated.
+
+    Each function has an `*_entry` probe
+    with the size of its inputs, and a
+    `*_return` probe with the size of its
+    output and, when it can fail, the value
+    of the error code or zero.
+*/
+#ifdef BOOST_URL_ENABLE_PROBES
+# if defined(__has_include)
+#  if __has_include(<sys/sdt.h>)
+#   include <sys/sdt.h>
+#   define BOOST_URL_HAS_PROBES 1
+#  endif
+# endif
+# ifndef BOOST_URL_HAS_PROBES
+#  error BOOST_URL_ENABLE_PROBES requires <sys/sdt.h>
+# endif
+#else
+# define BOOST_URL_HAS_PROBES 0
+#endif
+
+#if BOOST_URL_HAS_PROBES
+# define BOOST_URL_PROBE1(name, a) \
+    DTRACE_PROBE1(boost_url, name, a)
+# define BOOST_URL_PROBE2(name, a, b) \
+    DTRACE_PROBE2(boost_url, name, a, b)
+#else
+# define BOOST_URL_PROBE1(name, a) \
+    static_cast<void>(0)
+# define BOOST_URL_PROBE2(name, a, b) \
+    static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_DETAIL_STATS_HPP
+#define BOOST_URL_DETAIL_STATS_HPP
+
+#include <boost/url/stats.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <atomic>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  The counters behind get_url_stats.
+
+    Every hook compiles to nothing unless
+    BOOST_URL_ENABLE_STATS is defined when
+    building the library. Counters are
+    incremented with relaxed ordering: they
+    are independent, and readers only need
+    each value to be read atomically.
+*/
+#ifdef BOOST_URL_ENABLE_STATS
+struct stats_counters
+{
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> reallocations{0};
+    std::atomic<std::size_t> bytes_allocated{0};
+    std::atomic<std::size_t> bytes_unused{0};
+    std::atomic<std::size_t> bytes_moved{0};
+    std::atomic<std::size_t> normalizations{0};
+    std::atomic<std::size_t> parse_failures{0};
+    std::atomic<std::size_t> grammar_errors[
+        sizeof(url_stats::grammar_errors) /
+        sizeof(std::size_t)];
+    std::atomic<std::size_t> url_errors[
+        sizeof(url_stats::url_errors) /
+        sizeof(std::size_t)];
+};
+
+extern stats_counters stats;
+
+inline
+void
+stats_add(
+    std::atomic<std::size_t>& c,
+    std::size_t n = 1) noexcept
+{
+    c.fetch_add(n,
+        std::memory_order_relaxed);
+}
+#endif
+
+// a buffer of cap chars was allocated
+// to hold at least n chars
+inline
+void
+stats_allocate(
+    std::size_t n,
+    std::size_t cap,
+    bool realloc) noexcept
+{
+#ifdef BOOST_URL_ENABLE_STATS
+    stats_add(stats.allocations);
+    if(realloc)
+        stats_add(stats.reallocations);
+    stats_add(stats.bytes_allocated, cap);
+    stats_add(stats.bytes_unused, cap - n);
+#else
+    ignore_unused(n, cap, realloc);
+#endif
+}
+
+// n chars were moved inside a buffer
+inline
+void
+stats_move(
+    std::size_t n) noexcept
+{
+#ifdef BOOST_URL_ENABLE_STATS
+    stats_add(stats.bytes_moved, n);
+#else
+    ignore_unused(n);
+#endif
+}
+
+inline
+void
+stats_normalize() noexcept
+{
+#ifdef BOOST_URL_ENABLE_STATS
+    stats_add(stats.normalizations);
+#endif
+}
+
+void
+stats_parse_failure_impl(
+    system::error_code const& ec) noexcept;
+
+// return the result, counting
+// the error if there is one
+template<class T>
+system::result<T>
+stats_parse(
+    system::result<T>&& rv) noexcept
+{
+#ifdef BOOST_URL_ENABLE_STATS
+    if(rv.has_error())
+        stats_parse_failure_impl(rv.error());
+#endif
+    return std::move(rv);
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
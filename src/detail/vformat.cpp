@@ -10,7 +10,9 @@
 
 #include <boost/url/detail/config.hpp>
 #include <boost/url/detail/vformat.hpp>
-#include "pattern.hpp"
+#include <boost/url/detail/pattern.hpp>
+#include "probe.hpp"
+#include <boost/core/ignore_unused.hpp>
 
 namespace boost {
 namespace urls {
@@ -22,8 +24,33 @@ vformat_to(
     core::string_view fmt,
     detail::format_args args)
 {
-    parse_pattern(fmt)
-        .value().apply(u, args);
+    BOOST_URL_PROBE1(format_entry, fmt.size());
+    auto rv = parse_pattern(fmt);
+    if(! rv)
+    {
+        BOOST_URL_PROBE2(format_return,
+            u.size(), rv.error().value());
+        // throws
+        rv.value();
+    }
+    rv->apply(u, args);
+    BOOST_URL_PROBE2(format_return,
+        u.size(), 0);
+}
+
+void
+vformat_to(
+    url_base& u,
+    core::string_view fmt,
+    pattern const& p,
+    detail::format_args args)
+{
+    // only used by the probes
+    boost::ignore_unused(fmt);
+    BOOST_URL_PROBE1(format_entry, fmt.size());
+    p.apply(u, args);
+    BOOST_URL_PROBE2(format_return,
+        u.size(), 0);
 }
 
 
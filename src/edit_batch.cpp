@@ -0,0 +1,514 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/edit_batch.hpp>
+#include <boost/url/decode_view.hpp>
+#include <boost/url/encode.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include "detail/decode.hpp"
+#include "detail/path.hpp"
+#include "rfc/detail/charsets.hpp"
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+// append the encoded string
+// and return its offset
+template<class CharSet>
+std::size_t
+append_encoded(
+    std::string& buf,
+    core::string_view s,
+    CharSet const& cs)
+{
+    encoding_opts opt;
+    opt.space_as_plus = false;
+    auto const pos = buf.size();
+    auto const n =
+        encoded_size(s, cs, opt);
+    buf.resize(pos + n);
+    encode(&buf[pos], n, s, cs, opt);
+    return pos;
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+void
+edit_batch::
+load_params()
+{
+    if(has_params_)
+        return;
+    params_.clear();
+    params_.reserve(
+        u_->encoded_params().size() + 1);
+
+    // the recorded params reference
+    // a copy of the query, which is
+    // never aliased by the url
+    auto const q = u_->encoded_query();
+    auto const base = buf_.size();
+    buf_.append(q.data(), q.size());
+    if(u_->has_query())
+    {
+        auto const end = base + q.size();
+        auto pos = base;
+        for(;;)
+        {
+            auto it = pos;
+            while( it != end &&
+                buf_[it] != '&')
+                ++it;
+            param p;
+            p.key = pos;
+            p.nk = it - pos;
+            p.has_value = false;
+            p.value = it;
+            p.nv = 0;
+            auto const eq = core::string_view(
+                buf_.data() + pos, it - pos
+                    ).find('=');
+            if(eq != core::string_view::npos)
+            {
+                p.nk = eq;
+                p.has_value = true;
+                p.value = pos + eq + 1;
+                p.nv = it - p.value;
+            }
+            params_.push_back(p);
+            if(it == end)
+                break;
+            pos = it + 1;
+        }
+    }
+    BOOST_ASSERT(params_.size() ==
+        u_->encoded_params().size());
+    has_params_ = true;
+}
+
+void
+edit_batch::
+load_segments()
+{
+    if(has_segs_)
+        return;
+    auto const ps = u_->encoded_segments();
+    segs_.clear();
+    segs_.reserve(ps.size() + 1);
+
+    // the recorded segments reference
+    // a copy of the path, which is
+    // never aliased by the url
+    auto const s = u_->encoded_path();
+    auto const base = buf_.size();
+    buf_.append(s.data(), s.size());
+    prefix_ = detail::path_prefix(s);
+    for(auto seg : ps)
+    {
+        segment v;
+        v.pos = base + (seg.data() - s.data());
+        v.n = seg.size();
+        segs_.push_back(v);
+    }
+    has_segs_ = true;
+}
+
+bool
+edit_batch::
+match(
+    param const& p,
+    core::string_view key,
+    ignore_case_param ic) const noexcept
+{
+    core::string_view const k(
+        buf_.data() + p.key, p.nk);
+    auto const s = make_pct_string_view_unsafe(
+        k.data(), k.size(),
+        detail::decode_bytes_unsafe(k));
+    if(! ic)
+        return *s == key;
+    return grammar::ci_is_equal(*s, key);
+}
+
+// Record the replacement of the segments
+// [i0, i1) with the segment s, if any, as
+// url_base::edit_segments would apply it
+// to the url, including the changes to
+// the path prefix.
+void
+edit_batch::
+edit_segments(
+    std::size_t i0,
+    std::size_t i1,
+    core::string_view const* s)
+{
+    BOOST_ASSERT(i0 <= i1);
+    BOOST_ASSERT(i1 <= segs_.size());
+    auto const nseg = segs_.size();
+    bool const is_abs =
+        prefix_ == 1 || prefix_ == 3;
+    bool absolute;
+    if(u_->has_authority())
+        absolute = s ||
+            i0 != 0 || i1 != nseg;
+    else
+        absolute = is_abs;
+
+    std::size_t prefix = prefix_;
+    bool encode_colons = false;
+    if(i0 > 0)
+    {
+        // prefix unchanged
+    }
+    else if(s)
+    {
+        // first segment from s
+        if(s->empty())
+            prefix = 2 + absolute;
+        else if(absolute)
+            prefix = 1;
+        else
+        {
+            prefix = 0;
+            encode_colons =
+                ! u_->has_scheme() &&
+                s->contains(':');
+        }
+    }
+    else if(i1 == nseg)
+    {
+        prefix = absolute;
+    }
+    else
+    {
+        // first segment from i1
+        core::string_view const v(
+            buf_.data() + segs_[i1].pos,
+            segs_[i1].n);
+        if(v.empty())
+            prefix = 2 + absolute;
+        else if(absolute)
+            prefix = 1;
+        else if(u_->has_scheme() ||
+                ! v.contains(':'))
+            prefix = 0;
+        else
+            prefix = 2;
+    }
+
+    if(s)
+    {
+        segment v;
+        v.pos = encode_colons ?
+            append_encoded(buf_, *s,
+                detail::nocolon_pchars) :
+            append_encoded(buf_, *s,
+                pchars);
+        v.n = buf_.size() - v.pos;
+        if(i0 == i1)
+        {
+            segs_.insert(
+                segs_.begin() + i0, v);
+        }
+        else
+        {
+            segs_[i0] = v;
+            segs_.erase(
+                segs_.begin() + i0 + 1,
+                segs_.begin() + i1);
+        }
+    }
+    else
+    {
+        segs_.erase(
+            segs_.begin() + i0,
+            segs_.begin() + i1);
+    }
+    prefix_ = prefix;
+}
+
+//------------------------------------------------
+//
+// Params
+//
+//------------------------------------------------
+
+void
+edit_batch::
+append_param(
+    param_view const& p)
+{
+    load_params();
+    params_.reserve(params_.size() + 1);
+    param v;
+    v.key = append_encoded(
+        buf_, p.key,
+            detail::param_key_chars);
+    v.nk = buf_.size() - v.key;
+    v.has_value = p.has_value;
+    v.value = buf_.size();
+    v.nv = 0;
+    if(p.has_value)
+    {
+        append_encoded(
+            buf_, p.value,
+                detail::param_value_chars);
+        v.nv = buf_.size() - v.value;
+    }
+    params_.push_back(v);
+}
+
+void
+edit_batch::
+set_param(
+    core::string_view key,
+    core::string_view value,
+    ignore_case_param ic)
+{
+    load_params();
+    auto const end = params_.end();
+    auto it = params_.begin();
+    while( it != end &&
+        ! match(*it, key, ic))
+        ++it;
+    if(it == end)
+        return append_param({ key, value });
+    auto const pos = append_encoded(
+        buf_, value,
+            detail::param_value_chars);
+    it->value = pos;
+    it->nv = buf_.size() - pos;
+    it->has_value = true;
+    params_.erase(std::remove_if(
+        it + 1, params_.end(),
+        [&](param const& p)
+        {
+            return match(p, key, ic);
+        }), params_.end());
+}
+
+std::size_t
+edit_batch::
+erase_param(
+    core::string_view key,
+    ignore_case_param ic)
+{
+    load_params();
+    auto const n = params_.size();
+    params_.erase(std::remove_if(
+        params_.begin(), params_.end(),
+        [&](param const& p)
+        {
+            return match(p, key, ic);
+        }), params_.end());
+    return n - params_.size();
+}
+
+//------------------------------------------------
+//
+// Segments
+//
+//------------------------------------------------
+
+void
+edit_batch::
+insert_segment(
+    std::size_t pos,
+    core::string_view s)
+{
+    load_segments();
+    BOOST_ASSERT(pos <= segs_.size());
+    edit_segments(pos, pos, &s);
+}
+
+void
+edit_batch::
+erase_segment(
+    std::size_t pos)
+{
+    load_segments();
+    BOOST_ASSERT(pos < segs_.size());
+    edit_segments(pos, pos + 1, nullptr);
+}
+
+void
+edit_batch::
+push_back_segment(
+    core::string_view s)
+{
+    load_segments();
+    edit_segments(
+        segs_.size(), segs_.size(), &s);
+}
+
+void
+edit_batch::
+pop_back_segment()
+{
+    load_segments();
+    BOOST_ASSERT(! segs_.empty());
+    edit_segments(
+        segs_.size() - 1,
+        segs_.size(), nullptr);
+}
+
+//------------------------------------------------
+
+void
+edit_batch::
+commit()
+{
+    if(empty())
+        return;
+
+//------------------------------------------------
+//
+//  Measure the new path and query
+//
+    std::size_t np = 0;
+    if(has_segs_)
+    {
+        np = prefix_;
+        if(! segs_.empty())
+            np += segs_.size() - 1;
+        for(auto const& v : segs_)
+            np += v.n;
+    }
+    std::size_t nq = 0;
+    if(has_params_ &&
+        ! params_.empty())
+    {
+        nq = params_.size();
+        for(auto const& p : params_)
+        {
+            nq += p.nk;
+            if(p.has_value)
+                nq += p.nv + 1;
+        }
+    }
+
+//------------------------------------------------
+//
+//  Resize [first, last) once; the fragment is
+//  the only part which moves.
+//
+    using parts = detail::parts_base;
+    auto& u = *u_;
+    int const first = has_segs_ ?
+        parts::id_path : parts::id_query;
+    int const last = has_params_ ?
+        parts::id_frag : parts::id_query;
+    auto const n = np + nq;
+    auto const n0 =
+        u.impl_.len(first, last);
+    if( n > n0 &&
+        n - n0 > u.max_size() - u.size())
+    {
+        // too large
+        detail::throw_length_error();
+    }
+    url_base::op_t op(u);
+    char* dest = u.resize_impl(
+        first, last, n, op);
+
+//------------------------------------------------
+//
+//  Output the path and query
+//
+    if(has_segs_)
+    {
+        auto const dest0 = dest;
+        switch(prefix_)
+        {
+        case 3:
+            *dest++ = '/';
+            *dest++ = '.';
+            *dest++ = '/';
+            break;
+        case 2:
+            *dest++ = '.';
+            BOOST_FALLTHROUGH;
+        case 1:
+            *dest++ = '/';
+            break;
+        default:
+            break;
+        }
+        for(std::size_t i = 0;
+            i < segs_.size(); ++i)
+        {
+            if(i != 0)
+                *dest++ = '/';
+            std::memcpy(dest,
+                buf_.data() + segs_[i].pos,
+                segs_[i].n);
+            dest += segs_[i].n;
+        }
+        BOOST_ASSERT(dest == dest0 + np);
+        if(has_params_)
+            u.impl_.split(parts::id_path, np);
+        u.impl_.nseg_ = segs_.size();
+        u.impl_.decoded_[parts::id_path] =
+            detail::decode_bytes_unsafe(
+                core::string_view(dest0, np));
+    }
+    if(has_params_)
+    {
+        auto const dest0 = dest;
+        char c = '?';
+        for(auto const& p : params_)
+        {
+            *dest++ = c;
+            c = '&';
+            std::memcpy(dest,
+                buf_.data() + p.key, p.nk);
+            dest += p.nk;
+            if(! p.has_value)
+                continue;
+            *dest++ = '=';
+            std::memcpy(dest,
+                buf_.data() + p.value, p.nv);
+            dest += p.nv;
+        }
+        BOOST_ASSERT(dest == dest0 + nq);
+        u.impl_.nparam_ = params_.size();
+        u.impl_.decoded_[parts::id_query] = nq == 0 ? 0 :
+            detail::decode_bytes_unsafe(
+                core::string_view(
+                    dest0 + 1, nq - 1));
+    }
+    clear();
+}
+
+void
+edit_batch::
+clear() noexcept
+{
+    buf_.clear();
+    params_.clear();
+    segs_.clear();
+    prefix_ = 0;
+    has_params_ = false;
+    has_segs_ = false;
+}
+
+} // urls
+} // boost
+
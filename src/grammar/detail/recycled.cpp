@@ -85,6 +85,25 @@ recycled_add_impl(
     {}
 }
 
+std::size_t
+recycled_thread_index() noexcept
+{
+#if !defined(BOOST_URL_DISABLE_THREADS)
+    // constant initialized, so there is
+    // no guard on each call
+    static std::atomic<std::size_t> next{0};
+    static thread_local std::size_t i =
+        std::size_t(-1);
+    if(i == std::size_t(-1))
+        i = next.fetch_add(1,
+            std::memory_order_relaxed) %
+                recycled_caches;
+    return i;
+#else
+    return 0;
+#endif
+}
+
 void
 recycled_remove_impl(
     std::size_t n) noexcept
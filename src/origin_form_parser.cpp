@@ -0,0 +1,268 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/origin_form_parser.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/pct_string_view.hpp>
+#include <boost/url/rfc/pchars.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/assert.hpp>
+#include "rfc/detail/charsets.hpp"
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+origin_form_parser::
+origin_form_parser(
+    char* buf,
+    std::size_t size) noexcept
+    : buf_(buf)
+    , cap_(size < url_view::max_size() ?
+        size : url_view::max_size())
+{
+}
+
+/*  The states mirror origin_form_rule,
+    with the percent-escapes split so a
+    chunk may end anywhere. The path and
+    query are measured while they are
+    validated, so finish() does not need
+    to scan the buffer again.
+*/
+system::result<std::size_t>
+origin_form_parser::
+put(core::string_view s) noexcept
+{
+    if(st_ == state::failed)
+        return ec_;
+    if(st_ == state::done)
+        return 0;
+
+    // at most one character past the
+    // end of the buffer is examined
+    char const* const first = s.data();
+    std::size_t const avail = cap_ - size_;
+    char const* const end = first + (
+        s.size() <= avail ? s.size() : avail + 1);
+    char const* it = first;
+    while(it != end)
+    {
+        char const c = *it;
+        switch(st_)
+        {
+        case state::start:
+            if(c != '/')
+            {
+                ec_ = BOOST_URL_ERR(
+                    grammar::error::mismatch);
+                goto fail;
+            }
+            ++nseg_;
+            st_ = state::path;
+            ++it;
+            break;
+
+        case state::path:
+            if(pchars(c))
+            {
+                ++it;
+                break;
+            }
+            if(c == '/')
+            {
+                ++nseg_;
+                ++it;
+                break;
+            }
+            if(c == '%')
+            {
+                st_ = state::path_pct1;
+                ++it;
+                break;
+            }
+            path_size_ = size_ + (it - first);
+            if(c == '?')
+            {
+                has_query_ = true;
+                nparam_ = 1;
+                st_ = state::query;
+                ++it;
+                break;
+            }
+            st_ = state::done;
+            goto finish;
+
+        case state::path_pct1:
+        case state::path_pct2:
+            if(! grammar::hexdig_chars(c))
+            {
+                // expected HEXDIG
+                ec_ = BOOST_URL_ERR(
+                    grammar::error::invalid);
+                goto fail;
+            }
+            if(st_ == state::path_pct1)
+            {
+                st_ = state::path_pct2;
+            }
+            else
+            {
+                path_dn_ += 2;
+                st_ = state::path;
+            }
+            ++it;
+            break;
+
+        case state::query:
+            if(c == '&')
+            {
+                ++nparam_;
+                ++it;
+                break;
+            }
+            if(detail::query_chars(c))
+            {
+                ++it;
+                break;
+            }
+            if(c == '%')
+            {
+                st_ = state::query_pct1;
+                ++it;
+                break;
+            }
+            st_ = state::done;
+            goto finish;
+
+        case state::query_pct1:
+        case state::query_pct2:
+            if(! grammar::hexdig_chars(c))
+            {
+                // expected HEXDIG
+                ec_ = BOOST_URL_ERR(
+                    error::bad_pct_hexdig);
+                goto fail;
+            }
+            if(st_ == state::query_pct1)
+            {
+                st_ = state::query_pct2;
+            }
+            else
+            {
+                query_dn_ += 2;
+                st_ = state::query;
+            }
+            ++it;
+            break;
+
+        default:
+            BOOST_ASSERT(false);
+            break;
+        }
+    }
+
+finish:
+    {
+        std::size_t const n = it - first;
+        if(n > avail)
+        {
+            ec_ = BOOST_URL_ERR(
+                error::no_space);
+            goto fail;
+        }
+        std::memcpy(buf_ + size_, first, n);
+        size_ += n;
+        return n;
+    }
+
+fail:
+    st_ = state::failed;
+    return ec_;
+}
+
+system::result<url_view>
+origin_form_parser::
+finish() noexcept
+{
+    switch(st_)
+    {
+    case state::failed:
+        return ec_;
+
+    case state::start:
+        BOOST_URL_RETURN_EC(
+            grammar::error::mismatch);
+
+    case state::path_pct1:
+    case state::path_pct2:
+        // expected HEXDIG
+        BOOST_URL_RETURN_EC(
+            grammar::error::invalid);
+
+    case state::query_pct1:
+    case state::query_pct2:
+        // missing HEXDIG
+        BOOST_URL_RETURN_EC(
+            error::missing_pct_hexdig);
+
+    case state::path:
+        path_size_ = size_;
+        st_ = state::done;
+        break;
+
+    case state::query:
+        st_ = state::done;
+        break;
+
+    default:
+        break;
+    }
+
+    detail::url_impl u(
+        detail::url_impl::from::string);
+    u.cs_ = buf_;
+    u.apply_path(
+        make_pct_string_view_unsafe(
+            buf_, path_size_,
+            path_size_ - path_dn_),
+        nseg_);
+    if(has_query_)
+    {
+        std::size_t const n =
+            size_ - path_size_ - 1;
+        u.apply_query(
+            make_pct_string_view_unsafe(
+                buf_ + path_size_ + 1,
+                n, n - query_dn_),
+            nparam_);
+    }
+    return u.construct();
+}
+
+void
+origin_form_parser::
+reset() noexcept
+{
+    size_ = 0;
+    path_size_ = 0;
+    path_dn_ = 0;
+    query_dn_ = 0;
+    nseg_ = 0;
+    nparam_ = 0;
+    ec_ = {};
+    st_ = state::start;
+    has_query_ = false;
+}
+
+} // urls
+} // boost
@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/params_parser.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include "detail/decode.hpp"
+#include "rfc/detail/charsets.hpp"
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+params_parser::
+params_parser(
+    char* buf,
+    std::size_t size,
+    encoding_opts opt) noexcept
+    : buf_(buf)
+    , cap_(size)
+    , opt_(opt)
+{
+}
+
+void
+params_parser::
+reset() noexcept
+{
+    clear_param();
+    ec_ = {};
+    pct_ = 0;
+    any_ = false;
+    failed_ = false;
+}
+
+void
+params_parser::
+clear_param() noexcept
+{
+    size_ = 0;
+    key_size_ = 0;
+    key_dn_ = 0;
+    value_dn_ = 0;
+    has_value_ = false;
+    emitted_ = false;
+}
+
+system::result<std::size_t>
+params_parser::
+decode(
+    pct_string_view s,
+    char* dest,
+    std::size_t size) const noexcept
+{
+    std::size_t const n =
+        s.decoded_size();
+    if(n > size)
+    {
+        BOOST_URL_RETURN_EC(
+            error::no_space);
+    }
+    return detail::decode_unsafe(
+        dest, dest + n, s, opt_);
+}
+
+param_pct_view
+params_parser::
+make_param(
+    char const* data,
+    std::size_t size) const noexcept
+{
+    param_pct_view p;
+    if(! has_value_)
+    {
+        p.key = make_pct_string_view_unsafe(
+            data, size, size - key_dn_);
+        return p;
+    }
+    std::size_t const vn =
+        size - key_size_ - 1;
+    p.key = make_pct_string_view_unsafe(
+        data, key_size_, key_size_ - key_dn_);
+    p.value = make_pct_string_view_unsafe(
+        data + key_size_ + 1, vn, vn - value_dn_);
+    p.has_value = true;
+    return p;
+}
+
+/*  The grammar is the same as query_rule,
+    with the state of a percent-escape and
+    the sizes of the current param kept
+    between chunks. A param is only copied
+    when the chunk ends before it does.
+*/
+system::result<bool>
+params_parser::
+parse(
+    char const*& it,
+    char const* end,
+    param_pct_view& p) noexcept
+{
+    if(failed_)
+        return ec_;
+    if(emitted_)
+        clear_param();
+
+    char const* const first = it;
+    while(it != end)
+    {
+        char const c = *it;
+        if(pct_ != 0)
+        {
+            if(! grammar::hexdig_chars(c))
+            {
+                // expected HEXDIG
+                ec_ = BOOST_URL_ERR(
+                    error::bad_pct_hexdig);
+                goto fail;
+            }
+            --pct_;
+            ++it;
+            continue;
+        }
+        if(c == '&')
+        {
+            std::size_t const n = it - first;
+            ++it;
+            any_ = true;
+            emitted_ = true;
+            if(size_ == 0)
+            {
+                p = make_param(first, n);
+                return true;
+            }
+            if(n > cap_ - size_)
+            {
+                ec_ = BOOST_URL_ERR(
+                    error::no_space);
+                goto fail;
+            }
+            std::memcpy(buf_ + size_, first, n);
+            size_ += n;
+            p = make_param(buf_, size_);
+            return true;
+        }
+        if(c == '%')
+        {
+            pct_ = 2;
+            if(has_value_)
+                value_dn_ += 2;
+            else
+                key_dn_ += 2;
+        }
+        else if(c == '=')
+        {
+            if(! has_value_)
+            {
+                has_value_ = true;
+                key_size_ = size_ + (it - first);
+            }
+        }
+        else if(! detail::query_chars(c))
+        {
+            // got reserved character
+            ec_ = BOOST_URL_ERR(
+                grammar::error::invalid);
+            goto fail;
+        }
+        ++it;
+    }
+
+    // the chunk ends within the param
+    if(it != first)
+    {
+        std::size_t const n = it - first;
+        any_ = true;
+        if(n > cap_ - size_)
+        {
+            ec_ = BOOST_URL_ERR(
+                error::no_space);
+            goto fail;
+        }
+        std::memcpy(buf_ + size_, first, n);
+        size_ += n;
+    }
+    return false;
+
+fail:
+    failed_ = true;
+    return ec_;
+}
+
+system::result<bool>
+params_parser::
+parse_last(
+    param_pct_view& p) noexcept
+{
+    if(failed_)
+        return ec_;
+    if(pct_ != 0)
+    {
+        // missing HEXDIG
+        ec_ = BOOST_URL_ERR(
+            error::missing_pct_hexdig);
+        failed_ = true;
+        return ec_;
+    }
+    if(! any_)
+    {
+        reset();
+        return false;
+    }
+    // the input may end with "&"
+    if(emitted_)
+        clear_param();
+    p = make_param(buf_, size_);
+    return true;
+}
+
+} // urls
+} // boost
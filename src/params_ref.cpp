@@ -209,6 +209,13 @@ set(
     }
 }
 
+void
+params_ref::
+sort()
+{
+    u_->sort_params_impl();
+}
+
 auto
 params_ref::
 erase(
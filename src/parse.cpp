@@ -17,6 +17,8 @@
 #include <boost/url/rfc/uri_reference_rule.hpp>
 #include <boost/url/rfc/origin_form_rule.hpp>
 #include <boost/url/grammar/parse.hpp>
+#include "detail/probe.hpp"
+#include "detail/stats.hpp"
 
 namespace boost {
 namespace urls {
@@ -25,39 +27,47 @@ system::result<url_view>
 parse_absolute_uri(
     core::string_view s)
 {
-    return grammar::parse(
-        s, absolute_uri_rule);
+    return detail::stats_parse(
+        grammar::parse(s, absolute_uri_rule));
 }
 
 system::result<url_view>
 parse_origin_form(
     core::string_view s)
 {
-    return grammar::parse(
-        s, origin_form_rule);
+    BOOST_URL_PROBE1(parse_origin_form_entry, s.size());
+    auto rv = detail::stats_parse(
+        grammar::parse(s, origin_form_rule));
+    BOOST_URL_PROBE2(parse_origin_form_return,
+        s.size(), rv.error().value());
+    return rv;
 }
 
 system::result<url_view>
 parse_relative_ref(
     core::string_view s)
 {
-    return grammar::parse(
-        s, relative_ref_rule);
+    return detail::stats_parse(
+        grammar::parse(s, relative_ref_rule));
 }
 system::result<url_view>
 parse_uri(
     core::string_view s)
 {
-    return grammar::parse(
-        s, uri_rule);
+    BOOST_URL_PROBE1(parse_uri_entry, s.size());
+    auto rv = detail::stats_parse(
+        grammar::parse(s, uri_rule));
+    BOOST_URL_PROBE2(parse_uri_return,
+        s.size(), rv.error().value());
+    return rv;
 }
 
 system::result<url_view>
 parse_uri_reference(
     core::string_view s)
 {
-    return grammar::parse(
-        s, uri_reference_rule);
+    return detail::stats_parse(
+        grammar::parse(s, uri_reference_rule));
 }
 
 } // urls
@@ -0,0 +1,36 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/sink.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+std::size_t
+buffer_sink::
+write(
+    char const* data,
+    std::size_t n) noexcept
+{
+    if(n > n_)
+        n = n_;
+    if(n == 0)
+        return 0;
+    std::memcpy(p_, data, n);
+    p_ += n;
+    n_ -= n;
+    size_ += n;
+    return n;
+}
+
+} // urls
+} // boost
@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/small_url.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+small_url_base::
+~small_url_base()
+{
+    if(! is_inline())
+        delete[] s_;
+}
+
+small_url_base::
+small_url_base(
+    char* buf,
+    std::size_t cap) noexcept
+    : buf_(buf)
+    , inline_cap_(cap)
+{
+    s_ = buf;
+    cap_ = cap;
+    s_[0] = '\0';
+    impl_.cs_ = s_;
+}
+
+small_url_base::
+small_url_base(
+    char* buf,
+    std::size_t cap,
+    core::string_view s)
+    : small_url_base(buf, cap)
+{
+    copy(parse_uri_reference(s
+        ).value(BOOST_URL_POS));
+}
+
+void
+small_url_base::
+move_from(small_url_base& u) noexcept
+{
+    BOOST_ASSERT(inline_cap_ == u.inline_cap_);
+    if(u.is_inline())
+    {
+        // the characters fit in our
+        // storage, inline or not
+        BOOST_ASSERT(u.size() <= cap_);
+        impl_ = u.impl_;
+        std::memcpy(s_, u.s_, u.size() + 1);
+        impl_.cs_ = s_;
+    }
+    else
+    {
+        if(! is_inline())
+            delete[] s_;
+        impl_ = u.impl_;
+        s_ = u.s_;
+        cap_ = u.cap_;
+        impl_.cs_ = s_;
+        u.s_ = u.buf_;
+        u.cap_ = u.inline_cap_;
+    }
+    u.impl_ = {from::url};
+    u.s_[0] = '\0';
+    u.impl_.cs_ = u.s_;
+}
+
+void
+small_url_base::
+shrink_to_fit_impl()
+{
+    if(is_inline())
+        return;
+    std::size_t const n = size();
+    char* s;
+    std::size_t cap;
+    if(n <= inline_cap_)
+    {
+        s = buf_;
+        cap = inline_cap_;
+    }
+    else if(n < cap_)
+    {
+        s = new char[n + 1];
+        cap = n;
+    }
+    else
+    {
+        return;
+    }
+    std::memcpy(s, s_, n + 1);
+    delete[] s_;
+    s_ = s;
+    cap_ = cap;
+    impl_.cs_ = s_;
+}
+
+void
+small_url_base::
+clear_impl() noexcept
+{
+    if(! is_inline())
+    {
+        // move back inline
+        delete[] s_;
+        s_ = buf_;
+        cap_ = inline_cap_;
+    }
+    impl_ = {from::url};
+    s_[0] = '\0';
+    impl_.cs_ = s_;
+}
+
+void
+small_url_base::
+reserve_impl(
+    std::size_t n,
+    op_t& op)
+{
+    if(n > max_size())
+        detail::throw_length_error();
+    if(n <= cap_)
+        return;
+
+    // 50% growth policy, starting
+    // from the inline capacity
+    auto const h = cap_ / 2;
+    std::size_t new_cap;
+    if(cap_ <= max_size() - h)
+        new_cap = cap_ + h;
+    else
+        new_cap = max_size();
+    if( new_cap < n)
+        new_cap = n;
+    char* s = new char[new_cap + 1];
+    std::memcpy(s, s_, size() + 1);
+    BOOST_ASSERT(! op.old);
+    op.old = s_;
+    s_ = s;
+    cap_ = new_cap;
+    impl_.cs_ = s_;
+}
+
+void
+small_url_base::
+cleanup(op_t& op)
+{
+    // the inline storage is not released
+    if(op.old != buf_)
+        delete[] op.old;
+}
+
+} // urls
+} // boost
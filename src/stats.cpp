@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/stats.hpp>
+#include "detail/stats.hpp"
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+// return the index of the counter
+// of ec in n counters for category
+// of E, or n
+template<class E>
+std::size_t
+error_index(
+    system::error_code const& ec,
+    E e,
+    std::size_t n) noexcept
+{
+    if(ec.category() !=
+        system::error_code(e).category())
+        return n;
+    auto const v = ec.value();
+    if( v < 0 ||
+        static_cast<std::size_t>(v) >= n)
+        return n;
+    return static_cast<std::size_t>(v);
+}
+
+constexpr
+std::size_t
+ngrammar = sizeof(url_stats::grammar_errors) /
+    sizeof(std::size_t);
+
+constexpr
+std::size_t
+nurl = sizeof(url_stats::url_errors) /
+    sizeof(std::size_t);
+
+} // (anon)
+
+namespace detail {
+
+#ifdef BOOST_URL_ENABLE_STATS
+stats_counters stats;
+#endif
+
+void
+stats_parse_failure_impl(
+    system::error_code const& ec) noexcept
+{
+#ifdef BOOST_URL_ENABLE_STATS
+    stats_add(stats.parse_failures);
+    auto i = error_index(ec,
+        grammar::error::mismatch, ngrammar);
+    if(i != ngrammar)
+        stats_add(stats.grammar_errors[i]);
+    i = error_index(ec,
+        error::success, nurl);
+    if(i != nurl)
+        stats_add(stats.url_errors[i]);
+#else
+    ignore_unused(ec);
+#endif
+}
+
+} // detail
+
+std::size_t
+url_stats::
+failures(
+    system::error_code const& ec) const noexcept
+{
+    auto i = error_index(ec,
+        grammar::error::mismatch, ngrammar);
+    if(i != ngrammar)
+        return grammar_errors[i];
+    i = error_index(ec,
+        error::success, nurl);
+    if(i != nurl)
+        return url_errors[i];
+    return 0;
+}
+
+url_stats
+get_url_stats() noexcept
+{
+    url_stats st;
+#ifdef BOOST_URL_ENABLE_STATS
+    auto const& c = detail::stats;
+    auto const load = [](
+        std::atomic<std::size_t> const& n)
+    {
+        return n.load(
+            std::memory_order_relaxed);
+    };
+    st.enabled = true;
+    st.allocations = load(c.allocations);
+    st.reallocations = load(c.reallocations);
+    st.bytes_allocated = load(c.bytes_allocated);
+    st.bytes_unused = load(c.bytes_unused);
+    st.bytes_moved = load(c.bytes_moved);
+    st.normalizations = load(c.normalizations);
+    st.parse_failures = load(c.parse_failures);
+    for(std::size_t i = 0; i < ngrammar; ++i)
+        st.grammar_errors[i] =
+            load(c.grammar_errors[i]);
+    for(std::size_t i = 0; i < nurl; ++i)
+        st.url_errors[i] =
+            load(c.url_errors[i]);
+#endif
+    return st;
+}
+
+void
+reset_url_stats() noexcept
+{
+#ifdef BOOST_URL_ENABLE_STATS
+    auto& c = detail::stats;
+    auto const reset = [](
+        std::atomic<std::size_t>& n)
+    {
+        n.store(0,
+            std::memory_order_relaxed);
+    };
+    reset(c.allocations);
+    reset(c.reallocations);
+    reset(c.bytes_allocated);
+    reset(c.bytes_unused);
+    reset(c.bytes_moved);
+    reset(c.normalizations);
+    reset(c.parse_failures);
+    for(auto& n : c.grammar_errors)
+        reset(n);
+    for(auto& n : c.url_errors)
+        reset(n);
+#endif
+}
+
+} // urls
+} // boost
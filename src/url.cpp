@@ -12,6 +12,7 @@
 #include <boost/url/detail/config.hpp>
 #include <boost/url/url.hpp>
 #include <boost/url/parse.hpp>
+#include "detail/stats.hpp"
 #include <boost/assert.hpp>
 
 namespace boost {
@@ -125,6 +126,8 @@ reserve_impl(
         if( new_cap < n)
             new_cap = n;
         s = allocate(new_cap);
+        detail::stats_allocate(
+            n, new_cap, true);
         std::memcpy(s, s_, size() + 1);
         BOOST_ASSERT(! op.old);
         op.old = s_;
@@ -133,6 +136,8 @@ reserve_impl(
     else
     {
         s_ = allocate(n);
+        detail::stats_allocate(
+            n, n, false);
         s_[0] = '\0';
     }
     impl_.cs_ = s_;
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_arena.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+// The characters of a block
+// follow its header
+struct url_arena::block
+{
+    block* next;
+    std::size_t size;
+
+    char*
+    data() noexcept
+    {
+        return reinterpret_cast<
+            char*>(this + 1);
+    }
+};
+
+url_arena::
+url_arena(
+    std::size_t block_size) noexcept
+    : block_size_(block_size ? block_size : 1)
+{
+}
+
+url_arena::
+~url_arena()
+{
+    release();
+}
+
+url_arena::
+url_arena(url_arena&& other) noexcept
+    : head_(other.head_)
+    , pos_(other.pos_)
+    , end_(other.end_)
+    , block_size_(other.block_size_)
+    , size_(other.size_)
+    , capacity_(other.capacity_)
+    , blocks_(other.blocks_)
+{
+    other.head_ = nullptr;
+    other.pos_ = nullptr;
+    other.end_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+    other.blocks_ = 0;
+}
+
+url_arena&
+url_arena::
+operator=(url_arena&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    release();
+    head_ = other.head_;
+    pos_ = other.pos_;
+    end_ = other.end_;
+    block_size_ = other.block_size_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    blocks_ = other.blocks_;
+    other.head_ = nullptr;
+    other.pos_ = nullptr;
+    other.end_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+    other.blocks_ = 0;
+    return *this;
+}
+
+url_view
+url_arena::
+persist(url_view_base const& u)
+{
+    if(u.size() == 0)
+        return {};
+    detail::url_impl impl = *u.pi_;
+    std::size_t const n = u.size();
+    char* const p = allocate(n);
+    std::memcpy(p, impl.cs_, n);
+    impl.cs_ = p;
+    impl.from_ = detail::parts_base::from::string;
+    return url_view(impl);
+}
+
+void
+url_arena::
+reserve(std::size_t n)
+{
+    if(static_cast<std::size_t>(end_ - pos_) >= n)
+        return;
+    std::size_t const size =
+        n > block_size_ ? n : block_size_;
+    block* b = static_cast<block*>(
+        ::operator new(sizeof(block) + size));
+    b->next = head_;
+    b->size = size;
+    head_ = b;
+    pos_ = b->data();
+    end_ = pos_ + size;
+    capacity_ += size;
+    ++blocks_;
+}
+
+void
+url_arena::
+clear() noexcept
+{
+    if(! head_)
+        return;
+    block* b = head_->next;
+    while(b)
+    {
+        block* next = b->next;
+        ::operator delete(b);
+        b = next;
+    }
+    head_->next = nullptr;
+    pos_ = head_->data();
+    end_ = pos_ + head_->size;
+    size_ = 0;
+    capacity_ = head_->size;
+    blocks_ = 1;
+}
+
+void
+url_arena::
+release() noexcept
+{
+    block* b = head_;
+    while(b)
+    {
+        block* next = b->next;
+        ::operator delete(b);
+        b = next;
+    }
+    head_ = nullptr;
+}
+
+char*
+url_arena::
+allocate(std::size_t n)
+{
+    if(static_cast<std::size_t>(end_ - pos_) < n)
+    {
+        if(n > block_size_ / 2 && head_)
+        {
+            // a large url gets a block of
+            // its own, behind the current
+            // block, which stays in use
+            block* b = static_cast<block*>(
+                ::operator new(sizeof(block) + n));
+            b->size = n;
+            b->next = head_->next;
+            head_->next = b;
+            capacity_ += n;
+            ++blocks_;
+            size_ += n;
+            return b->data();
+        }
+        reserve(n);
+    }
+    char* p = pos_;
+    pos_ += n;
+    size_ += n;
+    return p;
+}
+
+} // urls
+} // boost
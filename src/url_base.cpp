@@ -21,9 +21,11 @@
 #include "detail/decode.hpp"
 #include <boost/url/detail/encode.hpp>
 #include <boost/url/detail/except.hpp>
+#include "detail/probe.hpp"
 #include "detail/normalize.hpp"
 #include "detail/path.hpp"
 #include "detail/print.hpp"
+#include "detail/stats.hpp"
 #include <boost/url/grammar/ci_string.hpp>
 #include <boost/url/rfc/authority_rule.hpp>
 #include <boost/url/rfc/query_rule.hpp>
@@ -36,8 +38,10 @@
 #include "rfc/detail/userinfo_rule.hpp"
 #include <boost/url/grammar/parse.hpp>
 #include "detail/move_chars.hpp"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 
@@ -82,6 +86,7 @@ move(
 {
     if(! n)
         return;
+    detail::stats_move(n);
     if(s0)
     {
         if(s1)
@@ -1537,6 +1542,19 @@ system::result<void>
 url_base::
 resolve(
     url_view_base const& ref)
+{
+    BOOST_URL_PROBE2(resolve_entry,
+        size(), ref.size());
+    auto rv = resolve_impl(ref);
+    BOOST_URL_PROBE2(resolve_return,
+        size(), rv.error().value());
+    return rv;
+}
+
+system::result<void>
+url_base::
+resolve_impl(
+    url_view_base const& ref)
 {
     if (this == &ref &&
         has_scheme())
@@ -1667,39 +1685,12 @@ normalize_octets_impl(
     op_t& op) noexcept
 {
     char* it = s_ + impl_.offset(id);
+    char* dest = detail::normalize_octets(
+        it, impl_.get(id), allowed);
     char* end = s_ + impl_.offset(id + 1);
-    char d = 0;
-    char* dest = it;
-    while (it < end)
-    {
-        if (*it != '%')
-        {
-            *dest = *it;
-            ++it;
-            ++dest;
-            continue;
-        }
-        BOOST_ASSERT(end - it >= 3);
-
-        // decode unreserved octets
-        d = detail::decode_one(it + 1);
-        if (allowed(d))
-        {
-            *dest = d;
-            it += 3;
-            ++dest;
-            continue;
-        }
-
-        // uppercase percent-encoding triplets
-        *dest++ = '%';
-        ++it;
-        *dest++ = grammar::to_upper(*it++);
-        *dest++ = grammar::to_upper(*it++);
-    }
-    if (it != dest)
+    if (end != dest)
     {
-        auto diff = it - dest;
+        auto diff = end - dest;
         auto n = impl_.len(id) - diff;
         shrink_impl(id, n, op);
         s_[size()] = '\0';
@@ -1710,6 +1701,7 @@ url_base&
 url_base::
 normalize_scheme()
 {
+    detail::stats_normalize();
     to_lower_impl(id_scheme);
     return *this;
 }
@@ -1718,6 +1710,7 @@ url_base&
 url_base::
 normalize_authority()
 {
+    detail::stats_normalize();
     op_t op(*this);
 
     // normalize host
@@ -1741,76 +1734,25 @@ url_base&
 url_base::
 normalize_path()
 {
+    detail::stats_normalize();
     op_t op(*this);
     normalize_octets_impl(id_path, detail::segment_chars, op);
     core::string_view p = impl_.get(id_path);
     char* p_dest = s_ + impl_.offset(id_path);
     char* p_end = s_ + impl_.offset(id_path + 1);
     auto pn = p.size();
-    auto skip_dot = 0;
-    bool encode_colons = false;
-    core::string_view first_seg;
 
 //------------------------------------------------
 //
 //  Determine unnecessary initial dot segments to skip and
 //  if we need to encode colons in the first segment
 //
-    if (
-        !has_authority() &&
-        p.starts_with("/./"))
-    {
-        // check if removing the "/./" would result in "//"
-        // ex: "/.//", "/././/", "/././/", ...
-        skip_dot = 2;
-        while (p.substr(skip_dot, 3).starts_with("/./"))
-            skip_dot += 2;
-        if (p.substr(skip_dot).starts_with("//"))
-            skip_dot = 2;
-        else
-            skip_dot = 0;
-    }
-    else if (
-        !has_scheme() &&
-        !has_authority())
-    {
-        if (p.starts_with("./"))
-        {
-            // check if removing the "./" would result in "//"
-            // ex: ".//", "././/", "././/", ...
-            skip_dot = 1;
-            while (p.substr(skip_dot, 3).starts_with("/./"))
-                skip_dot += 2;
-            if (p.substr(skip_dot).starts_with("//"))
-                skip_dot = 2;
-            else
-                skip_dot = 0;
-
-            if ( !skip_dot )
-            {
-                // check if removing "./"s would leave us
-                // a first segment with an ambiguous ":"
-                first_seg = p.substr(2);
-                while (first_seg.starts_with("./"))
-                    first_seg = first_seg.substr(2);
-                auto i = first_seg.find('/');
-                if (i != core::string_view::npos)
-                    first_seg = first_seg.substr(0, i);
-                encode_colons = first_seg.contains(':');
-            }
-        }
-        else
-        {
-            // check if normalize_octets_impl
-            // didn't already create a ":"
-            // in the first segment
-            first_seg = p;
-            auto i = first_seg.find('/');
-            if (i != core::string_view::npos)
-                first_seg = p.substr(0, i);
-            encode_colons = first_seg.contains(':');
-        }
-    }
+    bool encode_colons = false;
+    core::string_view first_seg;
+    std::size_t skip_dot =
+        detail::normalized_path_prefix(
+            p, has_scheme(), has_authority(),
+            encode_colons, first_seg);
 
 //------------------------------------------------
 //
@@ -1887,16 +1829,7 @@ normalize_path()
     {
         BOOST_ASSERT(n < pn);
         shrink_impl(id_path, n + skip_dot, op);
-        p = encoded_path();
-        if (p == "/")
-            impl_.nseg_ = 0;
-        else if (!p.empty())
-            impl_.nseg_ = std::count(
-                p.begin() + 1, p.end(), '/') + 1;
-        else
-            impl_.nseg_ = 0;
-        impl_.decoded_[id_path] =
-            detail::decode_bytes_unsafe(impl_.get(id_path));
+        update_path_counts();
     }
     return *this;
 }
@@ -1905,16 +1838,111 @@ url_base&
 url_base::
 normalize_query()
 {
+    detail::stats_normalize();
     op_t op(*this);
     normalize_octets_impl(
         id_query, detail::query_chars, op);
     return *this;
 }
 
+url_base&
+url_base::
+normalize_query(bool sort_keys)
+{
+    normalize_query();
+    if(sort_keys)
+        sort_params_impl();
+    return *this;
+}
+
+void
+url_base::
+sort_params_impl()
+{
+    if(! has_query())
+        return;
+    char* const first =
+        s_ + impl_.offset(id_query) + 1;
+    std::size_t const size =
+        impl_.len(id_query) - 1;
+    core::string_view const q(first, size);
+    std::size_t const n = 1 + static_cast<
+        std::size_t>(std::count(
+            q.begin(), q.end(), '&'));
+    if(n < 2)
+        return;
+
+    struct param
+    {
+        std::size_t pos;
+        std::size_t size;
+        std::size_t key_size;
+    };
+
+    // The params and a copy of the query
+    // share one buffer, so the sort is done
+    // on the offsets and the bytes are only
+    // copied once.
+    std::size_t const nchars =
+        (size + sizeof(param) - 1) / sizeof(param);
+    std::unique_ptr<param[]> buf(
+        new param[n + nchars]);
+    param* const p0 = buf.get();
+    char* const tmp =
+        reinterpret_cast<char*>(p0 + n);
+    std::memcpy(tmp, first, size);
+    {
+        param* p = p0;
+        std::size_t pos = 0;
+        for(;;)
+        {
+            std::size_t const end =
+                (std::min)(q.find('&', pos), size);
+            core::string_view const s =
+                q.substr(pos, end - pos);
+            *p++ = { pos, s.size(),
+                (std::min)(s.find('='), s.size()) };
+            if(end == size)
+                break;
+            pos = end + 1;
+        }
+        BOOST_ASSERT(p == p0 + n);
+    }
+
+    // params with equal keys keep their
+    // order, which may be significant.
+    // Comparing the offsets makes the sort
+    // stable without another buffer.
+    std::sort(p0, p0 + n,
+        [tmp](param const& a, param const& b)
+        {
+            int const r = detail::compare_encoded(
+                core::string_view(
+                    tmp + a.pos, a.key_size),
+                core::string_view(
+                    tmp + b.pos, b.key_size));
+            if(r != 0)
+                return r < 0;
+            return a.pos < b.pos;
+        });
+
+    char* dest = first;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        if(i != 0)
+            *dest++ = '&';
+        std::memcpy(dest,
+            tmp + p0[i].pos, p0[i].size);
+        dest += p0[i].size;
+    }
+    BOOST_ASSERT(dest == first + size);
+}
+
 url_base&
 url_base::
 normalize_fragment()
 {
+    detail::stats_normalize();
     op_t op(*this);
     normalize_octets_impl(
         id_frag, detail::fragment_chars, op);
@@ -1925,14 +1953,147 @@ url_base&
 url_base::
 normalize()
 {
-    normalize_fragment();
-    normalize_query();
-    normalize_path();
-    normalize_authority();
-    normalize_scheme();
+    BOOST_URL_PROBE1(normalize_entry, size());
+    if (size() == 0)
+    {
+        BOOST_URL_PROBE1(normalize_return, 0);
+        return *this;
+    }
+    detail::stats_normalize();
+
+    // Normalization never grows the URL,
+    // except when colons in the first
+    // segment of a relative path need to
+    // be encoded. So each part is written
+    // left to right into the same buffer,
+    // and the tail is never moved.
+    op_t op(*this);
+    // id_scheme is -1, so the offset of
+    // each part is at offset[id + 1]
+    std::size_t offset[id_end + 2];
+    bool encode_colons = false;
+    char* dest = s_;
+    for (int id = id_scheme; id < id_end; ++id)
+    {
+        offset[id + 1] = dest - s_;
+        core::string_view const s = impl_.get(id);
+        switch (id)
+        {
+        case id_scheme:
+            for (char c : s)
+                *dest++ = grammar::to_lower(c);
+            break;
+
+        case id_user:
+            dest = detail::normalize_octets(
+                dest, s, detail::user_chars);
+            break;
+
+        case id_pass:
+            dest = detail::normalize_octets(
+                dest, s, detail::password_chars);
+            break;
+
+        case id_host:
+        {
+            char* const first = dest;
+            if (host_type() == urls::host_type::name)
+                dest = detail::normalize_octets(
+                    dest, s, detail::reg_name_chars);
+            else
+            {
+                std::memmove(dest, s.data(), s.size());
+                dest += s.size();
+            }
+            // lowercase the decoded chars
+            char* it = first;
+            while (it < dest)
+            {
+                if (*it != '%')
+                {
+                    *it = grammar::to_lower(*it);
+                    ++it;
+                    continue;
+                }
+                it += 3;
+            }
+            break;
+        }
+
+        case id_path:
+        {
+            char* const first = dest;
+            dest = detail::normalize_octets(
+                dest, s, detail::segment_chars);
+            core::string_view p(first, dest - first);
+            core::string_view first_seg;
+            std::size_t const skip_dot =
+                detail::normalized_path_prefix(
+                    p, has_scheme(), has_authority(),
+                    encode_colons, first_seg);
+            if (encode_colons)
+            {
+                // the path needs to grow, which
+                // normalize_path does at the end
+                break;
+            }
+            p.remove_prefix(skip_dot);
+            dest = first + skip_dot +
+                detail::remove_dot_segments(
+                    first + skip_dot, dest, p);
+            break;
+        }
+
+        case id_query:
+            dest = detail::normalize_octets(
+                dest, s, detail::query_chars);
+            break;
+
+        case id_frag:
+            dest = detail::normalize_octets(
+                dest, s, detail::fragment_chars);
+            break;
+
+        default:
+            // port
+            std::memmove(dest, s.data(), s.size());
+            dest += s.size();
+            break;
+        }
+    }
+    offset[id_end + 1] = dest - s_;
+
+    bool const path_changed =
+        offset[id_query + 1] - offset[id_path + 1] !=
+            impl_.len(id_path);
+    for (int id = id_user; id <= id_end; ++id)
+        impl_.offset_[id] = offset[id + 1];
+    s_[size()] = '\0';
+    if (path_changed)
+        update_path_counts();
+
+    if (encode_colons)
+        normalize_path();
+    BOOST_URL_PROBE1(normalize_return, size());
     return *this;
 }
 
+void
+url_base::
+update_path_counts() noexcept
+{
+    // the count excludes a "/." or "."
+    // prefix kept for the path to be valid
+    core::string_view p = encoded_path();
+    if (!p.empty())
+        impl_.nseg_ = detail::path_segments(p,
+            std::count(p.begin() + 1, p.end(), '/') + 1);
+    else
+        impl_.nseg_ = 0;
+    impl_.decoded_[id_path] =
+        detail::decode_bytes_unsafe(impl_.get(id_path));
+}
+
 //------------------------------------------------
 //
 // Implementation
@@ -33,27 +33,13 @@ construct() const noexcept
 url_view::
 url_view() noexcept = default;
 
+auto
 url_view::
-url_view(core::string_view s)
-    : url_view(parse_uri_reference(s
-        ).value(BOOST_URL_POS))
+parse_runtime(core::string_view s) ->
+    detail::url_impl
 {
-}
-
-url_view::
-url_view(
-    url_view_base const& u) noexcept
-    : url_view_base(u.impl_)
-{
-    if (u.pi_->from_ == from::url)
-    {
-        pi_ = u.pi_;
-    }
-    else
-    {
-        impl_ = u.impl_;
-        pi_ = &impl_;
-    }
+    return parse_uri_reference(s
+        ).value(BOOST_URL_POS).impl_;
 }
 
 url_view&
@@ -13,6 +13,7 @@
 #include <boost/url/url_view_base.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/detail/except.hpp>
+#include "detail/decode.hpp"
 #include "detail/normalize.hpp"
 #include "detail/over_allocator.hpp"
 
@@ -27,34 +28,85 @@ url_view_base() noexcept
 {
 }
 
-// construct reference
-url_view_base::
-url_view_base(
-    detail::url_impl const& impl) noexcept
-    : impl_(impl)
-    , pi_(&impl_)
+//------------------------------------------------
+
+namespace {
+
+// feed the decoded size of a part,
+// so that a decoded delimiter cannot
+// stand for the end of the part
+void
+digest_size(
+    std::size_t n,
+    detail::sip_hasher& h) noexcept
 {
+    auto v = static_cast<std::uint64_t>(n);
+    for(int i = 0; i < 8; ++i)
+    {
+        h.put(static_cast<char>(v & 0xff));
+        v >>= 8;
+    }
 }
 
-//------------------------------------------------
+// hash the url as if it were normalized.
+// Each part is preceded by its decoded
+// size, except the path, which is last
+// and whose normalized size is unknown
+// until it is hashed.
+void
+digest_impl(
+    detail::url_impl const& impl,
+    bool is_path_absolute,
+    detail::sip_hasher& h) noexcept
+{
+    using parts = detail::parts_base;
+    auto const scheme = impl.get(parts::id_scheme);
+    digest_size(scheme.size(), h);
+    detail::ci_digest(scheme, h);
+    auto const encoded = [&h](
+        core::string_view s)
+    {
+        digest_size(
+            detail::decode_bytes_unsafe(s), h);
+        detail::digest_encoded(s, h);
+    };
+    encoded(impl.get(parts::id_user));
+    encoded(impl.get(parts::id_pass));
+    auto const host = impl.get(parts::id_host);
+    digest_size(
+        detail::decode_bytes_unsafe(host), h);
+    detail::ci_digest_encoded(host, h);
+    auto const port = impl.get(parts::id_port);
+    digest_size(port.size(), h);
+    h.put(port);
+    encoded(impl.get(parts::id_query));
+    encoded(impl.get(parts::id_frag));
+    detail::normalized_path_digest(
+        impl.get(parts::id_path), is_path_absolute, h);
+}
+
+} // (anon)
 
 std::size_t
 url_view_base::
 digest(std::size_t salt) const noexcept
 {
-    detail::fnv_1a h(salt);
-    detail::ci_digest(pi_->get(id_scheme), h);
-    detail::digest_encoded(pi_->get(id_user), h);
-    detail::digest_encoded(pi_->get(id_pass), h);
-    detail::ci_digest_encoded(pi_->get(id_host), h);
-    h.put(pi_->get(id_port));
-    detail::normalized_path_digest(
-        pi_->get(id_path), is_path_absolute(), h);
-    detail::digest_encoded(pi_->get(id_query), h);
-    detail::digest_encoded(pi_->get(id_frag), h);
+    detail::sip_hasher h(salt);
+    digest_impl(*pi_, is_path_absolute(), h);
     return h.digest();
 }
 
+std::pair<std::uint64_t, std::uint64_t>
+url_view_base::
+digest128(
+    std::uint64_t k0,
+    std::uint64_t k1) const noexcept
+{
+    detail::sip_hasher h(k0, k1, true);
+    digest_impl(*pi_, is_path_absolute(), h);
+    return h.digest128();
+}
+
 //------------------------------------------------
 //
 // Observers
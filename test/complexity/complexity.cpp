@@ -0,0 +1,373 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include <boost/url.hpp>
+
+#include "test_suite.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/*  Check that the cost of each operation
+    grows linearly with the size of inputs
+    built to trigger backtracking or
+    repeated work.
+
+    Each operation is timed on inputs of
+    growing sizes. The test fails when the
+    time per byte on the largest input is
+    more than `threshold` times the time
+    per byte on the smallest one. A linear
+    algorithm stays close to 1, while a
+    quadratic one reaches the ratio of the
+    sizes.
+
+    The environment variable
+    BOOST_URL_COMPLEXITY_THRESHOLD
+    overrides the threshold.
+*/
+struct complexity_test
+{
+    using clock_type =
+        std::chrono::steady_clock;
+
+    // an input of about n bytes
+    using generator =
+        std::string(*)(std::size_t n);
+
+    // returns a value depending
+    // on the work done
+    using operation =
+        std::size_t(*)(core::string_view s);
+
+    struct shape
+    {
+        char const* name;
+        generator gen;
+    };
+
+    struct op
+    {
+        char const* name;
+        operation f;
+    };
+
+    static constexpr std::size_t small_size = 1024;
+    static constexpr std::size_t large_size = 16 * 1024;
+
+    // bytes processed by each sample
+    static constexpr std::size_t sample_bytes = 256 * 1024;
+
+    static constexpr int samples = 3;
+
+    double threshold = 4;
+
+    std::size_t sink = 0;
+
+    //--------------------------------------------
+    //
+    // Shapes
+    //
+    //--------------------------------------------
+
+    // prefix + s * k + suffix, about n bytes
+    static
+    std::string
+    repeat(
+        core::string_view prefix,
+        core::string_view s,
+        core::string_view suffix,
+        std::size_t n)
+    {
+        std::string r(prefix);
+        while(r.size() + s.size() +
+                suffix.size() <= n)
+            r.append(s.data(), s.size());
+        r.append(suffix.data(), suffix.size());
+        return r;
+    }
+
+    static
+    std::string
+    dot_dot_segments(std::size_t n)
+    {
+        return repeat("http://h/", "a/../", "b", n);
+    }
+
+    static
+    std::string
+    parent_segments(std::size_t n)
+    {
+        return repeat("/", "../", "a", n);
+    }
+
+    static
+    std::string
+    dot_segments(std::size_t n)
+    {
+        return repeat("", "./", "a:b", n);
+    }
+
+    static
+    std::string
+    empty_segments(std::size_t n)
+    {
+        return repeat("x:", "/", "", n);
+    }
+
+    static
+    std::string
+    ampersands(std::size_t n)
+    {
+        return repeat("?", "&", "", n);
+    }
+
+    static
+    std::string
+    params(std::size_t n)
+    {
+        return repeat("/?", "k=v%41&", "k", n);
+    }
+
+    // a valid address with a long zone,
+    // parsed again after the plain
+    // address fails at "%25"
+    static
+    std::string
+    ipv6_literal(std::size_t n)
+    {
+        return repeat("http://[fe80::1%25", "z%41", "]/", n);
+    }
+
+    static
+    std::string
+    ipvfuture(std::size_t n)
+    {
+        return repeat("http://[v1.", "a:", "]/", n);
+    }
+
+    static
+    std::string
+    pct_runs(std::size_t n)
+    {
+        return repeat("http://h/", "%41%2f", "?%62#%63", n);
+    }
+
+    // escapes in the userinfo, host,
+    // path, query and fragment
+    static
+    std::string
+    pct_parts(std::size_t n)
+    {
+        std::size_t const k = n / 5;
+        std::string r = repeat("//", "%41", "@", k);
+        r += repeat("", "%42", "", k);
+        r += repeat("/", "%43", "", k);
+        r += repeat("?", "%44", "", k);
+        r += repeat("#", "%45", "", k);
+        return r;
+    }
+
+    static
+    std::string
+    colons(std::size_t n)
+    {
+        return repeat("a", ":", "", n);
+    }
+
+    static
+    std::string
+    userinfo(std::size_t n)
+    {
+        return repeat("http://", "a:", "@h", n);
+    }
+
+    static
+    std::string
+    port_digits(std::size_t n)
+    {
+        return repeat("http://h:", "9", "/", n);
+    }
+
+    //--------------------------------------------
+    //
+    // Operations
+    //
+    //--------------------------------------------
+
+    static
+    std::size_t
+    parse(core::string_view s)
+    {
+        auto rv = parse_uri_reference(s);
+        if(! rv)
+            return 0;
+        return rv->size();
+    }
+
+    static
+    std::size_t
+    normalize(core::string_view s)
+    {
+        auto rv = parse_uri_reference(s);
+        if(! rv)
+            return 0;
+        url u(*rv);
+        u.normalize();
+        return u.size();
+    }
+
+    static
+    std::size_t
+    resolve(core::string_view s)
+    {
+        auto rv = parse_uri_reference(s);
+        if(! rv)
+            return 0;
+        url u("http://a/b/c/d;p?q");
+        if(! u.resolve(*rv))
+            return 0;
+        return u.size();
+    }
+
+    static
+    std::size_t
+    iterate_params(core::string_view s)
+    {
+        auto rv = parse_uri_reference(s);
+        if(! rv)
+            return 0;
+        std::size_t n = 0;
+        for(auto p : rv->params())
+            n += p.key.size() + p.value.size();
+        for(auto p : rv->encoded_params())
+            n += p.key.decoded_size();
+        return n;
+    }
+
+    static
+    std::size_t
+    iterate_segments(core::string_view s)
+    {
+        auto rv = parse_uri_reference(s);
+        if(! rv)
+            return 0;
+        std::size_t n = 0;
+        for(auto seg : rv->segments())
+            n += seg.size();
+        return n;
+    }
+
+    //--------------------------------------------
+
+    // seconds per byte of f on s
+    double
+    time_per_byte(
+        operation f,
+        std::string const& s)
+    {
+        std::size_t const reps = (std::max)(
+            std::size_t(1),
+            sample_bytes / s.size());
+        double best = 0;
+        for(int i = 0; i < samples; ++i)
+        {
+            auto const t0 = clock_type::now();
+            for(std::size_t j = 0; j < reps; ++j)
+                sink += f(s);
+            std::chrono::duration<double> const dt =
+                clock_type::now() - t0;
+            double const t = dt.count() /
+                static_cast<double>(reps * s.size());
+            if( i == 0 ||
+                t < best)
+                best = t;
+        }
+        return best;
+    }
+
+    void
+    check(
+        shape const& sh,
+        op const& o)
+    {
+        std::string const s0 = sh.gen(small_size);
+        std::string const s1 = sh.gen(large_size);
+        // an input which does not parse
+        // makes every operation return
+        // early, and measures nothing
+        if( ! BOOST_TEST(parse_uri_reference(s0)) ||
+            ! BOOST_TEST(parse_uri_reference(s1)))
+        {
+            test_suite::log <<
+                sh.name << ": invalid input\n";
+            return;
+        }
+        // warm up
+        sink += o.f(s0);
+        double const t0 = time_per_byte(o.f, s0);
+        double const t1 = time_per_byte(o.f, s1);
+        double const ratio = t0 > 0 ? t1 / t0 : 1;
+        if(! BOOST_TEST_LE(ratio, threshold))
+        {
+            test_suite::log <<
+                sh.name << ", " << o.name <<
+                ": " << t0 * 1e9 << "ns/byte for " <<
+                s0.size() << " bytes, " << t1 * 1e9 <<
+                "ns/byte for " << s1.size() <<
+                " bytes\n";
+        }
+    }
+
+    void
+    run()
+    {
+        if(char const* s = std::getenv(
+            "BOOST_URL_COMPLEXITY_THRESHOLD"))
+            threshold = std::atof(s);
+
+        shape const shapes[] = {
+            { "dot-dot segments", &dot_dot_segments },
+            { "parent segments", &parent_segments },
+            { "dot segments", &dot_segments },
+            { "empty segments", &empty_segments },
+            { "ampersands", &ampersands },
+            { "params", &params },
+            { "ipv6 literal", &ipv6_literal },
+            { "ipvfuture", &ipvfuture },
+            { "percent runs", &pct_runs },
+            { "percent runs in every part", &pct_parts },
+            { "colons", &colons },
+            { "userinfo", &userinfo },
+            { "port digits", &port_digits },
+        };
+        op const ops[] = {
+            { "parse", &parse },
+            { "normalize", &normalize },
+            { "resolve", &resolve },
+            { "params", &iterate_params },
+            { "segments", &iterate_segments },
+        };
+        for(auto const& sh : shapes)
+            for(auto const& o : ops)
+                check(sh, o);
+        BOOST_TEST_NE(sink, 0u);
+    }
+};
+
+TEST_SUITE(
+    complexity_test,
+    "boost.url.complexity");
+
+} // urls
+} // boost
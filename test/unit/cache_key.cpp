@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/cache_key.hpp>
+
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <string>
+
+namespace boost {
+namespace urls {
+
+struct cache_key_test
+{
+    static
+    void
+    check(
+        cache_key_generator const& g,
+        core::string_view s,
+        core::string_view canonical)
+    {
+        url_view const u(s);
+        std::string c;
+        cache_key const k0 = g(u);
+        cache_key const k1 = g(u, c);
+        BOOST_TEST_EQ(c, canonical);
+        BOOST_TEST(k0 == k1);
+        // the heap is used when the
+        // scratch buffer is too small
+        BOOST_TEST(g.operator()<1>(u) == k0);
+    }
+
+    static
+    bool
+    same(
+        cache_key_generator const& g,
+        core::string_view a,
+        core::string_view b)
+    {
+        return g(url_view(a)) == g(url_view(b));
+    }
+
+    void
+    testCanonical()
+    {
+        cache_key_generator g;
+        check(g, "", "");
+        check(g, "HTTP://WWW.Example.COM", "http://www.example.com/");
+        check(g, "http://example.com:80/", "http://example.com/");
+        check(g, "http://example.com:/", "http://example.com/");
+        check(g, "http://example.com:8080/", "http://example.com:8080/");
+        check(g, "https://example.com:80/", "https://example.com:80/");
+        check(g, "foo://example.com:0/", "foo://example.com:0/");
+        check(g, "http://User:P%61ss@h/", "http://User:Pass@h/");
+        check(g, "http://%45x%2fample.com/", "http://ex%2Fample.com/");
+        check(g, "http://h/a/./b/../c", "http://h/a/c");
+        check(g, "http://h/%7euser/%2f", "http://h/~user/%2F");
+        check(g, "http://h/?", "http://h/");
+        check(g, "http://h/?b=2&a=1&a", "http://h/?a&a=1&b=2");
+        check(g, "http://h/?%62=1&a=%2b&c=+", "http://h/?a=%2B&b=1&c=+");
+        check(g, "http://h/?a=1&&a=1", "http://h/?&a=1&a=1");
+        check(g, "http://h/#frag", "http://h/");
+        check(g, "/a/../b?y&x", "/b?x&y");
+        check(g, "mailto:X@Y.com", "mailto:X@Y.com");
+    }
+
+    void
+    testOpts()
+    {
+        {
+            cache_key_generator g({ false, false, false, false });
+            check(g, "http://h:80/a/../b?y&x#f",
+                "http://h:80/a/../b?y&x#f");
+            check(g, "http://h:/#f%41", "http://h:/#fA");
+        }
+        {
+            cache_key_opts opt;
+            opt.sort_params = false;
+            cache_key_generator g(opt);
+            BOOST_TEST(! same(g, "http://h/?a&b", "http://h/?b&a"));
+            BOOST_TEST(same(g, "http://h/?a&b", "http://h/?%61&b"));
+        }
+    }
+
+    void
+    testIgnore()
+    {
+        cache_key_generator g;
+        g.ignore_param("utm_source")
+         .ignore_param("sid")
+         .ignore_param("s%69d");
+        check(g, "http://h/?utm_source=x&b&sid=1&a",
+            "http://h/?a&b");
+        check(g, "http://h/?utm%5Fsource=x&%73id",
+            "http://h/");
+        check(g, "http://h/?utm_sourc=x&sidx",
+            "http://h/?sidx&utm_sourc=x");
+    }
+
+    void
+    testKeys()
+    {
+        cache_key_generator g;
+        BOOST_TEST(same(g,
+            "HTTP://Example.com:80/a/./b/../c?y=2&x=1",
+            "http://example.com/a/c?x=1&y=2"));
+        BOOST_TEST(same(g,
+            "http://h/?a=%41", "http://h/?a=A"));
+        BOOST_TEST(! same(g,
+            "http://h/?a=1", "http://h/?a=2"));
+        BOOST_TEST(! same(g,
+            "http://h/a", "http://h/A"));
+        BOOST_TEST(! same(g,
+            "http://h/?a=", "http://h/?a"));
+        BOOST_TEST(! same(g,
+            "http://h/?a=%2B", "http://h/?a=+"));
+        BOOST_TEST(! same(g,
+            "http://h/a?b", "http://h/a%3Fb"));
+
+        // the key of the hash
+        cache_key_generator g2({}, 1, 2);
+        url_view const u("http://h/");
+        BOOST_TEST(g(u) != g2(u));
+        BOOST_TEST(g2(u) ==
+            cache_key_generator({}, 1, 2)(u));
+
+        // large urls
+        std::string s = "http://h/";
+        std::string t = s;
+        for(int i = 0; i < 300; ++i)
+        {
+            s += "./seg/";
+            t += "seg/";
+        }
+        s += "?";
+        t += "?";
+        for(int i = 300; i-- > 0;)
+        {
+            s += "k" + std::to_string(i) + "=v&";
+        }
+        for(int i = 0; i < 300; ++i)
+            t += "k" + std::to_string(i) + "=v&";
+        BOOST_TEST(same(g, s, t));
+    }
+
+    void
+    run()
+    {
+        testCanonical();
+        testOpts();
+        testIgnore();
+        testKeys();
+    }
+};
+
+TEST_SUITE(
+    cache_key_test,
+    "boost.url.cache_key");
+
+} // urls
+} // boost
@@ -11,7 +11,10 @@
 #include <boost/url/decode_view.hpp>
 
 #include <boost/core/ignore_unused.hpp>
+#include <iterator>
 #include <sstream>
+#include <string>
+#include <vector>
 #include "test_suite.hpp"
 
 namespace boost {
@@ -353,6 +356,145 @@ struct decode_view_test
         }
     }
 
+    void
+    testSpans()
+    {
+        auto const spans = [](
+            decode_view const& d)
+        {
+            std::vector<std::string> v;
+            for(auto it = d.span_begin();
+                    it != d.span_end(); ++it)
+            {
+                v.emplace_back((*it).data(), (*it).size());
+                BOOST_TEST_EQ(it.decoded(),
+                    it.encoded() != *it);
+            }
+            return v;
+        };
+
+        // runs of characters and
+        // single decoded characters
+        {
+            decode_view d(str);
+            std::vector<std::string> const v = spans(d);
+            BOOST_TEST_EQ(v.size(), 3u);
+            BOOST_TEST_EQ(v[0], "a");
+            BOOST_TEST_EQ(v[1], " ");
+            BOOST_TEST_EQ(v[2], "uri+test");
+        }
+        {
+            decode_view d(str, no_plus_opt);
+            std::vector<std::string> const v = spans(d);
+            BOOST_TEST_EQ(v.size(), 5u);
+            BOOST_TEST_EQ(v[2], "uri");
+            BOOST_TEST_EQ(v[3], " ");
+            BOOST_TEST_EQ(v[4], "test");
+        }
+        {
+            decode_view d("%41%42");
+            std::vector<std::string> const v = spans(d);
+            BOOST_TEST_EQ(v.size(), 2u);
+            BOOST_TEST_EQ(v[0], "A");
+            BOOST_TEST_EQ(v[1], "B");
+        }
+        {
+            decode_view d;
+            BOOST_TEST(d.span_begin() == d.span_end());
+        }
+
+        // javadoc
+        {
+        decode_view d( "Program%20Files" );
+        std::string s;
+        for( auto it = d.span_begin(); it != d.span_end(); ++it )
+            s.append( (*it).data(), (*it).size() );
+        assert( s == "Program Files" );
+        }
+    }
+
+    void
+    testCopy()
+    {
+        decode_view d(str, no_plus_opt);
+        char buf[16];
+        BOOST_TEST_EQ(d.copy(buf, sizeof(buf)), 10u);
+        BOOST_TEST_EQ(core::string_view(buf, 10), no_plus_dec_str);
+        for(std::size_t pos = 0; pos <= d.size(); ++pos)
+        {
+            for(std::size_t n = 0; n <= d.size() + 1; ++n)
+            {
+                std::size_t const m = d.copy(buf, n, pos);
+                std::string const e =
+                    std::string(no_plus_dec_str).substr(pos, n);
+                BOOST_TEST_EQ(core::string_view(buf, m), e);
+            }
+        }
+
+        // javadoc
+        {
+        char buf[ 32 ];
+        std::size_t n = decode_view( "Program%20Files" ).copy( buf, sizeof(buf) );
+        assert( core::string_view( buf, n ) == "Program Files" );
+        }
+    }
+
+    // Compare the span algorithms with
+    // the decoded strings
+    void
+    testAlgorithms()
+    {
+        core::string_view const v[] = {
+            "", "a", "b", "ab", "a%20", "a%20b", "a+b",
+            "%41", "A", "%41%42c", "ABc", "ABC", "%ff", "%FFa",
+            "%00", "%00%00", "x%2Fy/z", "x/y/z",
+        };
+        for(auto opt : { encoding_opts(false), encoding_opts(true) })
+        {
+            for(auto a : v)
+            {
+                decode_view const da(a, opt);
+                std::string const sa = da.options().space_as_plus ?
+                    std::string(da.begin(), da.end()) :
+                    pct_string_view(a).decode();
+                BOOST_TEST_EQ(da.size(), sa.size());
+                for(auto b : v)
+                {
+                    decode_view const db(b, opt);
+                    std::string const sb(db.begin(), db.end());
+                    int const r = sa.compare(sb);
+                    int const r0 = (r > 0) - (r < 0);
+                    BOOST_TEST_EQ(da.compare(db), r0);
+                    BOOST_TEST_EQ(da.compare(sb), r0);
+                    BOOST_TEST_EQ(da == db, sa == sb);
+                    BOOST_TEST_EQ(da.starts_with(sb),
+                        sa.compare(0, sb.size(), sb) == 0 &&
+                        sb.size() <= sa.size());
+                }
+                for(char c : { 'a', 'b', 'A', ' ', '/', '+', '\0', '\xff' })
+                {
+                    auto const it = da.find(c);
+                    std::size_t const i = sa.find(c);
+                    if(i == std::string::npos)
+                    {
+                        BOOST_TEST(it == da.end());
+                        continue;
+                    }
+                    BOOST_TEST_EQ(static_cast<std::size_t>(
+                        std::distance(da.begin(), it)), i);
+                    BOOST_TEST_EQ(*it, c);
+                }
+                for(std::size_t n = 0; n <= da.size(); ++n)
+                {
+                    decode_view d = da;
+                    d.remove_prefix(n);
+                    BOOST_TEST_EQ(d, sa.substr(n));
+                    BOOST_TEST_EQ(d.size(), sa.size() - n);
+                }
+            }
+        }
+    }
+
     void
     run()
     {
@@ -365,6 +507,9 @@ struct decode_view_test
         testCompare();
         testStream();
         testPR127Cases();
+        testSpans();
+        testCopy();
+        testAlgorithms();
     }
 };
 
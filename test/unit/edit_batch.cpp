@@ -0,0 +1,318 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/edit_batch.hpp>
+
+#include <boost/url/static_url.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <cstdint>
+#include <string>
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+namespace boost {
+namespace urls {
+
+struct edit_batch_test
+{
+    // a change recorded in the batch
+    // and applied to the url directly
+    struct change
+    {
+        int op;
+        core::string_view s0;
+        core::string_view s1;
+        std::size_t i;
+    };
+
+    static
+    void
+    apply(
+        edit_batch& b,
+        url& u,
+        change const& c)
+    {
+        switch(c.op)
+        {
+        case 0:
+            b.append_param({ c.s0, c.s1 });
+            u.params().append({ c.s0, c.s1 });
+            break;
+        case 1:
+            b.append_param({ c.s0, nullptr });
+            u.params().append({ c.s0, nullptr });
+            break;
+        case 2:
+            b.set_param(c.s0, c.s1);
+            u.params().set(c.s0, c.s1);
+            break;
+        case 3:
+            b.set_param(c.s0, c.s1, ignore_case);
+            u.params().set(c.s0, c.s1, ignore_case);
+            break;
+        case 4:
+            BOOST_TEST_EQ(
+                b.erase_param(c.s0),
+                u.params().erase(c.s0));
+            break;
+        case 5:
+            BOOST_TEST_EQ(
+                b.erase_param(c.s0, ignore_case),
+                u.params().erase(c.s0, ignore_case));
+            break;
+        case 6:
+        {
+            auto const i = c.i % (
+                u.segments().size() + 1);
+            b.insert_segment(i, c.s0);
+            u.segments().insert(std::next(
+                u.segments().begin(), i), c.s0);
+            break;
+        }
+        case 7:
+        {
+            if(u.segments().empty())
+                break;
+            auto const i = c.i %
+                u.segments().size();
+            b.erase_segment(i);
+            u.segments().erase(std::next(
+                u.segments().begin(), i));
+            break;
+        }
+        case 8:
+            b.push_back_segment(c.s0);
+            u.segments().push_back(c.s0);
+            break;
+        default:
+            if(u.segments().empty())
+                break;
+            b.pop_back_segment();
+            u.segments().pop_back();
+            break;
+        }
+    }
+
+    static
+    void
+    check_equal(
+        url_view const& u0,
+        url_view const& u1)
+    {
+        BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+        BOOST_TEST_EQ(
+            u0.segments().size(),
+            u1.segments().size());
+        BOOST_TEST_EQ(
+            u0.params().size(),
+            u1.params().size());
+        BOOST_TEST_EQ(u0.path(), u1.path());
+        BOOST_TEST_EQ(u0.query(), u1.query());
+    }
+
+    void
+    testSequences()
+    {
+        core::string_view const urls[] = {
+            "",
+            "x",
+            "/",
+            "/a/b",
+            "a/b:c",
+            "./a:b",
+            "x%3Ay/z",
+            ".//x",
+            "/./a",
+            "/.//a",
+            "//h",
+            "//h/a/",
+            "s:",
+            "s:a/b",
+            "s:/a/",
+            "s://h/a?x=1#f",
+            "?",
+            "?&&",
+            "?a=1&b&a=2",
+            "#f",
+            "http://h/p?a=1&A=2&b=%41#f",
+            "http://h/a/b/c/d?k=v&k=w&z",
+        };
+        // "." is not used as a segment: inserting
+        // it first in a relative path produces a
+        // prefix which segments_ref misreads
+        core::string_view const strs[] = {
+            "", "a", "A", "b", "b:c", ":", "..",
+            "x y", "%", "k=v&w", "1", ".",
+        };
+        std::size_t const nstr =
+            sizeof(strs) / sizeof(strs[0]);
+
+        std::uint32_t seed = 1;
+        auto rand = [&seed]
+        {
+            seed = seed * 1103515245 + 12345;
+            return static_cast<std::size_t>(
+                (seed >> 16) & 0x7fff);
+        };
+        for(auto s : urls)
+        {
+            for(int n = 0; n < 500; ++n)
+            {
+                url u0(s);
+                url u1(s);
+                edit_batch b(u0);
+                std::size_t const len =
+                    1 + rand() % 6;
+                for(std::size_t i = 0; i < len; ++i)
+                {
+                    change c;
+                    c.op = static_cast<int>(rand() % 10);
+                    c.s0 = strs[rand() % (
+                        c.op < 6 ? nstr : nstr - 1)];
+                    c.s1 = strs[rand() % nstr];
+                    c.i = rand();
+                    apply(b, u1, c);
+                }
+                // nothing changes until commit
+                BOOST_TEST_EQ(u0.buffer(), s);
+                b.commit();
+                BOOST_TEST(b.empty());
+                check_equal(u0, u1);
+            }
+        }
+    }
+
+    void
+    testBatch()
+    {
+        // empty batch
+        {
+            url u("/a?b#c");
+            edit_batch b(u);
+            BOOST_TEST(b.empty());
+            b.commit();
+            BOOST_TEST_EQ(u.buffer(), "/a?b#c");
+            BOOST_TEST_EQ(&b.url(), &u);
+        }
+
+        // clear discards changes
+        {
+            url u("/a?b#c");
+            edit_batch b(u);
+            b.push_back_segment("d");
+            b.append_param({ "e", "f" });
+            BOOST_TEST(! b.empty());
+            b.clear();
+            BOOST_TEST(b.empty());
+            b.commit();
+            BOOST_TEST_EQ(u.buffer(), "/a?b#c");
+        }
+
+        // reuse after commit
+        {
+            url u("/a?b#c");
+            edit_batch b(u);
+            b.append_param({ "x", "1" });
+            b.commit();
+            BOOST_TEST_EQ(u.buffer(), "/a?b&x=1#c");
+            b.erase_segment(0);
+            b.erase_param("b");
+            b.commit();
+            BOOST_TEST_EQ(u.buffer(), "/?x=1#c");
+        }
+
+        // only the query
+        {
+            url u("http://h/a/b?x=1#f");
+            edit_batch b(u);
+            b.set_param("x", "2");
+            b.set_param("y", "a b");
+            b.commit();
+            BOOST_TEST_EQ(u.buffer(), "http://h/a/b?x=2&y=a%20b#f");
+        }
+
+        // only the path
+        {
+            url u("http://h/a/b?x=1#f");
+            edit_batch b(u);
+            b.insert_segment(1, "c d");
+            b.pop_back_segment();
+            b.commit();
+            BOOST_TEST_EQ(u.buffer(), "http://h/a/c%20d?x=1#f");
+        }
+
+        // erase everything
+        {
+            url u("http://h/a/b?x=1&y#f");
+            edit_batch b(u);
+            b.pop_back_segment();
+            b.pop_back_segment();
+            BOOST_TEST_EQ(b.erase_param("x"), 1u);
+            BOOST_TEST_EQ(b.erase_param("y"), 1u);
+            BOOST_TEST_EQ(b.erase_param("z"), 0u);
+            b.commit();
+            BOOST_TEST_EQ(u.buffer(), "http://h#f");
+        }
+
+        // strong guarantee
+        {
+            static_url<16> u("/a?b=1#c");
+            edit_batch b(u);
+            b.push_back_segment("path");
+            b.append_param({ "key", "value" });
+            BOOST_TEST_THROWS(b.commit(),
+                system::system_error);
+            BOOST_TEST_EQ(u.buffer(), "/a?b=1#c");
+            BOOST_TEST(! b.empty());
+            b.erase_param("key");
+            b.commit();
+            BOOST_TEST_EQ(u.buffer(), "/a/path?b=1#c");
+        }
+    }
+
+    void
+    testJavadocs()
+    {
+        // edit_batch
+        {
+        url u( "https://www.example.com/api/v1?page=2&sort=asc&debug" );
+
+        edit_batch b( u );
+        b.set_param( "page", "3" );
+        b.erase_param( "debug" );
+        b.append_param( { "limit", "50" } );
+        b.erase_segment( 1 );
+        b.push_back_segment( "v2" );
+        b.commit();
+
+        assert( u.buffer() == "https://www.example.com/api/v2?page=3&sort=asc&limit=50" );
+        }
+    }
+
+    void
+    run()
+    {
+        testSequences();
+        testBatch();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    edit_batch_test,
+    "boost.url.edit_batch");
+
+} // urls
+} // boost
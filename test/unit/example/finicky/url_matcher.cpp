@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include "url_matcher.hpp"
+
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+struct url_matcher_test
+{
+    void
+    testGlob()
+    {
+        BOOST_TEST(glob_match("", ""));
+        BOOST_TEST(! glob_match("", "a"));
+        BOOST_TEST(glob_match("abc", "abc"));
+        BOOST_TEST(! glob_match("abc", "abd"));
+        BOOST_TEST(glob_match("*", ""));
+        BOOST_TEST(glob_match("*", "abc"));
+        BOOST_TEST(! glob_match("*", "a/c"));
+        BOOST_TEST(glob_match("**", "a/c"));
+        BOOST_TEST(glob_match("a*c", "abbbc"));
+        BOOST_TEST(glob_match("a*c", "ac"));
+        BOOST_TEST(! glob_match("a*c", "ab/c"));
+        BOOST_TEST(glob_match("a**c", "ab/c"));
+        BOOST_TEST(glob_match("/*/x", "/abc/x"));
+        BOOST_TEST(! glob_match("/*/x", "/a/b/x"));
+        BOOST_TEST(glob_match("/**/x", "/a/b/x"));
+        BOOST_TEST(glob_match("**/*apple.com/*",
+            "https://www.apple.com/"));
+        BOOST_TEST(! glob_match("**/*apple.com/*",
+            "https://www.apple.com/mac/"));
+        BOOST_TEST(glob_match("*a*a*a*", "aaa"));
+        BOOST_TEST(! glob_match("*a*a*a*b",
+            std::string(200, 'a')));
+        BOOST_TEST(! glob_match("ABC", "abc"));
+        BOOST_TEST(glob_match("ABC", "abc", true));
+        BOOST_TEST(glob_match("*.EXAMPLE.com", "www.example.COM", true));
+    }
+
+    void
+    testMatch()
+    {
+        url_matcher m;
+        BOOST_TEST_EQ(m.size(), 0u);
+        BOOST_TEST_EQ(m.add(url_part::host, "*.example.com"), 0u);
+        BOOST_TEST_EQ(m.add({
+            { url_part::host, "www.boost.org" },
+            { url_part::path, "/doc/**" } }), 1u);
+        BOOST_TEST_EQ(m.add(url_part::host, "www.boost.org"), 2u);
+        BOOST_TEST_EQ(m.add(url_part::scheme, "ftp"), 3u);
+        BOOST_TEST_EQ(m.add(url_part::path, "/*"), 4u);
+        BOOST_TEST_EQ(m.add(url_part::query, "*utm_source=*"), 5u);
+        BOOST_TEST_EQ(m.add(url_part::url, "**.pdf"), 6u);
+        BOOST_TEST_EQ(m.add(url_part::port, "8080"), 7u);
+        BOOST_TEST_EQ(m.size(), 8u);
+        m.compile();
+
+        url_rule_matches r;
+        auto const first =
+            [&](core::string_view s)
+            {
+                return m.match(url_view(s), r);
+            };
+        auto const all =
+            [&](core::string_view s)
+            {
+                m.match_all(url_view(s), r);
+                return r.ids();
+            };
+        using v = std::vector<std::size_t>;
+
+        BOOST_TEST_EQ(first("https://www.example.com/a/b"), 0u);
+        BOOST_TEST_EQ(first("https://WWW.Example.COM/a/b"), 0u);
+        BOOST_TEST_EQ(first("https://example.com/a/b"), url_matcher::npos);
+        BOOST_TEST_EQ(first("https://www.boost.org/doc/libs"), 1u);
+        BOOST_TEST_EQ(first("https://www.boost.org/users/"), 2u);
+        BOOST_TEST_EQ(first("FTP://h/x/y"), 3u);
+        BOOST_TEST_EQ(first("http://h/x"), 4u);
+        BOOST_TEST_EQ(first("http://h/x/y?a=1&utm_source=z"), 5u);
+        BOOST_TEST_EQ(first("http://h/x/y.pdf"), 6u);
+        BOOST_TEST_EQ(first("http://h:8080/x/y"), 7u);
+        BOOST_TEST_EQ(first("http://h:80/x/y"), url_matcher::npos);
+
+        BOOST_TEST(all("https://www.boost.org/doc/") == (v{ 1, 2 }));
+        BOOST_TEST(all("ftp://a.example.com:8080/f.pdf?utm_source=x") ==
+            (v{ 0, 3, 4, 5, 7 }));
+        BOOST_TEST_EQ(r.size(), 5u);
+        BOOST_TEST(all("http://h/x/y").empty());
+        BOOST_TEST(r.empty());
+
+        // adding requires compiling again
+        BOOST_TEST_EQ(m.add({}), 8u);
+        m.compile();
+        BOOST_TEST_EQ(first("http://h/x/y"), 8u);
+        BOOST_TEST(all("http://h/x") == (v{ 4, 8 }));
+    }
+
+    void
+    testRepeated()
+    {
+        // literals which appear several times,
+        // and rules which share a literal
+        url_matcher m;
+        m.add(url_part::path, "/a/*/a/*");
+        m.add(url_part::path, "**/a/b");
+        m.add(url_part::path, "**/a/**");
+        m.add(url_part::path, "**/b/**");
+        m.compile();
+        url_rule_matches r;
+        m.match_all(url_view("/a/x/a/b"), r);
+        BOOST_TEST(r.ids() == (std::vector<std::size_t>{ 0, 1, 2 }));
+        BOOST_TEST_EQ(m.match(url_view("/x/a/b"), r), 1u);
+        BOOST_TEST_EQ(m.match(url_view("/b/b/b/"), r), 3u);
+    }
+
+    void
+    testRandom()
+    {
+        // compare with checking every rule
+        std::mt19937 g(42);
+        char const* const hosts[] = {
+            "example.com", "www.example.com", "a.b.c",
+            "EXAMPLE.org", "xx", "" };
+        char const* const paths[] = {
+            "", "/", "/a", "/a/b", "/ab/b/", "/b/a/ba",
+            "/aaa/bbb/ab", "/x.pdf" };
+        char const pattern_chars[] = "ab/*.x";
+        auto const random_pattern =
+            [&]
+            {
+                std::string s;
+                std::size_t const n = g() % 7;
+                for(std::size_t i = 0; i < n; ++i)
+                    s.push_back(pattern_chars[g() % 6]);
+                return s;
+            };
+
+        struct rule
+        {
+            bool has_host;
+            std::string host;
+            std::string path;
+        };
+        std::vector<rule> rules;
+        url_matcher m;
+        for(std::size_t i = 0; i < 300; ++i)
+        {
+            rule x;
+            x.has_host = g() % 3 == 0;
+            x.host = x.has_host
+                ? std::string(hosts[g() % 6])
+                : std::string();
+            if(x.has_host && g() % 2)
+                x.host.insert(0, "*");
+            x.path = random_pattern();
+            if(x.has_host)
+                m.add({
+                    { url_part::host, x.host },
+                    { url_part::path, x.path } });
+            else
+                m.add(url_part::path, x.path);
+            rules.push_back(x);
+        }
+        m.compile();
+
+        url_rule_matches r;
+        for(auto h : hosts)
+        {
+            for(auto p : paths)
+            {
+                std::string s = "http://";
+                s += h;
+                s += p;
+                url_view u(s);
+                std::vector<std::size_t> expect;
+                for(std::size_t i = 0; i < rules.size(); ++i)
+                {
+                    auto const& x = rules[i];
+                    if(x.has_host && ! glob_match(
+                            x.host, u.encoded_host(), true))
+                        continue;
+                    if(glob_match(x.path, u.encoded_path()))
+                        expect.push_back(i);
+                }
+                m.match_all(u, r);
+                BOOST_TEST(r.ids() == expect);
+                BOOST_TEST_EQ(m.match(u, r), expect.empty()
+                    ? url_matcher::npos : expect.front());
+            }
+        }
+    }
+
+    void
+    run()
+    {
+        testGlob();
+        testMatch();
+        testRepeated();
+        testRandom();
+    }
+};
+
+TEST_SUITE(
+    url_matcher_test,
+    "boost.url.url_matcher");
+
+} // urls
+} // boost
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2023 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include "url_sanitizer.hpp"
+
+#include <boost/url/parse.hpp>
+#include <boost/url/url.hpp>
+#include "test_suite.hpp"
+#include <string>
+
+namespace boost {
+namespace urls {
+
+struct url_sanitizer_test
+{
+    static
+    url_sanitizer
+    make()
+    {
+        url_sanitizer s;
+        s.add("utm_*");
+        s.add("FBCLID");
+        s.add("");
+        s.add("*.example.com", "ref");
+        s.add("www.boost.org", "tag_*");
+        s.compile();
+        return s;
+    }
+
+    void
+    testRemoves()
+    {
+        url_sanitizer const s = make();
+        BOOST_TEST(s.removes("h", "utm_"));
+        BOOST_TEST(s.removes("h", "utm_source"));
+        BOOST_TEST(s.removes("h", "UTM_Source"));
+        BOOST_TEST(s.removes("h", "utm%5fsource"));
+        BOOST_TEST(s.removes("h", "%75tm_x"));
+        BOOST_TEST(! s.removes("h", "utm"));
+        BOOST_TEST(! s.removes("h", "xutm_"));
+        BOOST_TEST(s.removes("h", "fbclid"));
+        BOOST_TEST(! s.removes("h", "fbclid2"));
+        BOOST_TEST(! s.removes("h", "fbcli"));
+        BOOST_TEST(s.removes("h", ""));
+
+        // per host
+        BOOST_TEST(! s.removes("h", "ref"));
+        BOOST_TEST(s.removes("example.com", "ref"));
+        BOOST_TEST(s.removes("www.EXAMPLE.com", "ref"));
+        BOOST_TEST(s.removes("a.b.example.com", "ref"));
+        BOOST_TEST(! s.removes("badexample.com", "ref"));
+        BOOST_TEST(! s.removes("example.com.au", "ref"));
+        BOOST_TEST(s.removes("www.boost.org", "tag_1"));
+        BOOST_TEST(! s.removes("boost.org", "tag_1"));
+        BOOST_TEST(! s.removes("a.www.boost.org", "tag_1"));
+
+        // nothing compiled
+        url_sanitizer e;
+        e.compile();
+        BOOST_TEST(! e.removes("h", "utm_source"));
+    }
+
+    void
+    testSanitize()
+    {
+        url_sanitizer const s = make();
+        std::string buf;
+        auto const check =
+            [&](core::string_view in, core::string_view out)
+            {
+                core::string_view const v =
+                    s.sanitize(url_view(in), buf);
+                BOOST_TEST_EQ(v, out);
+                BOOST_TEST_EQ(v.data(), buf.data());
+                BOOST_TEST(parse_uri_reference(v).has_value());
+
+                url u(in);
+                std::size_t const n = s.sanitize(u);
+                BOOST_TEST_EQ(u.buffer(), out);
+                BOOST_TEST_EQ(n == 0, in == out);
+            };
+
+        check("", "");
+        check("https://h/p", "https://h/p");
+        check("https://h/p#f", "https://h/p#f");
+        check("https://h/p?", "https://h/p");
+        check("https://h/p?x", "https://h/p?x");
+        check("https://h/p?utm_source=a", "https://h/p");
+        check("https://h/p?utm_source=a#f", "https://h/p#f");
+        check("https://h/p?a=1&utm_source=a&b=2&fbclid=x",
+            "https://h/p?a=1&b=2");
+        check("https://h/p?utm_source=a&a=1&&b#f",
+            "https://h/p?a=1&b#f");
+
+        // empty keys are removed
+        check("https://h/p?a=&utm_medium=&=v",
+            "https://h/p?a=");
+        check("https://h/p?ref=1&a=%20#utm_x",
+            "https://h/p?ref=1&a=%20#utm_x");
+        check("https://www.example.com/?id=1&ref=y&utm_id=2",
+            "https://www.example.com/?id=1");
+        check("/relative?utm_x=1&k=v", "/relative?k=v");
+        check("?utm_x", "");
+
+        // the buffer is reused
+        s.sanitize(url_view(
+            "https://h/p?a=1&utm_source=a&b=2"), buf);
+        auto const cap = buf.capacity();
+        auto const data = buf.data();
+        s.sanitize(url_view(
+            "https://h/q?utm_source=a&b=2"), buf);
+        BOOST_TEST_EQ(buf, "https://h/q?b=2");
+        BOOST_TEST_EQ(buf.capacity(), cap);
+        BOOST_TEST_EQ(buf.data(), data);
+    }
+
+    void
+    testTracking()
+    {
+        url_sanitizer s;
+        s.add_tracking_params();
+        s.compile();
+        std::string buf;
+        BOOST_TEST_EQ(s.sanitize(url_view(
+            "https://www.boost.org/doc/?utm_source=news&utm_campaign=x"
+            "&version=1.84&gclid=123&mc_eid=abc#top"), buf),
+            "https://www.boost.org/doc/?version=1.84#top");
+    }
+
+    void
+    run()
+    {
+        testRemoves();
+        testSanitize();
+        testTracking();
+    }
+};
+
+TEST_SUITE(
+    url_sanitizer_test,
+    "boost.url.url_sanitizer");
+
+} // urls
+} // boost
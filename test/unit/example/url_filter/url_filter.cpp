@@ -0,0 +1,337 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include "url_filter.hpp"
+
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+namespace boost {
+namespace urls {
+
+struct url_filter_test
+{
+    static
+    std::string
+    make_url(
+        core::string_view prefix,
+        std::size_t i)
+    {
+        std::string s = "https://www.example.com/";
+        s.append(prefix.data(), prefix.size());
+        s += "/item-";
+        s += std::to_string(i);
+        s += ".html?id=";
+        s += std::to_string(i * 7);
+        return s;
+    }
+
+    void
+    testEmpty()
+    {
+        url_filter f;
+        BOOST_TEST(f.read_only());
+        BOOST_TEST(! f.contains(url_view("/")));
+        BOOST_TEST(f.serialize().empty());
+        BOOST_TEST_EQ(f.memory_usage(), 0u);
+        BOOST_TEST_EQ(f.capacity(), 0u);
+        BOOST_TEST_EQ(f.blocks(), 0u);
+        BOOST_TEST_EQ(f.size_estimate(), 0u);
+
+        BOOST_TEST_THROWS(url_filter(10, 0),
+            system::system_error);
+        BOOST_TEST_THROWS(url_filter(10, 1),
+            system::system_error);
+        BOOST_TEST_THROWS(url_filter(10, -1),
+            system::system_error);
+        BOOST_TEST_THROWS(url_filter(
+            std::size_t(-1), 0.01),
+            system::system_error);
+
+        url_filter f2(0, 0.5);
+        BOOST_TEST_EQ(f2.blocks(), 1u);
+        BOOST_TEST_EQ(f2.hashes(), 1u);
+        BOOST_TEST(! f2.contains(url_view("/")));
+    }
+
+    void
+    testInsert()
+    {
+        url_filter f(1000, 0.01);
+        BOOST_TEST(! f.read_only());
+        BOOST_TEST_EQ(f.capacity(), 1000u);
+        BOOST_TEST_EQ(f.hashes(), 7u);
+        BOOST_TEST_EQ(f.memory_usage(),
+            (f.blocks() + 1) * url_filter::block_size);
+        // a new url can be a false positive
+        std::size_t added = 0;
+        for(std::size_t i = 0; i < 1000; ++i)
+        {
+            url u(make_url("a", i));
+            if(f.insert(u))
+                ++added;
+            BOOST_TEST(f.contains(u));
+            BOOST_TEST(! f.insert(u));
+        }
+        BOOST_TEST_GE(added, 990u);
+        for(std::size_t i = 0; i < 1000; ++i)
+            BOOST_TEST(f.contains(
+                url_view(make_url("a", i))));
+
+        // equivalent urls are the same element
+        BOOST_TEST(f.insert(url_view(
+            "https://www.example.com/a/b")));
+        BOOST_TEST(! f.insert(url_view(
+            "HTTPS://WWW.EXAMPLE.COM/a/./b")));
+        BOOST_TEST(f.contains(url_view(
+            "https://www.example.com/%61/c/../b")));
+        BOOST_TEST(f.contains(f.digest(url_view(
+            "https://www.example.com/a/b"))));
+
+        // escaped delimiters are not the
+        // delimiters they stand for
+        {
+            url_filter g(1000, 0.001);
+            core::string_view const pairs[][2] = {
+                { "http://h/?a%23b", "http://h/?a#b" },
+                { "http://a%3Ab@h/", "http://a:b@h/" },
+                { "http://h/%3Fa", "http://h/?a" },
+            };
+            for(auto const& p : pairs)
+            {
+                url_view const u0(p[0]);
+                url_view const u1(p[1]);
+                BOOST_TEST(g.digest(u0) != g.digest(u1));
+                BOOST_TEST(g.insert(u0));
+                BOOST_TEST(! g.contains(u1));
+                BOOST_TEST(g.insert(u1));
+            }
+        }
+
+        // the estimate is close
+        auto const n = f.size_estimate();
+        BOOST_TEST_GT(n, 900u);
+        BOOST_TEST_LT(n, 1100u);
+    }
+
+    void
+    testFalsePositives()
+    {
+        double const rates[] = {
+            0.1, 0.01, 0.001 };
+        for(double p : rates)
+        {
+            std::size_t const n = 20000;
+            url_filter f(n, p);
+            for(std::size_t i = 0; i < n; ++i)
+                f.insert(url_view(make_url("in", i)));
+            std::size_t fp = 0;
+            std::size_t const m = 100000;
+            for(std::size_t i = 0; i < m; ++i)
+                if(f.contains(url_view(make_url("out", i))))
+                    ++fp;
+            double const rate =
+                static_cast<double>(fp) / m;
+            BOOST_TEST_LE(rate, p * 1.5);
+
+            // a few bits per url
+            double const bits = 8.0 *
+                static_cast<double>(f.memory_usage()) / n;
+            BOOST_TEST_LE(bits,
+                2 * -std::log2(p) / std::log(2.0));
+        }
+    }
+
+    void
+    testThreads()
+    {
+        url_filter f(40000, 0.001);
+        std::atomic<std::size_t> added{0};
+        std::vector<std::thread> v;
+        for(std::size_t t = 0; t < 4; ++t)
+            v.emplace_back([&f, &added, t]
+            {
+                // each url is inserted by two threads
+                for(std::size_t i = 0; i < 10000; ++i)
+                    if(f.insert(url_view(make_url(
+                            "t", (t % 2) * 10000 + i))))
+                        ++added;
+            });
+        for(auto& t : v)
+            t.join();
+        std::size_t missing = 0;
+        for(std::size_t i = 0; i < 20000; ++i)
+            if(! f.contains(url_view(make_url("t", i))))
+                ++missing;
+        BOOST_TEST_EQ(missing, 0u);
+        BOOST_TEST_GE(added.load(), 19900u);
+        BOOST_TEST_LE(added.load(), 40000u);
+    }
+
+    void
+    testSerialize()
+    {
+        url_filter f(1000, 0.01, 1, 2);
+        for(std::size_t i = 0; i < 500; ++i)
+            f.insert(url_view(make_url("s", i)));
+
+        // as if read from a file
+        std::string const blob(f.serialize());
+        auto rv = url_filter::load(blob);
+        BOOST_TEST(rv);
+        url_filter const& g = *rv;
+        BOOST_TEST(g.read_only());
+        BOOST_TEST_EQ(g.blocks(), f.blocks());
+        BOOST_TEST_EQ(g.hashes(), f.hashes());
+        BOOST_TEST_EQ(g.capacity(), 1000u);
+        BOOST_TEST_EQ(g.serialize().data(), blob.data());
+        BOOST_TEST_EQ(g.size_estimate(), f.size_estimate());
+        for(std::size_t i = 0; i < 500; ++i)
+            BOOST_TEST(g.contains(
+                url_view(make_url("s", i))));
+
+        // copies of a loaded filter share the blob
+        {
+            url_filter g2(g);
+            BOOST_TEST(g2.read_only());
+            BOOST_TEST_EQ(g2.serialize().data(), blob.data());
+        }
+
+        // copies of other filters own their bits
+        {
+            url_filter f2(f);
+            BOOST_TEST(! f2.read_only());
+            BOOST_TEST_NE(f2.serialize().data(),
+                f.serialize().data());
+            BOOST_TEST(f2.serialize() == f.serialize());
+            BOOST_TEST(f2.insert(url_view(make_url("x", 0))));
+            BOOST_TEST(! f.contains(url_view(make_url("x", 0))));
+            url_filter f3;
+            f3 = f2;
+            BOOST_TEST(f3.serialize() == f2.serialize());
+            url_filter f4(std::move(f3));
+            BOOST_TEST(f3.read_only());
+            BOOST_TEST(f3.serialize().empty());
+            BOOST_TEST(f4.serialize() == f2.serialize());
+        }
+
+        // bad blobs
+        auto bad = [](std::string s)
+        {
+            BOOST_TEST_EQ(url_filter::load(s).error(),
+                grammar::error::invalid);
+        };
+        bad("");
+        bad(blob.substr(0, 63));
+        bad(blob.substr(0, blob.size() - 1));
+        bad(blob + "x");
+        {
+            std::string s = blob;
+            s[0] = 'X';
+            bad(s);
+        }
+        {
+            // byte order
+            std::string s = blob;
+            std::swap(s[8], s[15]);
+            bad(s);
+        }
+        {
+            // hashes
+            std::string s = blob;
+            s[24] = 0;
+            bad(s);
+            s[24] = 17;
+            bad(s);
+        }
+    }
+
+    void
+    testMerge()
+    {
+        url_filter f0(2000, 0.01);
+        url_filter f1(2000, 0.01);
+        for(std::size_t i = 0; i < 1000; ++i)
+        {
+            f0.insert(url_view(make_url("m", i)));
+            f1.insert(url_view(make_url("m", 1000 + i)));
+        }
+        std::string const blob(f1.serialize());
+        f0.merge(*url_filter::load(blob));
+        for(std::size_t i = 0; i < 2000; ++i)
+            BOOST_TEST(f0.contains(
+                url_view(make_url("m", i))));
+        f0.merge(f0);
+
+        // different parameters or keys
+        url_filter f2(2000, 0.001);
+        url_filter f3(4000, 0.01);
+        url_filter f4(2000, 0.01, 1, 0);
+        BOOST_TEST_THROWS(f0.merge(f2),
+            system::system_error);
+        BOOST_TEST_THROWS(f0.merge(f3),
+            system::system_error);
+        BOOST_TEST_THROWS(f0.merge(f4),
+            system::system_error);
+
+        // read-only
+        url_filter g = *url_filter::load(blob);
+        BOOST_TEST_THROWS(g.merge(f1),
+            system::system_error);
+
+        // keys change the digests
+        url_view u("https://www.example.com");
+        BOOST_TEST(f4.digest(u) != f1.digest(u));
+    }
+
+    void
+    testJavadocs()
+    {
+        // url_filter
+        {
+        url_filter f( 1000000, 0.01 );
+
+        assert( f.insert( url_view( "https://www.example.com/a" ) ) );
+        assert( ! f.insert( url_view( "HTTPS://www.example.com/%61" ) ) );
+        assert( f.contains( url_view( "https://www.example.com/./a" ) ) );
+        }
+    }
+
+    void
+    run()
+    {
+        testEmpty();
+        testInsert();
+        testFalsePositives();
+        testThreads();
+        testSerialize();
+        testMerge();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    url_filter_test,
+    "boost.url.url_filter");
+
+} // urls
+} // boost
@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include "url_pool.hpp"
+
+#include <boost/url/url.hpp>
+#include "test_suite.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+struct url_pool_test
+{
+    static
+    std::vector<std::string>
+    sitemap(std::size_t n)
+    {
+        std::vector<std::string> v;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            std::string s = "https://www.example.com/products/category-";
+            s += std::to_string(i % 7);
+            s += "/item-";
+            s += std::to_string(i);
+            s += ".html";
+            v.push_back(s);
+        }
+        // reverse order and duplicates
+        std::reverse(v.begin(), v.end());
+        v.push_back("HTTPS://www.example.com/products/category-0/item-0.html");
+        v.push_back("https://www.example.com/products/./category-1/item-1.html");
+        return v;
+    }
+
+    void
+    testEmpty()
+    {
+        url_pool p;
+        BOOST_TEST(p.empty());
+        BOOST_TEST_EQ(p.size(), 0u);
+        BOOST_TEST(p.begin() == p.end());
+        BOOST_TEST_EQ(p.find(url_view("/")), url_pool::npos);
+        BOOST_TEST(p.lower_bound(url_view("/")) == p.end());
+        BOOST_TEST_EQ(p.compression_ratio(), 1.0);
+
+        std::vector<core::string_view> v;
+        url_pool p2(v.begin(), v.end());
+        BOOST_TEST(p2.empty());
+    }
+
+    void
+    testOrder()
+    {
+        std::size_t const n = 400;
+        auto const v = sitemap(n);
+        url_pool p(v.begin(), v.end());
+        BOOST_TEST_EQ(p.size(), n);
+
+        // iteration matches operator<
+        std::vector<url> sorted(v.begin(), v.end());
+        std::stable_sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(
+            sorted.begin(), sorted.end()), sorted.end());
+        BOOST_TEST_EQ(sorted.size(), n);
+        std::size_t i = 0;
+        url prev;
+        for(auto it = p.begin(); it != p.end(); ++it, ++i)
+        {
+            BOOST_TEST_EQ(it.index(), i);
+            BOOST_TEST_EQ(*it, sorted[i]);
+            if(i > 0)
+                BOOST_TEST_LT(prev, *it);
+            prev = *it;
+        }
+        BOOST_TEST_EQ(i, n);
+
+        // random access
+        std::string scratch;
+        for(i = 0; i < n; i += 37)
+            BOOST_TEST_EQ(p.get(i, scratch), sorted[i]);
+        BOOST_TEST_EQ(p.get(n - 1, scratch), sorted[n - 1]);
+
+        // the first spelling is kept
+        BOOST_TEST_EQ(p.get(0, scratch).buffer(),
+            "https://www.example.com/products/category-0/item-0.html");
+    }
+
+    void
+    testFind()
+    {
+        std::size_t const n = 300;
+        auto const v = sitemap(n);
+        url_pool p(v.begin(), v.end());
+        std::string scratch;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            url_view u = p.get(i, scratch);
+            BOOST_TEST_EQ(p.find(u), i);
+            url copy(u);
+            BOOST_TEST(p.lower_bound(copy).index() == i);
+        }
+        BOOST_TEST_EQ(p.find(url_view(
+            "https://www.EXAMPLE.com/products/category-3/item-10.html")),
+            p.find(url_view(
+            "https://www.example.com/products/category-3/item-10.html")));
+        BOOST_TEST(p.contains(url_view(
+            "https://www.example.com/products/category-3/%69tem-10.html")));
+        BOOST_TEST(! p.contains(url_view(
+            "https://www.example.com/products/category-3/item-11.html")));
+        BOOST_TEST(! p.contains(url_view("a:")));
+        BOOST_TEST(! p.contains(url_view("zzz:")));
+
+        // lower_bound of missing urls
+        BOOST_TEST(p.lower_bound(url_view("a:")) == p.begin());
+        BOOST_TEST(p.lower_bound(url_view("zzz:")) == p.end());
+        url_view const u(
+            "https://www.example.com/products/category-3/item-100.htmm");
+        auto it = p.lower_bound(u);
+        BOOST_TEST(it != p.end());
+        BOOST_TEST_GT(*it, u);
+        std::size_t const i = it.index();
+        BOOST_TEST_GT(i, 0u);
+        BOOST_TEST_LT(p.get(i - 1, scratch), u);
+    }
+
+    void
+    testCompression()
+    {
+        auto const v = sitemap(800);
+        url_pool p(v.begin(), v.end());
+        std::size_t bytes = 0;
+        std::string scratch;
+        for(std::size_t i = 0; i < p.size(); ++i)
+            bytes += p.get(i, scratch).size();
+        BOOST_TEST_EQ(p.url_bytes(), bytes);
+        BOOST_TEST_GT(p.compression_ratio(), 3.0);
+        BOOST_TEST_LT(p.memory_usage(), p.url_bytes() / 2);
+
+        // long urls need several bytes
+        // for their lengths
+        std::vector<std::string> w;
+        w.push_back("/" + std::string(300, 'a'));
+        w.push_back("/" + std::string(200, 'a') + std::string(300, 'b'));
+        w.push_back("/" + std::string(70000, 'c'));
+        url_pool p2(w.begin(), w.end());
+        BOOST_TEST_EQ(p2.size(), 3u);
+        auto it = p2.begin();
+        BOOST_TEST_EQ((*it).buffer(), w[0]);
+        BOOST_TEST_EQ((*++it).buffer(), w[1]);
+        BOOST_TEST_EQ((*++it).buffer(), w[2]);
+        BOOST_TEST(++it == p2.end());
+        BOOST_TEST(p2.contains(url_view(w[2])));
+    }
+
+    void
+    run()
+    {
+        testEmpty();
+        testOrder();
+        testFind();
+        testCompression();
+    }
+};
+
+TEST_SUITE(
+    url_pool_test,
+    "boost.url.url_pool");
+
+} // urls
+} // boost
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include "url_map.hpp"
+
+#include "test_suite.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+struct url_map_test
+{
+    struct throwing
+    {
+        int v = 0;
+
+        explicit
+        throwing(int v_)
+            : v(v_)
+        {
+            if(v < 0)
+                throw std::invalid_argument("v");
+        }
+    };
+
+    void
+    testMap()
+    {
+        url_map<int> m;
+        BOOST_TEST(m.empty());
+        BOOST_TEST(m.find(url_view("http://example.com/")) == nullptr);
+
+        m[url_view("HTTP://Example.com/%7e")] = 1;
+        m[url_view("http://example.com/~")] += 1;
+        BOOST_TEST_EQ(m.size(), 1u);
+        BOOST_TEST_EQ(*m.find(url_view("http://EXAMPLE.com/%7E")), 2);
+
+        auto r = m.insert(url_view("http://example.com/a"), 3);
+        BOOST_TEST(r.second);
+        BOOST_TEST_EQ(*r.first, 3);
+        r = m.insert(url_view("http://example.com/b/../a"), 4);
+        BOOST_TEST(! r.second);
+        BOOST_TEST_EQ(*r.first, 3);
+        r = m.emplace(url_view("http://example.com/c"));
+        BOOST_TEST(r.second);
+        BOOST_TEST_EQ(*r.first, 0);
+        BOOST_TEST_EQ(m.size(), 3u);
+        BOOST_TEST(m.contains(url_view("http://example.com/c")));
+
+        // iteration in insertion order
+        int sum = 0;
+        std::string keys;
+        for(auto kv : m)
+        {
+            sum += kv.second;
+            kv.second *= 10;
+            keys += kv.first.encoded_path();
+        }
+        BOOST_TEST_EQ(sum, 5);
+        BOOST_TEST_EQ(keys, "/%7e/a/c");
+        url_map<int> const& cm = m;
+        BOOST_TEST_EQ(*cm.find(url_view("http://example.com/a")), 30);
+        url_map<int>::const_iterator it = m.begin();
+        BOOST_TEST((*it).second == 20);
+        ++it;
+        BOOST_TEST((*it).first.buffer() == "http://example.com/a");
+        BOOST_TEST(++it != cm.end());
+        BOOST_TEST(++it == cm.end());
+
+        url_storage_stats st = m.memory_usage();
+        BOOST_TEST_EQ(st.count, 3u);
+        BOOST_TEST(st.value_bytes >= 3 * sizeof(int));
+        BOOST_TEST_EQ(st.total(),
+            st.arena_bytes + st.index_bytes + st.value_bytes);
+
+        url_map<int> m2(m);
+        m.clear();
+        BOOST_TEST(m.empty());
+        BOOST_TEST_EQ(m.memory_usage().total(), 0u);
+        BOOST_TEST_EQ(m2.size(), 3u);
+        BOOST_TEST_EQ(*m2.find(url_view("http://example.com/c")), 0);
+    }
+
+    void
+    testException()
+    {
+        url_map<throwing> m;
+        m.emplace(url_view("/a"), 1);
+        m.reserve(100);
+        BOOST_TEST_THROWS(
+            m.emplace(url_view("/b"), -1),
+            std::invalid_argument);
+
+        // the map is unchanged
+        BOOST_TEST_EQ(m.size(), 1u);
+        BOOST_TEST(! m.contains(url_view("/b")));
+        BOOST_TEST_EQ(m.memory_usage().url_bytes, 2u);
+        auto r = m.emplace(url_view("/b"), 2);
+        BOOST_TEST(r.second);
+        BOOST_TEST_EQ(r.first->v, 2);
+        BOOST_TEST_EQ(m.find(url_view("/a"))->v, 1);
+        BOOST_TEST_EQ(m.size(), 2u);
+    }
+
+    void
+    run()
+    {
+        testMap();
+        testException();
+    }
+};
+
+TEST_SUITE(
+    url_map_test,
+    "boost.url.url_map");
+
+} // urls
+} // boost
@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include "url_set.hpp"
+
+#include <boost/url/url.hpp>
+#include "test_suite.hpp"
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+struct url_set_test
+{
+    void
+    testInsert()
+    {
+        url_set s;
+        BOOST_TEST(s.empty());
+        BOOST_TEST_EQ(s.size(), 0u);
+        BOOST_TEST(s.begin() == s.end());
+        BOOST_TEST(! s.contains(url_view("http://example.com")));
+        BOOST_TEST(s.find(url_view("http://example.com")) == s.end());
+
+        auto r = s.insert(url_view("HTTP://www.Example.com/%7euser"));
+        BOOST_TEST(r.second);
+        BOOST_TEST_EQ((*r.first).buffer(),
+            "HTTP://www.Example.com/%7euser");
+
+        // equivalent urls are the same element
+        r = s.insert(url_view("http://www.example.com/~user"));
+        BOOST_TEST(! r.second);
+        BOOST_TEST_EQ((*r.first).buffer(),
+            "HTTP://www.Example.com/%7euser");
+        r = s.insert(url("http://www.example.com/a/../~user"));
+        BOOST_TEST(! r.second);
+        BOOST_TEST_EQ(s.size(), 1u);
+
+        r = s.insert(url_view("http://www.example.com/~other"));
+        BOOST_TEST(r.second);
+        r = s.insert(url_view(""));
+        BOOST_TEST(r.second);
+        BOOST_TEST_EQ((*r.first).buffer(), "");
+        r = s.insert(url_view(""));
+        BOOST_TEST(! r.second);
+        BOOST_TEST_EQ(s.size(), 3u);
+
+        BOOST_TEST(s.contains(url_view("http://WWW.EXAMPLE.COM/%7Euser")));
+        BOOST_TEST_EQ(s.count(url_view("http://www.example.com/%7Eother")), 1u);
+        BOOST_TEST_EQ(s.count(url_view("http://www.example.com/")), 0u);
+        BOOST_TEST(s.find(url_view("http://www.example.com/~other")) ==
+            std::next(s.begin()));
+
+        // iteration in insertion order
+        std::vector<std::string> v;
+        for(url_view u : s)
+            v.emplace_back(u.buffer());
+        BOOST_TEST_EQ(v.size(), 3u);
+        BOOST_TEST_EQ(v[0], "HTTP://www.Example.com/%7euser");
+        BOOST_TEST_EQ(v[1], "http://www.example.com/~other");
+        BOOST_TEST_EQ(v[2], "");
+        auto it = s.end();
+        --it;
+        BOOST_TEST_EQ((*it--).buffer(), "");
+        BOOST_TEST_EQ((*it).buffer(), "http://www.example.com/~other");
+
+        s.clear();
+        BOOST_TEST(s.empty());
+        BOOST_TEST(! s.contains(url_view("http://www.example.com/~user")));
+        BOOST_TEST_EQ(s.memory_usage().total(), 0u);
+    }
+
+    void
+    testMany()
+    {
+        // enough elements for several
+        // rehashes and arena chunks
+        std::size_t const n = 5000;
+        auto const make = [](std::size_t i, bool encoded)
+        {
+            std::string s = encoded ?
+                "HTTP://Host%2D" : "http://host-";
+            s += std::to_string(i % 97);
+            s += encoded ? ".COM/a/./%70ath/" : ".com/a/path/";
+            s += std::to_string(i);
+            return s;
+        };
+
+        url_set s(1, 2);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            std::string str = make(i, i % 2 == 0);
+            BOOST_TEST(s.insert(url_view(str)).second);
+        }
+        BOOST_TEST_EQ(s.size(), n);
+        BOOST_TEST_GT(s.bucket_count(), n);
+        BOOST_TEST(s.load_factor() <= 0.75f);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            std::string str = make(i, i % 2 != 0);
+            BOOST_TEST(! s.insert(url_view(str)).second);
+        }
+        BOOST_TEST_EQ(s.size(), n);
+
+        url_storage_stats st = s.memory_usage();
+        BOOST_TEST_EQ(st.count, n);
+        BOOST_TEST_GT(st.url_bytes, n * 20);
+        BOOST_TEST(st.arena_bytes >= st.url_bytes);
+        BOOST_TEST_GT(st.index_bytes, 0u);
+        BOOST_TEST_EQ(st.value_bytes, 0u);
+        BOOST_TEST_EQ(st.total(),
+            st.arena_bytes + st.index_bytes);
+
+        // rehash keeps every element
+        s.rehash(s.bucket_count() * 4);
+        BOOST_TEST(s.contains(url_view(make(123, false))));
+        s.rehash(0);
+        BOOST_TEST(s.load_factor() <= 0.75f);
+        BOOST_TEST(s.load_factor() > 0.3f);
+        for(std::size_t i = 0; i < n; i += 7)
+            BOOST_TEST(s.contains(url_view(make(i, true))));
+
+        // copies are compacted
+        url_set s2(s);
+        BOOST_TEST_EQ(s2.size(), n);
+        BOOST_TEST(s2.memory_usage().arena_bytes <=
+            st.arena_bytes);
+        BOOST_TEST_EQ(s2.memory_usage().url_bytes,
+            st.url_bytes);
+        BOOST_TEST(s2.contains(url_view(make(n - 1, true))));
+        BOOST_TEST((*s2.begin()).buffer() ==
+            (*s.begin()).buffer());
+        BOOST_TEST((*s2.begin()).buffer().data() !=
+            (*s.begin()).buffer().data());
+
+        // moves keep the strings in place
+        auto const p = (*s.begin()).buffer().data();
+        url_set s3(std::move(s));
+        BOOST_TEST(s.empty());
+        BOOST_TEST_EQ((*s3.begin()).buffer().data(), p);
+        s = std::move(s3);
+        BOOST_TEST_EQ(s.size(), n);
+        s3 = s;
+        BOOST_TEST_EQ(s3.size(), n);
+        BOOST_TEST(s3.contains(url_view(make(42, false))));
+    }
+
+    void
+    testReserve()
+    {
+        url_set s;
+        s.reserve(1000);
+        std::size_t const buckets = s.bucket_count();
+        BOOST_TEST(buckets * 3 >= 1000 * 4);
+        for(std::size_t i = 0; i < 1000; ++i)
+        {
+            std::string str = "/" + std::to_string(i);
+            s.insert(url_view(str));
+        }
+        BOOST_TEST_EQ(s.bucket_count(), buckets);
+
+        // long urls get their own chunk
+        std::string big(100000, 'a');
+        big.insert(0, "/");
+        BOOST_TEST(s.insert(url_view(big)).second);
+        BOOST_TEST(s.contains(url_view(big)));
+        BOOST_TEST(! s.insert(url_view(big)).second);
+        BOOST_TEST(s.memory_usage().arena_bytes >= big.size());
+    }
+
+    void
+    run()
+    {
+        testInsert();
+        testMany();
+        testReserve();
+    }
+};
+
+TEST_SUITE(
+    url_set_test,
+    "boost.url.url_set");
+
+} // urls
+} // boost
@@ -0,0 +1,246 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include "url_sorter.hpp"
+
+#include <boost/url/parse.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+namespace boost {
+namespace urls {
+
+struct url_sorter_test
+{
+    // urls with duplicates, some of
+    // them only after normalization
+    static
+    std::vector<std::string>
+    make_urls(std::size_t n)
+    {
+        std::vector<std::string> v;
+        v.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            auto const j = (i * 7919) % (n / 3 + 1);
+            std::string s;
+            switch(j % 4)
+            {
+            case 0: s = "https://www.example.com/"; break;
+            case 1: s = "HTTPS://WWW.EXAMPLE.COM/"; break;
+            case 2: s = "https://www.example.com/x/../"; break;
+            default: s = "http://example.org/%61/"; break;
+            }
+            s += "item-";
+            s += std::to_string(j / 2);
+            if(j % 3 == 0)
+                s += "?q=" + std::to_string(j);
+            v.push_back(std::move(s));
+        }
+        return v;
+    }
+
+    // the sorted unique urls, in memory
+    static
+    std::vector<std::string>
+    reference(std::vector<std::string> const& in)
+    {
+        std::vector<url> v;
+        for(auto const& s : in)
+        {
+            auto rv = parse_uri_reference(s);
+            if(! rv)
+                continue;
+            url u(*rv);
+            u.normalize();
+            v.push_back(std::move(u));
+        }
+        std::sort(v.begin(), v.end(),
+            [](url const& a, url const& b)
+            {
+                return a.compare(b) < 0;
+            });
+        std::vector<std::string> out;
+        url const* prev = nullptr;
+        for(auto const& u : v)
+        {
+            if( prev &&
+                prev->compare(u) == 0)
+                continue;
+            out.emplace_back(u.buffer());
+            prev = &u;
+        }
+        return out;
+    }
+
+    static
+    std::vector<std::string>
+    sort(
+        url_sorter& s,
+        std::vector<std::string> const& in)
+    {
+        for(auto const& u : in)
+            s.push(u);
+        std::vector<std::string> out;
+        auto const n = s.finish(
+            [&out](url_view u)
+            {
+                out.emplace_back(u.buffer());
+            });
+        BOOST_TEST_EQ(n, out.size());
+        return out;
+    }
+
+    void
+    testEmpty()
+    {
+        url_sorter s;
+        std::size_t calls = 0;
+        BOOST_TEST_EQ(s.finish(
+            [&calls](url_view)
+            {
+                ++calls;
+            }), 0u);
+        BOOST_TEST_EQ(calls, 0u);
+        BOOST_TEST_EQ(s.size(), 0u);
+        BOOST_TEST_EQ(s.invalid(), 0u);
+        BOOST_TEST_EQ(s.runs(), 0u);
+
+        // only invalid urls
+        BOOST_TEST(! s.push("http://[::1"));
+        BOOST_TEST(! s.push("%"));
+        BOOST_TEST_EQ(s.invalid(), 2u);
+        BOOST_TEST_EQ(s.size(), 0u);
+        BOOST_TEST(sort(s, {}).empty());
+    }
+
+    void
+    testMemory()
+    {
+        // everything fits, nothing
+        // is written to a file
+        auto const in = make_urls(1000);
+        url_sorter s;
+        auto const out = sort(s, in);
+        BOOST_TEST(out == reference(in));
+        BOOST_TEST_EQ(s.size(), in.size());
+        BOOST_TEST_EQ(s.runs(), 0u);
+    }
+
+    void
+    testRuns()
+    {
+        auto const in = make_urls(5000);
+        auto const ref = reference(in);
+        std::size_t const threads[] = { 1, 2, 4 };
+        std::size_t const fan_in[] = { 2, 3, 64 };
+        for(auto t : threads)
+        for(auto k : fan_in)
+        {
+            url_sorter::options opt;
+            opt.memory = 16 * 1024;
+            opt.threads = t;
+            opt.fan_in = k;
+            url_sorter s(opt);
+            auto const out = sort(s, in);
+            BOOST_TEST(out == ref);
+            BOOST_TEST_GT(s.runs(), 10u);
+        }
+    }
+
+    void
+    testInvalid()
+    {
+        auto in = make_urls(2000);
+        for(std::size_t i = 0; i < in.size(); i += 10)
+            in[i] = "http://[::1";
+        url_sorter::options opt;
+        opt.memory = 8 * 1024;
+        url_sorter s(opt);
+        auto const out = sort(s, in);
+        BOOST_TEST(out == reference(in));
+        BOOST_TEST_EQ(s.invalid(), 200u);
+        BOOST_TEST_EQ(s.size(), 1800u);
+    }
+
+    void
+    testTempDir()
+    {
+        auto const in = make_urls(3000);
+        url_sorter::options opt;
+        opt.memory = 8 * 1024;
+        opt.threads = 2;
+        opt.fan_in = 4;
+        opt.temp_dir = ".";
+        {
+            url_sorter s(opt);
+            auto const out = sort(s, in);
+            BOOST_TEST(out == reference(in));
+            BOOST_TEST_GT(s.runs(), 4u);
+
+            // the sorter can be reused
+            std::vector<std::string> const in2 = {
+                "https://www.example.com/b",
+                "https://www.example.com/a" };
+            BOOST_TEST(sort(s, in2) == reference(in2));
+        }
+
+        // the directory must exist
+        opt.temp_dir = "./url_sorter_test/missing";
+        url_sorter s(opt);
+        BOOST_TEST_THROWS(sort(s, in),
+            system::system_error);
+    }
+
+    void
+    testJavadocs()
+    {
+        // url_sorter
+        {
+        url_sorter s;
+        s.push( "https://www.example.com/b" );
+        s.push( "https://www.example.com/a" );
+        s.push( "HTTPS://www.example.com/%61" );
+
+        std::vector< std::string > v;
+        s.finish( [&v]( url_view u ) { v.emplace_back( u.buffer() ); } );
+
+        assert( v.size() == 2 );
+        assert( v[0] == "https://www.example.com/a" );
+        }
+    }
+
+    void
+    run()
+    {
+        testEmpty();
+        testMemory();
+        testRuns();
+        testInvalid();
+        testTempDir();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    url_sorter_test,
+    "boost.url.url_sorter");
+
+} // urls
+} // boost
@@ -12,8 +12,11 @@
 
 #include <boost/url/parse.hpp>
 #include <boost/url/static_url.hpp>
+#include <boost/url/detail/pattern.hpp>
 
 #include "test_suite.hpp"
+#include <limits>
+#include <string>
 
 #ifdef BOOST_TEST_CSTR_EQ
 #undef BOOST_TEST_CSTR_EQ
@@ -661,7 +664,7 @@ struct format_test
         }
 
         BOOST_TEST_CSTR_EQ(urls::format("{}://{}?{}#{}", "http", "a.b", 'q', 'f').buffer(), "http://a.b?q#f");
-        BOOST_TEST_CSTR_EQ(urls::format("{}://{}?{}#{}", "http", "a.b", 'q').buffer(), "http://a.b?q#");
+        BOOST_TEST_CSTR_EQ(urls::format(core::string_view("{}://{}?{}#{}"), "http", "a.b", 'q').buffer(), "http://a.b?q#");
 
         BOOST_TEST_CSTR_EQ(urls::format("{}", 'c').buffer(), "c");
         BOOST_TEST_CSTR_EQ(urls::format("//{}", ':').buffer(), "//%3A");
@@ -736,14 +739,15 @@ struct format_test
             segs_equal(u.encoded_segments(), {"", "joe"});
         }
 
-        // invalid format strings
-        BOOST_TEST_THROWS(urls::format("{:"), system::system_error);
+        // invalid format strings, which are
+        // compile errors when they are literals
+        BOOST_TEST_THROWS(urls::format(core::string_view("{:")), system::system_error);
         BOOST_TEST_THROWS(urls::format("{}://www.a.com", "1nvalid scheme"), system::system_error);
-        BOOST_TEST_THROWS(urls::format("{}://{}:{}@{}:a", "http", 'u', 'p', "a.b"), system::system_error);
-        BOOST_TEST_THROWS(urls::format("{}://[", "http"), system::system_error);
-        BOOST_TEST_THROWS(urls::format("{://"), system::system_error);
-        BOOST_TEST_THROWS(urls::format("http:%"), system::system_error);
-        BOOST_TEST_THROWS(urls::format("{}:\\", "A"), system::system_error);
+        BOOST_TEST_THROWS(urls::format(core::string_view("{}://{}:{}@{}:a"), "http", 'u', 'p', "a.b"), system::system_error);
+        BOOST_TEST_THROWS(urls::format(core::string_view("{}://["), "http"), system::system_error);
+        BOOST_TEST_THROWS(urls::format(core::string_view("{://")), system::system_error);
+        BOOST_TEST_THROWS(urls::format(core::string_view("http:%")), system::system_error);
+        BOOST_TEST_THROWS(urls::format(core::string_view("{}:\\"), "A"), system::system_error);
 
         // static_url
         {
@@ -768,10 +772,11 @@ struct format_test
 
 
         // escaped '{' always throws because '{'s are not allowed in URLs
-        BOOST_TEST_THROWS(urls::format("{scheme}:{path}/{{}", "mailto", 'a'), system::system_error);
+        BOOST_TEST_THROWS(urls::format(core::string_view("{scheme}:{path}/{{}"), "mailto", 'a'), system::system_error);
 
-        // "{}" with no format arg is ignored
-        BOOST_TEST_CSTR_EQ(urls::format("/{}/{}/{}", 'a', 'b').buffer(), "/a/b/");
+        // "{}" with no format arg is ignored,
+        // unless the format string is a literal
+        BOOST_TEST_CSTR_EQ(urls::format(core::string_view("/{}/{}/{}"), 'a', 'b').buffer(), "/a/b/");
 
         // format specs
         {
@@ -866,9 +871,242 @@ struct format_test
 
     }
 
+    enum class color : unsigned char
+    {
+        red = 1,
+        green = 200
+    };
+
+    enum offset
+    {
+        before = -3,
+        after = 3
+    };
+
+    void
+    testNumbers()
+    {
+        // integers
+        BOOST_TEST_CSTR_EQ(urls::format("{}", 0).buffer(), "0");
+        BOOST_TEST_CSTR_EQ(urls::format("{}", (std::numeric_limits<long long int>::min)()).buffer(), "-9223372036854775808");
+        BOOST_TEST_CSTR_EQ(urls::format("{}", (std::numeric_limits<unsigned long long int>::max)()).buffer(), "18446744073709551615");
+        BOOST_TEST_CSTR_EQ(urls::format("{:>+06}", -42).buffer(), "-00042");
+        BOOST_TEST_CSTR_EQ(urls::format("{:x<5}", -42).buffer(), "-42xx");
+        BOOST_TEST_CSTR_EQ(urls::format("{:>3}", 12345).buffer(), "12345");
+        {
+            url u = urls::format("http://h:{}/{}", 8080, 42);
+            BOOST_TEST_CSTR_EQ(u.buffer(), "http://h:8080/42");
+            BOOST_TEST_EQ(u.port_number(), 8080);
+        }
+
+        // digits are encoded where
+        // they are not allowed
+        BOOST_TEST_THROWS(urls::format("{}://h", 1), system::system_error);
+
+        // enumerations
+        BOOST_TEST_CSTR_EQ(urls::format("{}", color::green).buffer(), "200");
+        BOOST_TEST_CSTR_EQ(urls::format("{}/{}", before, after).buffer(), "-3/3");
+        BOOST_TEST_CSTR_EQ(urls::format("{:0>4}", color::red).buffer(), "0001");
+
+        // floating point
+        BOOST_TEST_CSTR_EQ(urls::format("{}", 1.5).buffer(), "1.5");
+        BOOST_TEST_CSTR_EQ(urls::format("{}", 0.25f).buffer(), "0.25");
+        BOOST_TEST_CSTR_EQ(urls::format("{}", -2.0).buffer(), "-2");
+        BOOST_TEST_CSTR_EQ(urls::format("{:.2f}", 3.14159).buffer(), "3.14");
+        BOOST_TEST_CSTR_EQ(urls::format("{:+.1f}", 2.0).buffer(), "+2.0");
+        BOOST_TEST_CSTR_EQ(urls::format("{:e}", 1234.5).buffer(), "1.234500e+03");
+        BOOST_TEST_CSTR_EQ(urls::format("{:.3g}", 1234.5).buffer(), "1.23e+03");
+        BOOST_TEST_CSTR_EQ(urls::format("{:>08.3f}", -1.5).buffer(), "-001.500");
+        BOOST_TEST_CSTR_EQ(urls::format("{:.^7}", 1.5).buffer(), "..1.5..");
+        BOOST_TEST_CSTR_EQ(urls::format("?x={: .1f}", 1.25).buffer(), "?x=%201.2");
+        BOOST_TEST_EQ(urls::format("/{:.100f}", 1e300).buffer().size(), 403u);
+        BOOST_TEST_THROWS(urls::format("{:.101f}", 1.5), system::system_error);
+        BOOST_TEST_THROWS(urls::format("{:d}", 1.5), system::system_error);
+
+        // ip addresses
+        {
+            url u = urls::format("http://{}/", ipv4_address(0x7f000001));
+            BOOST_TEST_CSTR_EQ(u.buffer(), "http://127.0.0.1/");
+            BOOST_TEST(u.host_type() == host_type::ipv4);
+            BOOST_TEST(u.host_ipv4_address() == ipv4_address(0x7f000001));
+        }
+        {
+            url u = urls::format("http://[{}]:{}/", ipv6_address("1::2"), 80);
+            BOOST_TEST_CSTR_EQ(u.buffer(), "http://[1::2]:80/");
+            BOOST_TEST(u.host_type() == host_type::ipv6);
+            BOOST_TEST(u.host_ipv6_address() == ipv6_address("1::2"));
+        }
+        BOOST_TEST_CSTR_EQ(urls::format("/{:.>9}", ipv4_address(0x01020304)).buffer(), "/..1.2.3.4");
+        BOOST_TEST_CSTR_EQ(urls::format("?{}", ipv6_address("::ffff:1.2.3.4")).buffer(), "?::ffff:1.2.3.4");
+    }
+
+    // Check that constexpr_pattern_parser
+    // splits s as parse_pattern does
+    static
+    void
+    check_pattern(core::string_view s)
+    {
+        auto const rv = detail::parse_pattern(s);
+        detail::pattern p;
+        detail::constexpr_pattern_parser pp(s);
+        if(! BOOST_TEST_EQ(pp.parse(p), rv.has_value()))
+        {
+            BOOST_TEST_EQ(s, "");
+            return;
+        }
+        if(! rv)
+            return;
+        auto const& q = *rv;
+        BOOST_TEST_EQ(p.scheme, q.scheme);
+        BOOST_TEST_EQ(p.user, q.user);
+        BOOST_TEST_EQ(p.pass, q.pass);
+        BOOST_TEST_EQ(p.host, q.host);
+        BOOST_TEST_EQ(p.port, q.port);
+        BOOST_TEST_EQ(p.path, q.path);
+        BOOST_TEST_EQ(p.query, q.query);
+        BOOST_TEST_EQ(p.frag, q.frag);
+        BOOST_TEST_EQ(p.has_authority, q.has_authority);
+        BOOST_TEST_EQ(p.has_user, q.has_user);
+        BOOST_TEST_EQ(p.has_pass, q.has_pass);
+        BOOST_TEST_EQ(p.has_port, q.has_port);
+        BOOST_TEST_EQ(p.has_query, q.has_query);
+        BOOST_TEST_EQ(p.has_frag, q.has_frag);
+        BOOST_TEST_EQ(p.literals.path, q.literals.path);
+    }
+
+    static
+    void
+    check_args(
+        core::string_view s,
+        std::size_t nauto,
+        std::size_t nindex)
+    {
+        detail::pattern p;
+        detail::constexpr_pattern_parser pp(s);
+        BOOST_TEST(pp.parse(p));
+        BOOST_TEST_EQ(pp.automatic_ids(), nauto);
+        BOOST_TEST_EQ(pp.indexed_args(), nindex);
+    }
+
+    void
+    testPattern()
+    {
+        check_pattern("");
+        check_pattern("{}");
+        check_pattern("{}://{}:{}@{}:{}/{}?{}#{}");
+        check_pattern("https://{username}.gigantic-server.com:{port}/{basePath}/{path}");
+        check_pattern("{}://[{}]:{}");
+        check_pattern("{:.>{}s}/{0:{1}}/{a:{b}}");
+        check_pattern("{}://{}?{}#{}");
+        check_pattern("mailto:{}");
+        check_pattern("//{}");
+        check_pattern("{:}");
+        check_pattern("user/{18446744073709551615}");
+        check_pattern("user/{18446744073709551616}");
+        check_pattern("user/{01}");
+        check_pattern("/a%20{}");
+        check_pattern("a%?b");
+        check_pattern("{:");
+        check_pattern("{}://[");
+        check_pattern("{://");
+        check_pattern("http:%");
+        check_pattern("{}:\\");
+        check_pattern("{scheme}:{path}/{{}");
+
+        // every short string
+        {
+            core::string_view const cs =
+                "{}:/?#@[]%a0F_";
+            std::string s;
+            for(std::size_t n = 0; n <= 4; ++n)
+            {
+                std::size_t total = 1;
+                for(std::size_t i = 0; i < n; ++i)
+                    total *= cs.size();
+                for(std::size_t k = 0; k < total; ++k)
+                {
+                    s.clear();
+                    std::size_t v = k;
+                    for(std::size_t i = 0; i < n; ++i)
+                    {
+                        s.push_back(cs[v % cs.size()]);
+                        v /= cs.size();
+                    }
+                    check_pattern(s);
+                }
+            }
+        }
+
+        // arguments
+        check_args("", 0, 0);
+        check_args("{}/{}", 2, 0);
+        check_args("{a}/{b}", 0, 0);
+        check_args("{:.>{}s}", 2, 0);
+        check_args("{0:.>{2}s}/{1}", 0, 3);
+        check_args("{}://{}:{}@{}:{}/{}?{}#{}", 8, 0);
+        check_args("{18446744073709551615}", 0, std::size_t(-1));
+
+        // literals
+        {
+            detail::pattern p;
+            detail::constexpr_pattern_parser pp(
+                "{}://u{}@[::1]:80{}/a%20{}?q {}#f");
+            BOOST_TEST_NOT(pp.parse(p));
+        }
+        {
+            detail::pattern p;
+            detail::constexpr_pattern_parser pp(
+                "h{}s://u{}:p@[::{}]:8{}0/a%20{}/{}?q={}#f");
+            BOOST_TEST(pp.parse(p));
+            BOOST_TEST_EQ(p.literals.scheme, 2u);
+            BOOST_TEST_EQ(p.literals.user, 1u);
+            BOOST_TEST_EQ(p.literals.pass, 1u);
+            BOOST_TEST_EQ(p.literals.host, 2u);
+            BOOST_TEST_EQ(p.literals.port, 2u);
+            BOOST_TEST_EQ(p.literals.path, 8u);
+            BOOST_TEST_EQ(p.literals.query, 2u);
+            BOOST_TEST_EQ(p.literals.frag, 1u);
+        }
+    }
+
+    void
+    testFormatString()
+    {
+#ifdef BOOST_URL_HAS_FORMAT_STRING
+        {
+            static constexpr format_string<core::string_view, int> f(
+                "https://{}:{}/index.htm");
+            static_assert(f.get() == "https://{}:{}/index.htm", "");
+            static_assert(f.get_pattern().scheme == "https", "");
+            static_assert(f.get_pattern().host == "{}", "");
+            static_assert(f.get_pattern().port == "{}", "");
+            static_assert(f.get_pattern().path == "/index.htm", "");
+            static_assert(f.get_pattern().literals.path == 10, "");
+            BOOST_TEST_CSTR_EQ(
+                urls::format(f, core::string_view("www.example.com"), 8080).buffer(),
+                "https://www.example.com:8080/index.htm");
+        }
+        {
+            // parsed at run time
+            std::string const s = "{}/{}/{}";
+            format_string<char, char> f(s);
+            BOOST_TEST_EQ(f.get(), s);
+            BOOST_TEST_CSTR_EQ(
+                urls::format(f, 'a', 'b').buffer(), "a/b/");
+            BOOST_TEST_THROWS(
+                format_string<>(core::string_view("{")),
+                system::system_error);
+        }
+#endif
+    }
+
     void
     run()
     {
+        testPattern();
+        testFormatString();
+        testNumbers();
+
         // I have spent a lot of time on this and have no
         // idea how to fix this bug in GCC 4.8 and GCC 5.0
         // without help from the pros.
@@ -11,7 +11,14 @@
 #include <boost/url/grammar/recycled.hpp>
 
 #include "test_suite.hpp"
+#include <atomic>
 #include <string>
+#include <vector>
+#if !defined(BOOST_URL_DISABLE_THREADS)
+# include <mutex>
+# include <thread>
+# include <utility>
+#endif
 
 namespace boost {
 namespace urls {
@@ -24,6 +31,151 @@ struct recycled_test
     {
     }
 
+    void
+    testStats()
+    {
+        recycled<std::string> bin;
+        {
+            recycled_stats const st = bin.stats();
+            BOOST_TEST_EQ(st.hits, 0u);
+            BOOST_TEST_EQ(st.shared_hits, 0u);
+            BOOST_TEST_EQ(st.misses, 0u);
+            BOOST_TEST_EQ(st.cross_thread_returns, 0u);
+        }
+        {
+            recycled_ptr<std::string> p(bin);
+            p->assign(100, 'x');
+        }
+        {
+            // reused from the thread cache
+            recycled_ptr<std::string> p(bin);
+            BOOST_TEST_EQ(p->size(), 100u);
+            recycled_stats const st = bin.stats();
+            BOOST_TEST_EQ(st.hits, 1u);
+            BOOST_TEST_EQ(st.misses, 1u);
+        }
+        {
+            // the cache holds a few, and
+            // the others are shared
+            std::vector<recycled_ptr<std::string>> v;
+            for(int i = 0; i < 6; ++i)
+                v.emplace_back(bin);
+            recycled_ptr<std::string> p(v.back());
+            BOOST_TEST_EQ(p.get(), v.back().get());
+        }
+        {
+            std::vector<recycled_ptr<std::string>> v;
+            for(int i = 0; i < 6; ++i)
+                v.emplace_back(bin);
+            recycled_ptr<std::string> p(bin, nullptr);
+            BOOST_TEST(p.empty());
+            p.acquire();
+            recycled_stats const st = bin.stats();
+            BOOST_TEST_EQ(st.hits, 6u);
+            BOOST_TEST_EQ(st.shared_hits, 2u);
+            BOOST_TEST_EQ(st.misses, 7u);
+            BOOST_TEST_EQ(st.cross_thread_returns, 0u);
+        }
+    }
+
+    void
+    testThreads()
+    {
+#if !defined(BOOST_URL_DISABLE_THREADS)
+        // set while an instance is handed out
+        struct slot
+        {
+            std::atomic<bool> busy{false};
+        };
+
+        struct item
+        {
+            recycled_ptr<slot> p;
+            std::size_t from;
+        };
+
+        recycled<slot> bin;
+        std::mutex m;
+        std::vector<item> handoff;
+        std::atomic<std::size_t> acquires{0};
+        std::atomic<std::size_t> twice{0};
+
+        auto const take =
+            [&](recycled_ptr<slot>& p)
+            {
+                p.acquire();
+                ++acquires;
+                if(p->busy.exchange(true))
+                    ++twice;
+            };
+        auto const give =
+            [](recycled_ptr<slot>& p)
+            {
+                p->busy = false;
+                p.release();
+            };
+
+        // each thread holds more instances
+        // than its cache, and releases some
+        // acquired by the other threads
+        auto const work =
+            [&](std::size_t id)
+            {
+                std::vector<recycled_ptr<slot>> v(
+                    8, recycled_ptr<slot>(bin, nullptr));
+                std::vector<item> other;
+                for(int n = 0; n < 2000; ++n)
+                {
+                    for(auto& p : v)
+                        take(p);
+                    {
+                        std::lock_guard<std::mutex> lock(m);
+                        for(std::size_t i = 0; i < 2; ++i)
+                            handoff.push_back({
+                                std::move(v[i]), id});
+                        for(std::size_t i = 0;
+                            i < handoff.size();)
+                        {
+                            if(handoff[i].from == id)
+                            {
+                                ++i;
+                                continue;
+                            }
+                            other.push_back(
+                                std::move(handoff[i]));
+                            handoff.erase(
+                                handoff.begin() + i);
+                        }
+                    }
+                    for(auto& it : other)
+                        give(it.p);
+                    other.clear();
+                    for(std::size_t i = 2;
+                        i < v.size(); ++i)
+                        give(v[i]);
+                    std::this_thread::yield();
+                }
+            };
+
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < 4; ++i)
+            threads.emplace_back(work, i);
+        for(auto& t : threads)
+            t.join();
+        for(auto& it : handoff)
+            give(it.p);
+
+        BOOST_TEST_EQ(twice.load(), 0u);
+        BOOST_TEST_EQ(acquires.load(), 4u * 2000 * 8);
+        recycled_stats const st = bin.stats();
+        BOOST_TEST_EQ(
+            st.hits + st.shared_hits + st.misses,
+            acquires.load());
+        BOOST_TEST_GT(st.shared_hits, 0u);
+        BOOST_TEST_GT(st.cross_thread_returns, 0u);
+#endif
+    }
+
     void
     run()
     {
@@ -37,6 +189,9 @@ struct recycled_test
             BOOST_TEST(sp->capacity() >= 1000);
         }
 
+        testStats();
+        testThreads();
+
         // coverage
         {
             detail::recycled_add_impl(1);
@@ -0,0 +1,282 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/origin_form_parser.hpp>
+
+#include <boost/url/error.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/rfc/origin_form_rule.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include "test_suite.hpp"
+#include <string>
+
+namespace boost {
+namespace urls {
+
+struct origin_form_parser_test
+{
+    static
+    void
+    check_view(
+        url_view const& u,
+        url_view const& v)
+    {
+        BOOST_TEST_EQ(u.buffer(), v.buffer());
+        BOOST_TEST_EQ(u.encoded_path(), v.encoded_path());
+        BOOST_TEST_EQ(u.has_query(), v.has_query());
+        BOOST_TEST_EQ(u.encoded_query(), v.encoded_query());
+        BOOST_TEST_EQ(u.query(), v.query());
+        BOOST_TEST_EQ(u.path(), v.path());
+        BOOST_TEST_EQ(u.segments().size(), v.segments().size());
+        BOOST_TEST_EQ(u.params().size(), v.params().size());
+        BOOST_TEST_EQ(u.encoded_target(), v.encoded_target());
+    }
+
+    // Parse s split at every position and
+    // compare with origin_form_rule
+    static
+    void
+    check(core::string_view s)
+    {
+        char const* it = s.data();
+        auto const r = grammar::parse(
+            it, s.data() + s.size(),
+            origin_form_rule);
+        std::size_t const n = it - s.data();
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            char buf[256];
+            origin_form_parser p(buf);
+            std::size_t m = 0;
+            auto rv = p.put(s.substr(0, i));
+            if(rv)
+            {
+                m = *rv;
+                if(m == i)
+                {
+                    rv = p.put(s.substr(i));
+                    if(rv)
+                        m += *rv;
+                }
+            }
+            if(! r)
+            {
+                // invalid input is found at
+                // the latest by finish()
+                if(rv)
+                    BOOST_TEST(p.finish().has_error());
+                continue;
+            }
+            if(! BOOST_TEST(rv.has_value()))
+                continue;
+            BOOST_TEST_EQ(m, n);
+            BOOST_TEST_EQ(p.size(), n);
+            BOOST_TEST_EQ(p.done(), n < s.size());
+            auto const u = p.finish();
+            if(! BOOST_TEST(u.has_value()))
+                continue;
+            BOOST_TEST(u->data() == buf);
+            check_view(*u, *r);
+        }
+    }
+
+    void
+    testParse()
+    {
+        check("/");
+        check("/index.htm");
+        check("/index.htm?layout=mobile");
+        check("/a/b/c");
+        check("//a//b/");
+        check("/a/../b/./c");
+        check("/%41%62/c%2F?");
+        check("/?");
+        check("/??");
+        check("/?a=1&b=2&&c");
+        check("/?%25=%41&x");
+        check("/a:b@c!$'()*+,;=/?/?[]");
+        check("/path?q HTTP/1.1\r\n");
+        check("/path HTTP/1.1\r\n");
+        check("/path#frag");
+        check("/path?q#frag");
+        check("/a b");
+
+        // invalid
+        check("");
+        check("a");
+        check("*");
+        check("/%");
+        check("/%4");
+        check("/%zz");
+        check("/%4z");
+        check("/?%");
+        check("/?%4");
+        check("/?%g0");
+        check("/?a%4z");
+    }
+
+    void
+    testErrors()
+    {
+        // reported on the chunk which
+        // contains the error
+        {
+            char buf[64];
+            origin_form_parser p(buf);
+            BOOST_TEST_EQ(p.put("/a/b%4").value(), 6u);
+            auto rv = p.put("zz HTTP/1.1");
+            BOOST_TEST(rv.error() == grammar::error::invalid);
+            // the error persists
+            rv = p.put("/");
+            BOOST_TEST(rv.error() == grammar::error::invalid);
+            BOOST_TEST(p.finish().error() ==
+                grammar::error::invalid);
+        }
+        {
+            char buf[64];
+            origin_form_parser p(buf);
+            BOOST_TEST(p.put("http://example.com/").error() ==
+                grammar::error::mismatch);
+        }
+        {
+            char buf[64];
+            origin_form_parser p(buf);
+            BOOST_TEST_EQ(p.put("/?a=%").value(), 5u);
+            BOOST_TEST(p.put("x").error() == error::bad_pct_hexdig);
+        }
+        {
+            char buf[64];
+            origin_form_parser p(buf);
+            BOOST_TEST(p.finish().error() ==
+                grammar::error::mismatch);
+            BOOST_TEST_EQ(p.put("").value(), 0u);
+            BOOST_TEST_EQ(p.put("/?%").value(), 3u);
+            BOOST_TEST(p.finish().error() ==
+                error::missing_pct_hexdig);
+        }
+    }
+
+    void
+    testSize()
+    {
+        // the target fits exactly
+        {
+            char buf[8];
+            origin_form_parser p(buf);
+            BOOST_TEST_EQ(p.capacity(), 8u);
+            BOOST_TEST_EQ(p.put("/1234").value(), 5u);
+            BOOST_TEST_EQ(p.put("567 HTTP/1.1").value(), 3u);
+            BOOST_TEST(p.done());
+            BOOST_TEST_EQ(p.finish()->buffer(), "/1234567");
+        }
+        {
+            char buf[8];
+            origin_form_parser p(buf);
+            BOOST_TEST_EQ(p.put("/1234567").value(), 8u);
+            BOOST_TEST(! p.done());
+            BOOST_TEST_EQ(p.finish()->buffer(), "/1234567");
+        }
+
+        // rejected before the end
+        // of the target is seen
+        {
+            char buf[8];
+            origin_form_parser p(buf);
+            BOOST_TEST_EQ(p.put("/1234").value(), 5u);
+            BOOST_TEST(p.put("5678").error() == error::no_space);
+            BOOST_TEST(p.finish().error() == error::no_space);
+        }
+        {
+            std::string s(1000, 'x');
+            s[0] = '/';
+            char buf[8];
+            origin_form_parser p(buf);
+            BOOST_TEST(p.put(s).error() == error::no_space);
+        }
+        {
+            char buf[1];
+            origin_form_parser p(buf, 0);
+            BOOST_TEST(p.put("/").error() == error::no_space);
+            BOOST_TEST(p.put("").error() == error::no_space);
+        }
+    }
+
+    void
+    testReset()
+    {
+        char buf[64];
+        origin_form_parser p(buf);
+        for(char c : std::string("/a/bc?d&e=f HTTP/1.1"))
+        {
+            auto rv = p.put(core::string_view(&c, 1));
+            BOOST_TEST(rv.has_value());
+            if(p.done())
+            {
+                BOOST_TEST_EQ(*rv, 0u);
+                break;
+            }
+            BOOST_TEST_EQ(*rv, 1u);
+        }
+        BOOST_TEST(p.done());
+        BOOST_TEST_EQ(p.put("more").value(), 0u);
+        auto u = p.finish().value();
+        BOOST_TEST_EQ(u.buffer(), "/a/bc?d&e=f");
+        BOOST_TEST_EQ(u.segments().size(), 2u);
+        BOOST_TEST_EQ(u.params().size(), 2u);
+        // finish is idempotent
+        BOOST_TEST_EQ(p.finish()->buffer(), "/a/bc?d&e=f");
+
+        p.reset();
+        BOOST_TEST_EQ(p.size(), 0u);
+        BOOST_TEST(! p.done());
+        BOOST_TEST(p.put("x").error() == grammar::error::mismatch);
+        p.reset();
+        BOOST_TEST_EQ(p.put("/x").value(), 2u);
+        u = p.finish().value();
+        BOOST_TEST_EQ(u.buffer(), "/x");
+        BOOST_TEST(! u.has_query());
+    }
+
+    void
+    testJavadocs()
+    {
+        // origin_form_parser
+        {
+        char buf[ 1024 ];
+        origin_form_parser p( buf, sizeof(buf) );
+
+        p.put( "/index" ).value();
+        std::size_t n = p.put( ".htm?layout=mobile HTTP/1.1\r\n" ).value();
+        assert( n == 18 );
+        assert( p.done() );
+
+        url_view u = p.finish().value();
+        assert( u.buffer() == "/index.htm?layout=mobile" );
+        }
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testErrors();
+        testSize();
+        testReset();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    origin_form_parser_test,
+    "boost.url.origin_form_parser");
+
+} // urls
+} // boost
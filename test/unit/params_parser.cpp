@@ -0,0 +1,268 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/params_parser.hpp>
+
+#include <boost/url/error.hpp>
+#include <boost/url/parse_query.hpp>
+#include <boost/url/grammar/error.hpp>
+#include "test_suite.hpp"
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+struct params_parser_test
+{
+    struct item
+    {
+        std::string key;
+        std::string value;
+        bool has_value;
+        bool in_chunk;
+    };
+
+    // Parse s in chunks of size n
+    static
+    system::result<std::vector<item>>
+    parse(
+        params_parser& p,
+        core::string_view s,
+        std::size_t n)
+    {
+        std::vector<item> v;
+        core::string_view chunk;
+        auto h = [&](param_pct_view const& pv)
+        {
+            bool const in_chunk =
+                pv.key.data() >= chunk.data() &&
+                pv.key.data() < chunk.data() + chunk.size();
+            v.push_back({
+                std::string(pv.key),
+                std::string(pv.value),
+                pv.has_value, in_chunk });
+        };
+        std::size_t emitted = 0;
+        while(! s.empty())
+        {
+            chunk = s.substr(0, n);
+            s.remove_prefix(chunk.size());
+            auto rv = p.put(chunk, h);
+            if(! rv)
+                return rv.error();
+            emitted += *rv;
+        }
+        chunk = {};
+        auto rv = p.finish(h);
+        if(! rv)
+            return rv.error();
+        emitted += *rv;
+        BOOST_TEST_EQ(emitted, v.size());
+        return v;
+    }
+
+    // Compare with parse_query for
+    // every chunk size
+    static
+    void
+    check(core::string_view s)
+    {
+        auto const r = parse_query(s);
+        for(std::size_t n = 1; n <= s.size() + 1; ++n)
+        {
+            char buf[64];
+            params_parser p(buf, sizeof(buf));
+            auto rv = parse(p, s, n);
+            if(! r)
+            {
+                BOOST_TEST(rv.has_error());
+                continue;
+            }
+            if(! BOOST_TEST(rv.has_value()))
+                continue;
+            auto const& v = *rv;
+            if(! BOOST_TEST_EQ(v.size(), r->size()))
+                continue;
+            std::size_t i = 0;
+            for(auto pv : *r)
+            {
+                BOOST_TEST_EQ(v[i].key, pv.key);
+                BOOST_TEST_EQ(v[i].value, pv.value);
+                BOOST_TEST_EQ(v[i].has_value, pv.has_value);
+                ++i;
+            }
+            // the parser is reset
+            BOOST_TEST_EQ(parse(p, s, n)->size(), v.size());
+        }
+    }
+
+    void
+    testParse()
+    {
+        check("");
+        check("a");
+        check("a=");
+        check("a=1");
+        check("&");
+        check("&&");
+        check("a&");
+        check("a=1&b=2&c");
+        check("a==b&=&=c");
+        check("%61=%62&%41%42=x%20y+z");
+        check("key=value&k2=v2&k3=v3&k4=%25%26&k5=");
+        check("a/b?c=d/e?f&[]=[]");
+
+        // invalid
+        check("a b");
+        check("a#b");
+        check("%");
+        check("%4");
+        check("a=%zz");
+        check("a=%4z&b");
+        check("a&b=%");
+    }
+
+    void
+    testChunks()
+    {
+        // params within a chunk
+        // reference the chunk
+        {
+            char buf[8];
+            params_parser p(buf, sizeof(buf));
+            auto v = parse(p, "a=1&bb=22&ccc=333", 1000).value();
+            BOOST_TEST_EQ(v.size(), 3u);
+            BOOST_TEST(v[0].in_chunk);
+            BOOST_TEST(v[1].in_chunk);
+            // the last one is completed by finish
+            BOOST_TEST(! v[2].in_chunk);
+        }
+
+        // memory is bounded by the largest
+        // param which is split across chunks
+        {
+            std::string s;
+            for(int i = 0; i < 10000; ++i)
+            {
+                if(i != 0)
+                    s += '&';
+                s += "key" + std::to_string(i) +
+                    "=v%20" + std::to_string(i);
+            }
+            char buf[16];
+            params_parser p(buf, sizeof(buf));
+            auto v = parse(p, s, 4096).value();
+            BOOST_TEST_EQ(v.size(), 10000u);
+            BOOST_TEST_EQ(v[9999].key, "key9999");
+            BOOST_TEST_EQ(v[9999].value, "v%209999");
+            for(std::size_t i = 0; i < v.size(); ++i)
+                BOOST_TEST_EQ(v[i].key,
+                    "key" + std::to_string(i));
+        }
+
+        // a param split across chunks which
+        // does not fit in the buffer
+        {
+            char buf[4];
+            params_parser p(buf, sizeof(buf));
+            auto h = [](param_pct_view const&){};
+            BOOST_TEST_EQ(p.put("a=1&bcd=", h).value(), 1u);
+            BOOST_TEST(p.put("efgh&", h).error() == error::no_space);
+            // the error persists
+            BOOST_TEST(p.put("a", h).error() == error::no_space);
+            BOOST_TEST(p.finish(h).error() == error::no_space);
+            p.reset();
+            // a param in one chunk fits
+            BOOST_TEST_EQ(p.put("abcdefgh=ijkl&", h).value(), 1u);
+            BOOST_TEST_EQ(p.finish(h).value(), 1u);
+        }
+    }
+
+    void
+    testErrors()
+    {
+        auto h = [](param_pct_view const&){};
+        {
+            char buf[64];
+            params_parser p(buf, sizeof(buf));
+            BOOST_TEST_EQ(p.put("a=%", h).value(), 0u);
+            BOOST_TEST(p.put("4g", h).error() ==
+                error::bad_pct_hexdig);
+        }
+        {
+            char buf[64];
+            params_parser p(buf, sizeof(buf));
+            BOOST_TEST_EQ(p.put("a=%4", h).value(), 0u);
+            BOOST_TEST(p.finish(h).error() ==
+                error::missing_pct_hexdig);
+        }
+        {
+            char buf[64];
+            params_parser p(buf, sizeof(buf));
+            BOOST_TEST(p.put("a=1&b=\r\n", h).error() ==
+                grammar::error::invalid);
+        }
+    }
+
+    void
+    testDecode()
+    {
+        char buf[64];
+        params_parser p(buf, sizeof(buf));
+        params_parser pp(buf, sizeof(buf), encoding_opts(true));
+        char dest[8];
+        BOOST_TEST_EQ(p.decode("a+b%20c", dest, sizeof(dest)).value(), 5u);
+        BOOST_TEST_EQ(core::string_view(dest, 5), "a+b c");
+        BOOST_TEST_EQ(pp.decode("a+b%20c", dest, sizeof(dest)).value(), 5u);
+        BOOST_TEST_EQ(core::string_view(dest, 5), "a b c");
+        BOOST_TEST_EQ(pp.decode("12345678", dest, sizeof(dest)).value(), 8u);
+        BOOST_TEST(pp.decode("123456789", dest, sizeof(dest)).error() ==
+            error::no_space);
+        BOOST_TEST_EQ(pp.decode("", dest, 0).value(), 0u);
+    }
+
+    void
+    testJavadocs()
+    {
+        // params_parser
+        {
+        char buf[ 4096 ];
+        params_parser p( buf, sizeof(buf), encoding_opts( true ) );
+        auto h = [&p]( param_pct_view const& pv )
+        {
+            char value[ 256 ];
+            std::size_t n = p.decode( pv.value, value, sizeof(value) ).value();
+            assert( core::string_view( value, n ) == "John Doe" );
+        };
+
+        p.put( "name=John+D", h ).value();
+        p.put( "oe", h ).value();
+        p.finish( h ).value();
+        }
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testChunks();
+        testErrors();
+        testDecode();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    params_parser_test,
+    "boost.url.params_parser");
+
+} // urls
+} // boost
@@ -743,6 +743,44 @@ struct params_ref_test
             check(f, "?k0&k1=&k2=key", "k0&k1=" BIGSTR "&k2=key",
                 { {"k0",no_value}, {"k1",BIGSTR}, {"k2","key"} });
         }
+
+        // sort()
+        {
+            auto const f = [](params_ref qp)
+            {
+                qp.sort();
+            };
+            check(f, "", "", {});
+            check(f, "?k1=x", "k1=x", { {"k1","x"} });
+            check(f, "?k2=&k0&k1=key", "k0&k1=key&k2=",
+                { {"k0",no_value}, {"k1","key"}, {"k2",""} });
+            check(f, "?b=2&%61=1&b=1&a=0", "%61=1&a=0&b=2&b=1",
+                { {"a","1"}, {"a","0"}, {"b","2"}, {"b","1"} });
+            check(f, "?b&&a", "&a&b",
+                { {"",no_value}, {"a",no_value}, {"b",no_value} });
+        }
+        {
+            // many params
+            url u;
+            std::string s;
+            for(int i = 2000; i-- > 0;)
+            {
+                s = std::to_string(i);
+                s.insert(0, 4 - s.size(), '0');
+                u.params().append({ s, "v" });
+            }
+            std::size_t const n = u.buffer().size();
+            u.params().sort();
+            BOOST_TEST_EQ(u.buffer().size(), n);
+            BOOST_TEST_EQ(u.params().size(), 2000u);
+            auto it = u.params().begin();
+            for(int i = 0; i < 2000; ++i, ++it)
+            {
+                s = std::to_string(i);
+                s.insert(0, 4 - s.size(), '0');
+                BOOST_TEST_EQ((*it).key, s);
+            }
+        }
     }
 
     static
@@ -823,6 +861,15 @@ struct params_ref_test
 
         assert( u.params().count( "id" ) == 1 );
         }
+
+        // sort()
+        {
+        url u( "?last=Doe&first=John&first=Jane" );
+
+        u.params().sort();
+
+        assert( u.encoded_query() == "first=John&first=Jane&last=Doe" );
+        }
     }
 
     static
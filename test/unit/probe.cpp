@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// The probes are internal to the library,
+// and only its sources are built with
+// BOOST_URL_ENABLE_PROBES.
+#include "../../src/detail/probe.hpp"
+
+#include <boost/url/format.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/url.hpp>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_ENABLE_PROBES
+static_assert(
+    BOOST_URL_HAS_PROBES == 0,
+    "probes must compile out by default");
+#endif
+
+struct probe_test
+{
+    void
+    testCompileOut()
+    {
+        // arguments of disabled probes
+        // are not evaluated
+        int n = 0;
+        if(n == 0)
+            BOOST_URL_PROBE1(test, ++n);
+        else
+            BOOST_URL_PROBE2(test, ++n, ++n);
+#if ! BOOST_URL_HAS_PROBES
+        BOOST_TEST_EQ(n, 0);
+#else
+        BOOST_TEST_EQ(n, 1);
+#endif
+    }
+
+    void
+    testProbed()
+    {
+        // the probed functions are unchanged
+        BOOST_TEST(parse_uri("http://www.example.com/a"));
+        BOOST_TEST(! parse_uri("http://[bad"));
+        BOOST_TEST(parse_origin_form("/a?b"));
+        BOOST_TEST(! parse_origin_form("a"));
+        {
+            url u("http://www.example.com/a/b/c");
+            BOOST_TEST(u.resolve(url_view("../d")));
+            BOOST_TEST_EQ(u.buffer(), "http://www.example.com/a/d");
+            url v("a/b");
+            BOOST_TEST_EQ(
+                v.resolve(url_view("c")).error(),
+                error::not_a_base);
+        }
+        {
+            url u("HTTP://www.Example.com/%7ea/./b");
+            u.normalize();
+            BOOST_TEST_EQ(u.buffer(), "http://www.example.com/~a/b");
+            url v;
+            v.normalize();
+            BOOST_TEST(v.empty());
+        }
+        {
+            url u = format("{}://{}/{}", "http", "h", "a b");
+            BOOST_TEST_EQ(u.buffer(), "http://h/a%20b");
+            url v("http://x");
+            format_to(v, "{}://{}/{}", "http", "h", "a b");
+            BOOST_TEST_EQ(v.buffer(), "http://h/a%20b");
+            core::string_view const fmt = "{}://{}/{}";
+            BOOST_TEST_EQ(format(fmt, "http", "h", "a b").buffer(),
+                "http://h/a%20b");
+            BOOST_TEST_THROWS(format(
+                core::string_view("{"), 1),
+                system::system_error);
+        }
+    }
+
+    void
+    run()
+    {
+        testCompileOut();
+        testProbed();
+    }
+};
+
+TEST_SUITE(
+    probe_test,
+    "boost.url.probe");
+
+} // urls
+} // boost
@@ -0,0 +1,296 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/small_url.hpp>
+
+#include <boost/url/parse.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <boost/static_assert.hpp>
+
+#include "test_suite.hpp"
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+struct small_url_test
+{
+    BOOST_STATIC_ASSERT(
+        std::is_default_constructible<
+            small_url<10>>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_copy_constructible<
+            small_url<10>>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_copy_assignable<
+            small_url<10>>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_nothrow_move_constructible<
+            small_url<10>>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_nothrow_move_assignable<
+            small_url<10>>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<
+            small_url<10>, url_view>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<
+            small_url<10>, url>::value);
+
+    void
+    testSpecial()
+    {
+        // small_url()
+        {
+            small_url<32> u;
+            BOOST_TEST_EQ(*u.c_str(), '\0');
+            BOOST_TEST(u.buffer().empty());
+            BOOST_TEST(u.is_inline());
+            BOOST_TEST_EQ(u.capacity(), 32u);
+        }
+
+        // small_url(core::string_view)
+        {
+            BOOST_TEST_THROWS(
+                small_url<32>("$:$"),
+                system::system_error);
+
+            small_url<32> u0("http://example.com");
+            BOOST_TEST(u0.is_inline());
+            BOOST_TEST_EQ(u0.buffer(), "http://example.com");
+
+            // spills to the heap
+            small_url<8> u1("http://www.example.com/path");
+            BOOST_TEST(! u1.is_inline());
+            BOOST_TEST_EQ(u1.buffer(), "http://www.example.com/path");
+        }
+
+        // small_url(small_url)
+        // small_url(url_view_base)
+        {
+            small_url<32> u0("/path/to/file.txt");
+            small_url<32> u1(u0);
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+            BOOST_TEST_NE(u0.buffer().data(), u1.buffer().data());
+            BOOST_TEST(u1.is_inline());
+
+            small_url<4> u2(u0);
+            small_url<4> u3(u2);
+            BOOST_TEST_EQ(u3.buffer(), "/path/to/file.txt");
+            BOOST_TEST(! u3.is_inline());
+            BOOST_TEST_NE(u2.buffer().data(), u3.buffer().data());
+
+            BOOST_TEST_EQ(
+                small_url<8>(url_view(
+                    "/path/to/file.txt")).buffer(),
+                    "/path/to/file.txt");
+        }
+
+        // small_url(small_url&&)
+        {
+            small_url<32> u0("/path");
+            small_url<32> u1(std::move(u0));
+            BOOST_TEST_EQ(u1.buffer(), "/path");
+            BOOST_TEST(u1.is_inline());
+            BOOST_TEST(u0.empty());
+            BOOST_TEST(u0.is_inline());
+
+            small_url<4> u2("/path/to/file.txt");
+            char const* p = u2.c_str();
+            small_url<4> u3(std::move(u2));
+            BOOST_TEST_EQ(u3.buffer(), "/path/to/file.txt");
+            BOOST_TEST_EQ(u3.c_str(), p);
+            BOOST_TEST(u2.empty());
+            BOOST_TEST(u2.is_inline());
+            BOOST_TEST_EQ(u2.capacity(), 4u);
+            u2.set_encoded_path("/x");
+            BOOST_TEST_EQ(u2.buffer(), "/x");
+        }
+
+        // operator=(small_url)
+        // operator=(small_url&&)
+        // operator=(url_view_base)
+        {
+            small_url<8> u0("/path/to/file.txt");
+            small_url<8> u1("/a");
+            u1 = u0;
+            BOOST_TEST_EQ(u1.buffer(), u0.buffer());
+            u1 = url_view("/b");
+            BOOST_TEST_EQ(u1.buffer(), "/b");
+
+            // heap to heap
+            small_url<8> u2("/path/to/other.txt");
+            u1 = u0;
+            u1 = std::move(u2);
+            BOOST_TEST_EQ(u1.buffer(), "/path/to/other.txt");
+            BOOST_TEST(u2.empty());
+
+            // inline to heap
+            small_url<8> u3("/c");
+            u1 = std::move(u3);
+            BOOST_TEST_EQ(u1.buffer(), "/c");
+            BOOST_TEST(u3.empty());
+
+            // self
+            u1 = *&u1;
+            BOOST_TEST_EQ(u1.buffer(), "/c");
+        }
+    }
+
+    void
+    testCapacity()
+    {
+        // grow, clear
+        {
+            small_url<16> u("http://h");
+            BOOST_TEST(u.is_inline());
+            u.set_encoded_path("/a/long/path/which/does/not/fit");
+            BOOST_TEST(! u.is_inline());
+            BOOST_TEST_EQ(u.buffer(),
+                "http://h/a/long/path/which/does/not/fit");
+            BOOST_TEST_GE(u.capacity(), u.size());
+            u.clear();
+            BOOST_TEST(u.is_inline());
+            BOOST_TEST(u.empty());
+            BOOST_TEST_EQ(u.capacity(), 16u);
+        }
+
+        // shrink_to_fit
+        {
+            small_url<16> u;
+            u.shrink_to_fit();
+            BOOST_TEST(u.is_inline());
+
+            u.reserve(1000);
+            BOOST_TEST(! u.is_inline());
+            u.set_encoded_path("/a/b/c/d/e/f/g/h/i");
+            u.shrink_to_fit();
+            BOOST_TEST(! u.is_inline());
+            BOOST_TEST_EQ(u.capacity(), u.size());
+            BOOST_TEST_EQ(u.buffer(), "/a/b/c/d/e/f/g/h/i");
+            u.shrink_to_fit();
+            BOOST_TEST_EQ(u.capacity(), u.size());
+
+            u.segments().erase(
+                u.segments().begin(),
+                std::next(u.segments().begin(), 6));
+            u.shrink_to_fit();
+            BOOST_TEST(u.is_inline());
+            BOOST_TEST_EQ(u.buffer(), "/g/h/i");
+            BOOST_TEST_EQ(u.capacity(), 16u);
+        }
+    }
+
+    void
+    testModifiers()
+    {
+        // mutators which read from
+        // the buffer they grow
+        small_url<24> u("http://www.example.com/");
+        u.set_encoded_query(u.encoded_host());
+        BOOST_TEST_EQ(u.buffer(),
+            "http://www.example.com/?www.example.com");
+        BOOST_TEST(! u.is_inline());
+        u.set_encoded_fragment(u.buffer());
+        BOOST_TEST_EQ(u.encoded_fragment(),
+            "http://www.example.com/?www.example.com");
+
+        small_url<24> v("http://h/?b=2");
+        v.params().append({"a", "1"});
+        v.params().append({"c", "a value which does not fit"});
+        v.params().sort();
+        BOOST_TEST_EQ(v.encoded_query(),
+            "a=1&b=2&c=a%20value%20which%20does%20not%20fit");
+        v.remove_query().normalize();
+        BOOST_TEST_EQ(v.buffer(), "http://h/");
+        v.shrink_to_fit();
+        BOOST_TEST(v.is_inline());
+
+        small_url<24> w("HTTP://H/a/./b/../c?%61");
+        w.normalize();
+        BOOST_TEST_EQ(w.buffer(), "http://h/a/c?a");
+        BOOST_TEST(url(w) == w);
+    }
+
+    void
+    testHash()
+    {
+        small_url<8> u0("http://example.com/path");
+        small_url<64> u1("http://example.com/path");
+        url u2("http://example.com/path");
+        BOOST_TEST_EQ(
+            std::hash<small_url<8>>()(u0),
+            std::hash<url>()(u2));
+        BOOST_TEST_EQ(
+            std::hash<small_url<64>>()(u1),
+            std::hash<url>()(u2));
+        BOOST_TEST_EQ(
+            std::hash<small_url<64>>(10)(u1),
+            std::hash<url>(10)(u2));
+        BOOST_TEST(u0 == u1);
+    }
+
+    void
+    testOstream()
+    {
+        small_url<64> u("http://example.com");
+        std::stringstream ss;
+        ss << u;
+        BOOST_TEST_EQ(ss.str(), "http://example.com");
+    }
+
+    void
+    testJavadocs()
+    {
+        // {class}
+        {
+    small_url< 128 > u( "https://www.example.com" );
+
+    assert( u.is_inline() );
+        }
+
+        // small_url()
+        {
+        small_url< 128 > u;
+
+        ignore_unused(u);
+        }
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testCapacity();
+        testModifiers();
+        testHash();
+        testOstream();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    small_url_test,
+    "boost.url.small_url");
+
+} // urls
+} // boost
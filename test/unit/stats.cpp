@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/stats.hpp>
+
+#include <boost/url/parse.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+namespace boost {
+namespace urls {
+
+struct stats_test
+{
+    void
+    testCounters()
+    {
+        reset_url_stats();
+        std::size_t n1 = 0;
+        {
+            url u("http://www.example.com/a?q#f");
+            u.set_path("/path/to/a/file/which/is/longer.txt");
+            n1 = u.size();
+            u.normalize_path();
+            u.normalize();
+        }
+        BOOST_TEST(! parse_uri("http://[bad"));
+        BOOST_TEST(! parse_uri("a b"));
+        BOOST_TEST(! parse_relative_ref("%zz"));
+        BOOST_TEST(! parse_authority("a b"));
+        url_stats st = get_url_stats();
+        if(! st.enabled)
+        {
+            BOOST_TEST_EQ(st.allocations, 0u);
+            BOOST_TEST_EQ(st.reallocations, 0u);
+            BOOST_TEST_EQ(st.bytes_allocated, 0u);
+            BOOST_TEST_EQ(st.bytes_unused, 0u);
+            BOOST_TEST_EQ(st.bytes_moved, 0u);
+            BOOST_TEST_EQ(st.normalizations, 0u);
+            BOOST_TEST_EQ(st.parse_failures, 0u);
+            return;
+        }
+        // one buffer, then a bigger one
+        BOOST_TEST_EQ(st.allocations, 2u);
+        BOOST_TEST_EQ(st.reallocations, 1u);
+        // the second buffer is exact: the
+        // growth policy gives less
+        BOOST_TEST_EQ(st.bytes_unused, 0u);
+        BOOST_TEST_EQ(st.bytes_allocated,
+            28u + n1);
+        // "?q#f" moved right
+        BOOST_TEST_GE(st.bytes_moved, 4u);
+        // normalize_path, then normalize
+        BOOST_TEST_EQ(st.normalizations, 2u);
+        BOOST_TEST_EQ(st.parse_failures, 4u);
+        std::size_t n = 0;
+        for(auto v : st.grammar_errors)
+            n += v;
+        for(auto v : st.url_errors)
+            n += v;
+        BOOST_TEST_EQ(n, 4u);
+        BOOST_TEST_EQ(st.failures(
+            error::bad_pct_hexdig), st.url_errors[
+                static_cast<int>(error::bad_pct_hexdig)]);
+        BOOST_TEST_EQ(st.failures(
+            grammar::error::mismatch), st.grammar_errors[
+                static_cast<int>(grammar::error::mismatch)]);
+        BOOST_TEST_EQ(st.failures(
+            system::error_code()), 0u);
+
+        // the growth policy
+        reset_url_stats();
+        {
+            url u;
+            u.reserve(100);
+            u.reserve(101);
+        }
+        st = get_url_stats();
+        BOOST_TEST_EQ(st.allocations, 2u);
+        BOOST_TEST_EQ(st.reallocations, 1u);
+        BOOST_TEST_EQ(st.bytes_allocated, 250u);
+        BOOST_TEST_EQ(st.bytes_unused, 49u);
+
+        reset_url_stats();
+        st = get_url_stats();
+        BOOST_TEST_EQ(st.allocations, 0u);
+        BOOST_TEST_EQ(st.parse_failures, 0u);
+    }
+
+    void
+    testThreads()
+    {
+        reset_url_stats();
+        std::atomic<std::size_t> nfail{0};
+        std::vector<std::thread> v;
+        for(int i = 0; i < 4; ++i)
+            v.emplace_back([&nfail]
+            {
+                for(int j = 0; j < 100; ++j)
+                {
+                    if(! parse_uri("%"))
+                        ++nfail;
+                    get_url_stats();
+                }
+            });
+        for(auto& t : v)
+            t.join();
+        BOOST_TEST_EQ(nfail.load(), 400u);
+        url_stats const st = get_url_stats();
+        if(st.enabled)
+            BOOST_TEST_EQ(st.parse_failures, 400u);
+        else
+            BOOST_TEST_EQ(st.parse_failures, 0u);
+    }
+
+    void
+    testJavadocs()
+    {
+        // url_stats
+        {
+        reset_url_stats();
+
+        url u( "https://www.example.com" );
+        u.set_path( "/path/to/file.txt" );
+
+        url_stats st = get_url_stats();
+        if( st.enabled )
+            assert( st.allocations >= 1 );
+        }
+    }
+
+    void
+    run()
+    {
+        testCounters();
+        testThreads();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    stats_test,
+    "boost.url.stats");
+
+} // urls
+} // boost
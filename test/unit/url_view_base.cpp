@@ -10,6 +10,7 @@
 // Test that header file is self-contained.
 #include <boost/url/url_view_base.hpp>
 
+#include <boost/url/url.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/core/ignore_unused.hpp>
 
@@ -457,10 +458,115 @@ struct url_view_base_test
 
     }
 
+    //--------------------------------------------
+    //
+    // Digest
+    //
+    //--------------------------------------------
+
+    void
+    testDigest()
+    {
+        auto const same = [](
+            core::string_view s0,
+            core::string_view s1)
+        {
+            url_view u0(s0);
+            url_view u1(s1);
+            BOOST_TEST_EQ(u0.compare(u1), 0);
+            std::hash<url_view> h0;
+            std::hash<url_view> h7(7);
+            BOOST_TEST_EQ(h0(u0), h0(u1));
+            BOOST_TEST_EQ(h7(u0), h7(u1));
+            BOOST_TEST(u0.digest128() == u1.digest128());
+            BOOST_TEST(u0.digest128(1, 2) == u1.digest128(1, 2));
+        };
+
+        auto const different = [](
+            core::string_view s0,
+            core::string_view s1)
+        {
+            url_view u0(s0);
+            url_view u1(s1);
+            BOOST_TEST_NE(u0.compare(u1), 0);
+            std::hash<url_view> h;
+            BOOST_TEST_NE(h(u0), h(u1));
+            BOOST_TEST(u0.digest128() != u1.digest128());
+        };
+
+        same("", "");
+        same("HTTP://WWW.Example.COM/", "http://www.example.com/");
+        same("http://%7eu%73er@h/%7e", "http://~user@h/~");
+        same("http://h/a/b/../c/./d", "http://h/a/c/d");
+        same("http://h/%61%62%63%64%65%66%67%68%69%6A",
+             "http://h/abcdefghij");
+        same("http://h/?%61%62%63%64%65%66%67%68%69=x",
+             "http://h/?abcdefghi=x");
+        same("http://h/?q#%66%72%61%67%6d%65%6e%74",
+             "http://h/?q#fragment");
+        different("http://h/?a", "http://h/?b");
+        different("http://h/?a", "http://h/?aa");
+        different("http://h/abcdefgh", "http://h/abcdefghi");
+        different("http://h/abcdefghijklmnop", "http://h/abcdefghijklmnoq");
+        different("http://h:80/", "http://h:81/");
+        different("http://h/", "http://h/#");
+
+        // decoded delimiters
+        different("http://h/?a%23b", "http://h/?a#b");
+        different("http://a%3Ab@h/", "http://a:b@h/");
+        different("http://h/%3Fa", "http://h/?a");
+        different("http://h/a%3Fb#c", "http://h/a?b#c");
+        different("x:%2F%2Fh/", "x://h/");
+
+        // same digest as the normalized url
+        auto const normalized = [](
+            core::string_view s)
+        {
+            url_view u0(s);
+            url u1(s);
+            u1.normalize();
+            BOOST_TEST(u0.digest128() == u1.digest128());
+            BOOST_TEST_EQ(
+                std::hash<url_view>()(u0),
+                std::hash<url>()(u1));
+        };
+
+        normalized("http://h/a/b/./");
+        normalized("http://h/.");
+        normalized("http://h/b//..");
+        normalized("http://h/b//../%61");
+        normalized("http://h///../a");
+        normalized("http://h/a/%2E/%2e%2E/b");
+
+        // keyed
+        {
+            url_view u("https://www.example.com/path/to/file.txt?q=1");
+            BOOST_TEST_NE(
+                std::hash<url_view>(1)(u),
+                std::hash<url_view>(2)(u));
+            BOOST_TEST(u.digest128() != u.digest128(1, 0));
+            BOOST_TEST(u.digest128(1, 0) != u.digest128(0, 1));
+            BOOST_TEST(u.digest128(3, 4) == u.digest128(3, 4));
+            auto const d = u.digest128();
+            BOOST_TEST_NE(d.first, d.second);
+        }
+
+        // url and url_view agree
+        {
+            url_view u0("https://www.Example.com/%7e");
+            url u1("HTTPS://www.example.COM/~");
+            BOOST_TEST_EQ(
+                std::hash<url_view>(5)(u0),
+                std::hash<url>(5)(u1));
+            BOOST_TEST(u0.digest128(5, 6) == u1.digest128(5, 6));
+        }
+    }
+
     void
     run()
     {
         testHost();
+        testDigest();
         testJavadocs();
 
         test_suite::log <<